@@ -100,7 +100,8 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
             appendMemoryEvents(props.start, messages, d);
             auto location = m_functionLocations.find(props.id);
 
-            d << props.start << int(RangeStart) << int(Javascript) << static_cast<qint64>(props.id);
+            d << props.start << int(RangeStart) << int(Javascript) << static_cast<qint64>(props.id)
+              << int(translateExecutionMode(props.executionMode));
             if (location != m_functionLocations.end()) {
                 messages.push_back(d.squeezedData());
                 d.clear();
@@ -109,7 +110,9 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
                 messages.push_back(d.squeezedData());
                 d.clear();
                 d << props.start << int(RangeData) << int(Javascript) << location->name
-                  << static_cast<qint64>(props.id);
+                  << static_cast<qint64>(props.id) << location->executionCounts.interpreted
+                  << location->executionCounts.jitCompiled
+                  << location->executionCounts.aotCompiled;
                 m_functionLocations.erase(location);
             }
             messages.push_back(d.squeezedData());
@@ -147,6 +150,20 @@ void QV4ProfilerAdapter::receiveData(
     service->dataReady(this);
 }
 
+QQmlProfilerDefinitions::JavaScriptExecutionMode QV4ProfilerAdapter::translateExecutionMode(
+        QV4::Profiling::ExecutionMode mode)
+{
+    switch (mode) {
+    case QV4::Profiling::Interpreted:
+        return JavaScriptInterpreted;
+    case QV4::Profiling::JitCompiled:
+        return JavaScriptJitCompiled;
+    case QV4::Profiling::AotCompiled:
+        return JavaScriptAotCompiled;
+    }
+    Q_UNREACHABLE_RETURN(JavaScriptInterpreted);
+}
+
 quint64 QV4ProfilerAdapter::translateFeatures(quint64 qmlFeatures)
 {
     quint64 v4Features = 0;
@@ -56,6 +56,7 @@ private:
     void forwardEnabledWhileWaiting(quint64 features);
 
     static quint64 translateFeatures(quint64 qmlFeatures);
+    static JavaScriptExecutionMode translateExecutionMode(QV4::Profiling::ExecutionMode mode);
 };
 
 QT_END_NAMESPACE
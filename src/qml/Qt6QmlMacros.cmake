@@ -2054,6 +2054,18 @@ function(qt6_target_qml_sources target)
         endforeach()
     endforeach()
 
+    # With QT_QMLCACHEGEN_BATCH, all files of this call are compiled by a single
+    # qmlcachegen invocation, which is set up after the loop.
+    if(NOT no_cachegen AND arg_QML_FILES)
+        get_target_property(cachegen_batch ${target} QT_QMLCACHEGEN_BATCH)
+    else()
+        set(cachegen_batch FALSE)
+    endif()
+    set(cachegen_batch_contents "")
+    set(cachegen_batch_inputs "")
+    set(cachegen_batch_outputs "")
+    set(cachegen_batch_dirs "")
+
     set(generated_sources_other_scope)
     foreach(qml_file_src IN LISTS arg_QML_FILES)
         # This is to facilitate updating code that used the earlier tech preview
@@ -2202,25 +2214,34 @@ function(qt6_target_qml_sources target)
             endif()
 
             _qt_internal_get_tool_wrapper_script_path(tool_wrapper)
-            add_custom_command(
-                OUTPUT ${compiled_file}
-                COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
-                COMMAND
-                    ${tool_wrapper}
-                    ${qmlcachegen_cmd}
-                    --bare
-                    --resource-path "${file_resource_path}"
-                    ${cachegen_args}
-                    -o "${compiled_file}"
-                    "${file_absolute}"
-                COMMAND_EXPAND_LISTS
-                DEPENDS
-                    "${file_absolute}"
-                    $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
-                    "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
-                    "${qmldir_file}"
-                VERBATIM
-            )
+            if(cachegen_batch)
+                string(APPEND cachegen_batch_contents
+                    "${file_absolute}\t${compiled_file}\t${file_resource_path}\n"
+                )
+                list(APPEND cachegen_batch_inputs "${file_absolute}")
+                list(APPEND cachegen_batch_outputs "${compiled_file}")
+                list(APPEND cachegen_batch_dirs "${out_dir}")
+            else()
+                add_custom_command(
+                    OUTPUT ${compiled_file}
+                    COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
+                    COMMAND
+                        ${tool_wrapper}
+                        ${qmlcachegen_cmd}
+                        --bare
+                        --resource-path "${file_resource_path}"
+                        ${cachegen_args}
+                        -o "${compiled_file}"
+                        "${file_absolute}"
+                    COMMAND_EXPAND_LISTS
+                    DEPENDS
+                        "${file_absolute}"
+                        $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
+                        "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
+                        "${qmldir_file}"
+                    VERBATIM
+                )
+            endif()
 
             target_sources(${target} PRIVATE ${compiled_file})
             set_source_files_properties(${compiled_file} PROPERTIES
@@ -2246,6 +2267,47 @@ function(qt6_target_qml_sources target)
         endif()
     endforeach()
 
+    if(cachegen_batch_outputs)
+        # Each call gets its own batch file, as the target may receive QML files
+        # from several calls.
+        get_target_property(batch_index ${target} _qt_qmlcachegen_batch_count)
+        if(NOT batch_index)
+            set(batch_index 0)
+        endif()
+        math(EXPR next_batch_index "${batch_index} + 1")
+        set_target_properties(${target} PROPERTIES
+            _qt_qmlcachegen_batch_count ${next_batch_index}
+        )
+
+        # file(GENERATE) leaves the file alone if its contents don't change, so
+        # that the batch is only re-run if the list of files does.
+        set(batch_file
+            "${CMAKE_CURRENT_BINARY_DIR}/.rcc/qmlcache/${target}_qmlcachegen_batch_${batch_index}.txt")
+        file(GENERATE OUTPUT "${batch_file}" CONTENT "${cachegen_batch_contents}")
+        list(REMOVE_DUPLICATES cachegen_batch_dirs)
+
+        # qmlcachegen leaves outputs whose contents didn't change untouched in
+        # batch mode, so that their C++ files are not recompiled.
+        add_custom_command(
+            OUTPUT ${cachegen_batch_outputs}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${cachegen_batch_dirs}
+            COMMAND
+                ${tool_wrapper}
+                ${qmlcachegen_cmd}
+                --bare
+                --batch-file "${batch_file}"
+                ${cachegen_args}
+            COMMAND_EXPAND_LISTS
+            DEPENDS
+                ${cachegen_batch_inputs}
+                "${batch_file}"
+                $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
+                "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
+                "${qmldir_file}"
+            VERBATIM
+        )
+    endif()
+
     if(ANDROID)
         _qt_internal_collect_qml_root_paths("${target}" ${arg_QML_FILES})
     endif()
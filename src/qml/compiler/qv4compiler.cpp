@@ -219,6 +219,23 @@ int QV4::Compiler::JSUnitGenerator::registerJSClass(const QStringList &members)
     return jsClassOffsets.size() - 1;
 }
 
+int QV4::Compiler::JSUnitGenerator::jsClassSize(int jsClassId) const
+{
+    const CompiledData::JSClass *jsClass = reinterpret_cast<const CompiledData::JSClass*>(
+            jsClassData.data() + jsClassOffsets[jsClassId]);
+    return jsClass->nMembers;
+}
+
+QString QV4::Compiler::JSUnitGenerator::jsClassMember(int jsClassId, int member) const
+{
+    const CompiledData::JSClass *jsClass = reinterpret_cast<const CompiledData::JSClass*>(
+            jsClassData.data() + jsClassOffsets[jsClassId]);
+    Q_ASSERT(member >= 0 && uint(member) < jsClass->nMembers);
+    const CompiledData::JSClassMember *members
+            = reinterpret_cast<const CompiledData::JSClassMember*>(jsClass + 1);
+    return stringForIndex(members[member].nameOffset());
+}
+
 int QV4::Compiler::JSUnitGenerator::registerTranslation(const QV4::CompiledData::TranslationData &translation)
 {
     translations.append(translation);
@@ -61,6 +61,15 @@ struct QQmlProfilerDefinitions {
         MaximumRangeType
     };
 
+    // Sent with the start of Javascript ranges.
+    enum JavaScriptExecutionMode {
+        JavaScriptInterpreted,
+        JavaScriptJitCompiled,
+        JavaScriptAotCompiled,
+
+        MaximumJavaScriptExecutionMode
+    };
+
     enum PixmapEventType {
         PixmapSizeKnown,
         PixmapReferenceCountChanged,
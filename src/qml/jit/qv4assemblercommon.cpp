@@ -7,8 +7,10 @@
 
 #include "qv4engine_p.h"
 #include "qv4assemblercommon_p.h"
+#include "qv4jitcodecache_p.h"
 #include <private/qv4function_p.h>
 #include <private/qv4functiontable_p.h>
+#include <private/qv4mm_p.h>
 #include <private/qv4runtime_p.h>
 
 #include <assembler/MacroAssemblerCodeRef.h>
@@ -89,7 +91,7 @@ static void printDisassembledOutputWithCalls(QByteArray processedOutput,
 JIT::PlatformAssemblerCommon::~PlatformAssemblerCommon()
 {}
 
-void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
+void PlatformAssemblerCommon::link(Function *function, const char *jitKind, CachedCode *cachedCode)
 {
     for (const auto &jumpTarget : jumpsToLink)
         jumpTarget.jump.linkTo(labelForOffset[jumpTarget.offset], this);
@@ -121,8 +123,39 @@ void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
         codeRef = linkBuffer.finalizeCodeWithoutDisassembly();
     }
 
+    if (cachedCode) {
+        // The code calls the runtime through absolute addresses, and the exception handlers are
+        // stored as absolute addresses, too. Everything else is position independent.
+        const char *code = static_cast<const char *>(codeRef.code().dataLocation());
+        const char *entry = static_cast<const char *>(codeRef.code().executableAddress());
+        cachedCode->code = QByteArray(code, qsizetype(codeRef.size()));
+
+        const auto symbols = Runtime::symbolTable();
+        for (const auto &callTarget : callTargets) {
+            CachedCode::Relocation relocation;
+            relocation.offset = quint32(static_cast<const char *>(
+                    linkBuffer.locationOf(callTarget.label).dataLocation()) - code);
+            relocation.kind = CachedCode::Relocation::CallTarget;
+            const char *name = functions.value(callTarget.funcPtr);
+            relocation.symbol = name ? name : symbols.value(callTarget.funcPtr);
+            cachedCode->relocations.push_back(std::move(relocation));
+        }
+
+        for (const auto &ehTarget : ehTargets) {
+            CachedCode::Relocation relocation;
+            relocation.offset = quint32(static_cast<const char *>(
+                    linkBuffer.locationOf(ehTarget.label).dataLocation()) - code);
+            relocation.kind = CachedCode::Relocation::CodeAddress;
+            relocation.codeOffset = quint32(static_cast<const char *>(
+                    linkBuffer.locationOf(labelForOffset.value(ehTarget.offset))
+                            .executableAddress()) - entry);
+            cachedCode->relocations.push_back(std::move(relocation));
+        }
+    }
+
     function->codeRef = new JSC::MacroAssemblerCodeRef(codeRef);
     function->jittedCode = reinterpret_cast<Function::JittedCode>(function->codeRef->code().executableAddress());
+    function->internalClass->engine->memoryManager->jitCodeLinked();
 
     generateFunctionTable(function, &codeRef);
 
@@ -130,6 +163,44 @@ void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
         function->jittedCode = nullptr; // The function is not executable, but the coderef exists.
 }
 
+bool PlatformAssemblerCommon::link(Function *function, const CachedCode &cachedCode)
+{
+    JSC::JSGlobalData dummy(function->internalClass->engine->executableAllocator);
+    RefPtr<JSC::ExecutableMemoryHandle> memory = dummy.executableAllocator.allocate(
+            dummy, size_t(cachedCode.code.size()), nullptr, JSC::JITCompilationCanFail);
+    if (!memory || !memory->m_allocation
+            || !JSC::ExecutableAllocator::makeWritable(memory->memoryStart(),
+                                                       memory->memorySize())) {
+        return false;
+    }
+
+    JSC::MacroAssemblerCodeRef codeRef(memory);
+    char *code = static_cast<char *>(codeRef.code().dataLocation());
+    char *entry = static_cast<char *>(codeRef.code().executableAddress());
+    memcpy(code, cachedCode.code.constData(), size_t(cachedCode.code.size()));
+
+    for (const CachedCode::Relocation &relocation : cachedCode.relocations) {
+        const JSC::CodeLocationDataLabelPtr where(code + relocation.offset);
+        if (relocation.kind == CachedCode::Relocation::CallTarget)
+            repatchPointer(where, const_cast<void *>(relocation.address));
+        else
+            repatchPointer(where, entry + relocation.codeOffset);
+    }
+    cacheFlush(code, size_t(cachedCode.code.size()));
+
+    function->codeRef = new JSC::MacroAssemblerCodeRef(codeRef);
+    function->jittedCode = reinterpret_cast<Function::JittedCode>(entry);
+    function->internalClass->engine->memoryManager->jitCodeLinked();
+
+    generateFunctionTable(function, function->codeRef);
+
+    if (Q_UNLIKELY(!JSC::ExecutableAllocator::makeExecutable(memory->memoryStart(),
+                                                             memory->memorySize()))) {
+        function->jittedCode = nullptr; // The function is not executable, but the coderef exists.
+    }
+    return function->jittedCode != nullptr;
+}
+
 void PlatformAssemblerCommon::prepareCallWithArgCount(int argc)
 {
 #ifndef QT_NO_DEBUG
@@ -290,7 +361,7 @@ void PlatformAssemblerCommon::callRuntimeUnchecked(const void *funcPtr, const ch
 {
     Q_ASSERT(functionName || Runtime::symbolTable().contains(funcPtr));
     functions.insert(funcPtr, functionName);
-    callAbsolute(funcPtr);
+    callTargets.push_back({ callAbsolute(funcPtr), funcPtr });
 }
 
 void PlatformAssemblerCommon::tailCallRuntime(const void *funcPtr, const char *functionName)
@@ -301,7 +372,7 @@ void PlatformAssemblerCommon::tailCallRuntime(const void *funcPtr, const char *f
     setTailCallArg(CppStackFrameRegister, 0);
     freeStackSpace();
     generatePlatformFunctionExit(/*tailCall =*/ true);
-    jumpAbsolute(funcPtr);
+    callTargets.push_back({ jumpAbsolute(funcPtr), funcPtr });
 }
 
 void PlatformAssemblerCommon::setTailCallArg(RegisterID src, int arg)
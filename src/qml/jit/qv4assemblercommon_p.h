@@ -29,6 +29,8 @@ QT_BEGIN_NAMESPACE
 namespace QV4 {
 namespace JIT {
 
+struct CachedCode;
+
 #if defined(Q_PROCESSOR_X86_64) || defined(ENABLE_ALL_ASSEMBLERS_FOR_REFACTORING_PURPOSES)
 #if defined(Q_OS_LINUX) || defined(Q_OS_QNX) || defined(Q_OS_FREEBSD) || defined(Q_OS_DARWIN) || defined(Q_OS_SOLARIS)
 
@@ -91,16 +93,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -177,18 +181,20 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         subPtr(TrustedImm32(4 * PointerSize), StackPointerRegister);
         call(ScratchRegister);
         addPtr(TrustedImm32(4 * PointerSize), StackPointerRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -270,16 +276,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -371,16 +379,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -475,16 +485,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), dataTempRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), dataTempRegister);
         call(dataTempRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), dataTempRegister);
+        const DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), dataTempRegister);
         jump(dataTempRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -654,7 +666,8 @@ public:
         ehTargets.push_back({ label, offset });
     }
 
-    void link(Function *function, const char *jitKind);
+    void link(Function *function, const char *jitKind, CachedCode *cachedCode = nullptr);
+    static bool link(Function *function, const CachedCode &cachedCode);
 
     Value constant(int idx) const
     { return constantTable[idx]; }
@@ -688,6 +701,8 @@ private:
     std::vector<JumpTarget> jumpsToLink;
     struct ExceptionHanlderTarget { JSC::MacroAssemblerBase::DataLabelPtr label; int offset; };
     std::vector<ExceptionHanlderTarget> ehTargets;
+    struct CallTarget { JSC::MacroAssemblerBase::DataLabelPtr label; const void *funcPtr; };
+    std::vector<CallTarget> callTargets;
     QHash<int, JSC::MacroAssemblerBase::Label> labelForOffset;
     QHash<const void *, const char *> functions;
     std::vector<Jump> catchyJumps;
@@ -8,6 +8,7 @@
 #include "qv4baselineassembler_p.h"
 #include "qv4assemblercommon_p.h"
 #include <private/qv4function_p.h>
+#include <private/qv4lookup_p.h>
 #include <private/qv4runtime_p.h>
 #include <private/qv4stackframe_p.h>
 
@@ -343,6 +344,67 @@ public:
         passAsArg(AccumulatorRegister, 0);
         doCall();
     }
+
+    bool getLookupInline(const Lookup *l)
+    {
+        const bool inlineData = l->getter == Lookup::getter0Inline;
+        const bool memberData = l->getter == Lookup::getter0MemberData;
+        const bool proto = l->getter == Lookup::getterProto;
+        if (!inlineData && !memberData && !proto)
+            return false;
+
+        JumpList slowPath;
+
+        // Only managed values can match the lookup. Undefined is encoded as 0.
+        move(TrustedImm64(Value::ManagedMask), ScratchRegister);
+        slowPath.append(branchTest64(NonZero, AccumulatorRegister, ScratchRegister));
+        slowPath.append(branch64(Equal, AccumulatorRegister, TrustedImm64(0)));
+
+        // The lookup has to be in the same state as when we compiled the code.
+        move(TrustedImmPtr(l), ScratchRegister);
+        loadPtr(Address(ScratchRegister, offsetof(Lookup, getter)), ScratchRegister2);
+        slowPath.append(branchPtr(NotEqual, ScratchRegister2,
+                                  TrustedImmPtr(reinterpret_cast<const void *>(l->getter))));
+
+        loadPtr(Address(AccumulatorRegister, offsetof(Heap::Base, internalClass)), ScratchRegister2);
+        if (proto) {
+            loadPtr(Address(ScratchRegister2, offsetof(Heap::InternalClass, protoId)),
+                    ScratchRegister2);
+            slowPath.append(branchPtr(NotEqual,
+                                      Address(ScratchRegister, offsetof(Lookup, protoLookup.protoId)),
+                                      ScratchRegister2));
+            loadPtr(Address(ScratchRegister, offsetof(Lookup, protoLookup.data)), ScratchRegister);
+            load64(Address(ScratchRegister), AccumulatorRegister);
+        } else {
+            slowPath.append(branchPtr(NotEqual,
+                                      Address(ScratchRegister, offsetof(Lookup, objectLookup.ic)),
+                                      ScratchRegister2));
+            load32(Address(ScratchRegister, offsetof(Lookup, objectLookup.offset)), ScratchRegister2);
+            if (memberData) {
+                loadPtr(Address(AccumulatorRegister, decltype(Heap::Object::memberData)::offset),
+                        AccumulatorRegister);
+                load64(BaseIndex(AccumulatorRegister, ScratchRegister2, TimesEight,
+                                 decltype(Heap::MemberData::values)::offset
+                                 + offsetof(ValueArray<0>, values)),
+                       AccumulatorRegister);
+            } else {
+                load64(BaseIndex(AccumulatorRegister, ScratchRegister2, TimesEight),
+                       AccumulatorRegister);
+            }
+        }
+
+        lookupInlineDone = jump();
+        slowPath.link(this);
+        return true;
+    }
+
+    void endLookupInline()
+    {
+        lookupInlineDone.link(this);
+    }
+
+private:
+    Jump lookupInlineDone;
 };
 
 typedef PlatformAssembler64 PlatformAssembler;
@@ -782,6 +844,17 @@ public:
         if (ArgInRegCount < 2)
             addPtr(TrustedImm32(4 * PointerSize), StackPointerRegister);
     }
+
+    // There are not enough scratch registers to do this without spilling, so the optimizing
+    // tier always goes through the runtime here.
+    bool getLookupInline(const Lookup *)
+    {
+        return false;
+    }
+
+    void endLookupInline()
+    {
+    }
 };
 
 typedef PlatformAssembler32 PlatformAssembler;
@@ -821,9 +894,9 @@ void BaselineAssembler::generateEpilogue()
     pasm()->generateCatchTrampoline();
 }
 
-void BaselineAssembler::link(Function *function)
+void BaselineAssembler::link(Function *function, const char *jitKind, CachedCode *cachedCode)
 {
-    pasm()->link(function, "BaselineJIT");
+    pasm()->link(function, jitKind, cachedCode);
 }
 
 void BaselineAssembler::addLabel(int offset)
@@ -1603,11 +1676,40 @@ void BaselineAssembler::deadTemporalZoneCheck(int offsetForSavedIP, int variable
     valueIsAliveJump.link(pasm());
 }
 
+bool BaselineAssembler::getLookupInline(const Lookup *l)
+{
+    return pasm()->getLookupInline(l);
+}
+
+void BaselineAssembler::endLookupInline()
+{
+    pasm()->endLookupInline();
+}
+
 void BaselineAssembler::ret()
 {
     pasm()->generateFunctionExit();
 }
 
+QHash<QByteArray, const void *> BaselineAssembler::callTargets()
+{
+    QHash<QByteArray, const void *> targets;
+    const auto symbols = Runtime::symbolTable();
+    for (auto it = symbols.begin(), end = symbols.end(); it != end; ++it)
+        targets.insert(it.value(), it.key());
+
+    // The helpers are called by the names passed to callHelper() and tailCallRuntime().
+    targets.insert("Value::toBooleanImpl", reinterpret_cast<void *>(&Value::toBooleanImpl));
+    targets.insert("toNumberHelper", reinterpret_cast<void *>(&toNumberHelper));
+    targets.insert("toInt32Helper", reinterpret_cast<void *>(&toInt32Helper));
+    targets.insert("incHelper", reinterpret_cast<void *>(&incHelper));
+    targets.insert("decHelper", reinterpret_cast<void *>(&decHelper));
+    targets.insert("TheJitIs__Tail_Calling__ToTheRuntimeSoTheJitFrameIsMissing",
+                   reinterpret_cast<void *>(
+                           &TheJitIs__Tail_Calling__ToTheRuntimeSoTheJitFrameIsMissing));
+    return targets;
+}
+
 } // JIT namespace
 } // QV4 namepsace
 
@@ -26,6 +26,8 @@ QT_BEGIN_NAMESPACE
 namespace QV4 {
 namespace JIT {
 
+struct CachedCode;
+
 #define GENERATE_RUNTIME_CALL(function, destination) \
     callRuntime(reinterpret_cast<void *>(&Runtime::function::call), \
                 destination)
@@ -40,9 +42,12 @@ public:
     // codegen infrastructure
     void generatePrologue();
     void generateEpilogue();
-    void link(Function *function);
+    void link(Function *function, const char *jitKind, CachedCode *cachedCode = nullptr);
     void addLabel(int offset);
 
+    // everything the generated code calls, by name
+    static QHash<QByteArray, const void *> callTargets();
+
     // loads/stores/moves
     void loadConst(int constIndex);
     void copyConst(int constIndex, int destReg);
@@ -131,6 +136,10 @@ public:
     void popContext();
     void deadTemporalZoneCheck(int offsetForSavedIP, int variableName);
 
+    // inline caches
+    bool getLookupInline(const Lookup *l);
+    void endLookupInline();
+
     // other stuff
     void ret();
 
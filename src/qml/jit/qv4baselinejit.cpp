@@ -3,8 +3,11 @@
 
 #include "qv4baselinejit_p.h"
 #include "qv4baselineassembler_p.h"
+#include "qv4jitcodecache_p.h"
 #include <private/qv4lookup_p.h>
 #include <private/qv4generatorobject_p.h>
+#include <private/qv4mm_p.h>
+#include <private/qv4executablecompilationunit_p.h>
 
 #if QT_CONFIG(qml_jit)
 
@@ -13,9 +16,11 @@ using namespace QV4;
 using namespace QV4::JIT;
 using namespace QV4::Moth;
 
-BaselineJIT::BaselineJIT(Function *function)
+BaselineJIT::BaselineJIT(Function *function, Tier tier)
     : function(function)
       , as(new BaselineAssembler(&(function->compilationUnit->constants->asValue<Value>())))
+      , needsWriteBarrier(function->compilationUnit->engine->memoryManager->needsWriteBarrier())
+      , optimize(tier == Optimizing)
 {}
 
 BaselineJIT::~BaselineJIT()
@@ -36,10 +41,41 @@ void BaselineJIT::generate()
     decode(code, len);
     as->generateEpilogue();
 
-    as->link(function);
+    if (!optimize) {
+        // The optimized code depends on the state of the lookups in this process, the baseline
+        // code does not. Only the latter can be reused by later runs.
+        CodeCache *codeCache = function->executableCompilationUnit()->jitCodeCache.get();
+        if (!codeCache) {
+            as->link(function, "BaselineJIT");
+            return;
+        }
+
+        CachedCode cachedCode;
+        as->link(function, "BaselineJIT", &cachedCode);
+        if (function->jittedCode)
+            codeCache->add(function, std::move(cachedCode));
+        return;
+    }
+
+    // Frames further up the stack may still be running the baseline code, so keep it around
+    // for as long as the function lives. If the optimized code cannot be made executable we
+    // continue with the baseline code rather than falling back to the interpreter.
+    JSC::MacroAssemblerCodeRef *baselineCodeRef = function->codeRef;
+    Function::JittedCode baselineCode = function->jittedCode;
+    as->link(function, "OptimizingJIT");
+    function->baselineCodeRef = baselineCodeRef;
+    if (function->jittedCode == nullptr)
+        function->jittedCode = baselineCode;
 //    qDebug()<<"done";
 }
 
+const Lookup *BaselineJIT::feedbackLookup(int index) const
+{
+    if (!optimize)
+        return nullptr;
+    return function->executableCompilationUnit()->runtimeLookups + index;
+}
+
 #define STORE_IP() as->storeInstructionPointer(nextInstructionOffset())
 #define STORE_ACC() as->saveAccumulatorInFrame()
 #define LOAD_ACC() as->loadAccumulatorFromFrame()
@@ -126,7 +162,10 @@ void BaselineJIT::generate_LoadLocal(int index)
 void BaselineJIT::generate_StoreLocal(int index)
 {
     as->checkException();
-    as->storeLocal(index);
+    if (needsWriteBarrier)
+        storeLocalWithBarrier(0, index);
+    else
+        as->storeLocal(index);
 }
 
 void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
@@ -137,7 +176,24 @@ void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
 void BaselineJIT::generate_StoreScopedLocal(int scope, int index)
 {
     as->checkException();
-    as->storeLocal(index, scope);
+    if (needsWriteBarrier)
+        storeLocalWithBarrier(scope, index);
+    else
+        as->storeLocal(index, scope);
+}
+
+// Call contexts live on the GC heap. The inline store bypasses the write barrier, which is
+// only fine as long as the memory manager never lets the mutator run during marking.
+void BaselineJIT::storeLocalWithBarrier(int scope, int index)
+{
+    STORE_ACC();
+    as->prepareCallWithArgCount(4);
+    as->passAccumulatorAsArg(3);
+    as->passInt32AsArg(index, 2);
+    as->passInt32AsArg(scope, 1);
+    as->passEngineAsArg(0);
+    BASELINEJIT_GENERATE_RUNTIME_CALL(StoreScopedLocal, CallResultDestination::Ignore);
+    LOAD_ACC();
 }
 
 void BaselineJIT::generate_LoadRuntimeString(int stringId)
@@ -256,6 +312,11 @@ void BaselineJIT::generate_LoadOptionalProperty(int name, int offset)
 
 void BaselineJIT::generate_GetLookup(int index)
 {
+    // The inline path re-checks the state of the lookup at run time and takes the regular
+    // runtime call below whenever the lookup has moved on from what we saw here.
+    const Lookup *l = feedbackLookup(index);
+    const bool inlined = l && as->getLookupInline(l);
+
     STORE_IP();
     STORE_ACC();
     as->prepareCallWithArgCount(4);
@@ -264,6 +325,9 @@ void BaselineJIT::generate_GetLookup(int index)
     as->passFunctionAsArg(1);
     as->passEngineAsArg(0);
     BASELINEJIT_GENERATE_RUNTIME_CALL(GetLookup, CallResultDestination::InAccumulator);
+
+    if (inlined)
+        as->endLookupInline();
 }
 
 void BaselineJIT::generate_GetOptionalLookup(int index, int offset)
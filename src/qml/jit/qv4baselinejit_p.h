@@ -33,7 +33,12 @@ class BaselineAssembler;
 class BaselineJIT final: public Moth::ByteCodeHandler
 {
 public:
-    BaselineJIT(QV4::Function *);
+    enum Tier {
+        Baseline,
+        Optimizing // inlines the lookups that have stayed monomorphic so far
+    };
+
+    BaselineJIT(QV4::Function *, Tier tier = Baseline);
     ~BaselineJIT() override;
 
     void generate();
@@ -177,9 +182,14 @@ public:
     void endInstruction(Moth::Instr::Type instr) override;
 
 private:
+    void storeLocalWithBarrier(int scope, int index);
+    const Lookup *feedbackLookup(int index) const;
+
     QV4::Function *function;
     QScopedPointer<BaselineAssembler> as;
     QSet<int> labels;
+    bool needsWriteBarrier = false;
+    bool optimize = false;
 };
 
 } // namespace JIT
@@ -0,0 +1,214 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qv4jitcodecache_p.h"
+#include "qv4assemblercommon_p.h"
+#include "qv4baselineassembler_p.h"
+
+#include <private/qml_compile_hash_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4mm_p.h>
+
+#include <QtQml/qqmlfile.h>
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qsysinfo.h>
+
+#include <algorithm>
+
+#if QT_CONFIG(qml_jit)
+
+Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+namespace JIT {
+
+static const char magic[] = "qv4jitcode";
+static const quint32 formatVersion = 1;
+
+static QDataStream &operator<<(QDataStream &stream, const CachedCode &cachedCode)
+{
+    stream << cachedCode.functionIndex << cachedCode.code
+           << quint32(cachedCode.relocations.size());
+    for (const CachedCode::Relocation &relocation : cachedCode.relocations) {
+        stream << relocation.offset << quint8(relocation.kind);
+        if (relocation.kind == CachedCode::Relocation::CallTarget)
+            stream << relocation.symbol;
+        else
+            stream << relocation.codeOffset;
+    }
+    return stream;
+}
+
+static QDataStream &operator>>(QDataStream &stream, CachedCode &cachedCode)
+{
+    quint32 relocationCount = 0;
+    stream >> cachedCode.functionIndex >> cachedCode.code >> relocationCount;
+    for (quint32 i = 0; i < relocationCount && stream.status() == QDataStream::Ok; ++i) {
+        CachedCode::Relocation relocation;
+        quint8 kind = 0;
+        stream >> relocation.offset >> kind;
+        relocation.kind = CachedCode::Relocation::Kind(kind);
+        if (relocation.kind == CachedCode::Relocation::CallTarget)
+            stream >> relocation.symbol;
+        else
+            stream >> relocation.codeOffset;
+        cachedCode.relocations.push_back(std::move(relocation));
+    }
+    return stream;
+}
+
+// Checks that the code can be placed into this process as is, after the relocations are applied.
+static bool resolve(CachedCode *cachedCode, const QHash<QByteArray, const void *> &callTargets)
+{
+    const quint32 size = quint32(cachedCode->code.size());
+    for (CachedCode::Relocation &relocation : cachedCode->relocations) {
+        if (relocation.offset > size)
+            return false;
+        switch (relocation.kind) {
+        case CachedCode::Relocation::CallTarget:
+            relocation.address = callTargets.value(relocation.symbol);
+            if (!relocation.address)
+                return false;
+            break;
+        case CachedCode::Relocation::CodeAddress:
+            if (relocation.codeOffset >= size)
+                return false;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<CodeCache> CodeCache::create(ExecutableCompilationUnit *unit)
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QV4_JIT_CODE_CACHE") > 0
+            && !qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER");
+    if (!enabled || !unit->engine->canJIT() || !unit->engine->diskCacheEnabled())
+        return nullptr;
+
+    const QUrl url = unit->url();
+    if (!QQmlFile::isLocalFile(url))
+        return nullptr;
+
+    // The code is only valid for the exact byte code it was generated from.
+    const char *checksum = unit->data->md5Checksum;
+    if (std::all_of(checksum, checksum + sizeof(unit->data->md5Checksum),
+                    [](char c) { return c == 0; })) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<CodeCache>(new CodeCache(
+            unit, ExecutableCompilationUnit::localCacheFilePath(url) + QLatin1String(".jit")));
+}
+
+CodeCache::CodeCache(ExecutableCompilationUnit *unit, const QString &filePath)
+    : unit(unit)
+    , filePath(filePath)
+    , writeBarrier(unit->engine->memoryManager->needsWriteBarrier())
+{
+}
+
+QByteArray CodeCache::header() const
+{
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << QByteArray(magic) << formatVersion
+           << QByteArray(QML_COMPILE_HASH, QML_COMPILE_HASH_LENGTH)
+           << QSysInfo::buildAbi().toLatin1() << quint8(QT_POINTER_SIZE) << writeBarrier
+           << QByteArray(unit->data->md5Checksum, sizeof(unit->data->md5Checksum));
+    return header;
+}
+
+void CodeCache::load()
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    QByteArray fileHeader;
+    quint32 functionCount = 0;
+    stream >> fileHeader >> functionCount;
+    if (stream.status() != QDataStream::Ok || fileHeader != header()) {
+        qCDebug(DBG_DISK_CACHE) << "Ignoring outdated JIT code cache" << filePath;
+        return;
+    }
+
+    static const QHash<QByteArray, const void *> callTargets = BaselineAssembler::callTargets();
+    const auto &runtimeFunctions = unit->runtimeFunctions;
+    for (quint32 i = 0; i < functionCount; ++i) {
+        CachedCode cachedCode;
+        stream >> cachedCode;
+        if (stream.status() != QDataStream::Ok) {
+            qCDebug(DBG_DISK_CACHE) << "Error reading JIT code cache" << filePath;
+            return;
+        }
+
+        if (cachedCode.functionIndex >= quint32(runtimeFunctions.size()))
+            continue;
+        Function *function = runtimeFunctions.at(cachedCode.functionIndex);
+        if (function->codeRef || function->kind == Function::AotCompiled
+                || function->isGenerator() || !resolve(&cachedCode, callTargets)) {
+            continue;
+        }
+
+        if (PlatformAssemblerCommon::link(function, cachedCode))
+            functions.push_back(std::move(cachedCode));
+    }
+
+    qCDebug(DBG_DISK_CACHE) << "Loaded JIT code for" << functions.size() << "functions from"
+                            << filePath;
+}
+
+void CodeCache::add(Function *function, CachedCode &&cachedCode)
+{
+    // Code generated after the garbage collector has changed modes does not match the header.
+    if (unit->engine->memoryManager->needsWriteBarrier() != writeBarrier)
+        return;
+
+    const qsizetype index = unit->runtimeFunctions.indexOf(function);
+    Q_ASSERT(index >= 0);
+    cachedCode.functionIndex = quint32(index);
+    functions.push_back(std::move(cachedCode));
+    dirty = true;
+}
+
+void CodeCache::save()
+{
+    if (!dirty)
+        return;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << header() << quint32(functions.size());
+    for (const CachedCode &cachedCode : functions)
+        stream << cachedCode;
+
+    QString errorString;
+    if (CompiledData::SaveableUnitPointer::writeDataToFile(
+                filePath, data.constData(), quint32(data.size()), &errorString)) {
+        dirty = false;
+    } else {
+        qCDebug(DBG_DISK_CACHE) << "Error saving JIT code cache" << filePath << ":" << errorString;
+    }
+}
+
+} // JIT namespace
+} // QV4 namespace
+
+QT_END_NAMESPACE
+
+#endif // QT_CONFIG(qml_jit)
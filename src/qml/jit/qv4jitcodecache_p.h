@@ -0,0 +1,92 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QV4JITCODECACHE_P_H
+#define QV4JITCODECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qv4global_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+#include <vector>
+
+#if QT_CONFIG(qml_jit)
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+
+class ExecutableCompilationUnit;
+struct Function;
+
+namespace JIT {
+
+// The baseline JIT code of one function. Everything in it that depends on where the code or
+// the runtime functions end up in memory is described by a relocation.
+struct CachedCode
+{
+    struct Relocation
+    {
+        enum Kind : quint8 {
+            CallTarget, // a runtime function or helper, identified by its name
+            CodeAddress // a location in the code itself, e.g. an exception handler
+        };
+
+        quint32 offset = 0; // of the pointer to patch, from the start of the code
+        Kind kind = CallTarget;
+        quint32 codeOffset = 0;
+        QByteArray symbol;
+        const void *address = nullptr; // of the symbol in this process
+    };
+
+    quint32 functionIndex = 0;
+    QByteArray code;
+    std::vector<Relocation> relocations;
+};
+
+// Keeps the baseline JIT code of the functions of a compilation unit in a file next to its
+// disk cache file, so that the next process can run them as native code right away. The file
+// is only used by the same build of the engine, for the same byte code, with the same code
+// generation options.
+class CodeCache
+{
+    Q_DISABLE_COPY_MOVE(CodeCache)
+public:
+    static std::unique_ptr<CodeCache> create(ExecutableCompilationUnit *unit);
+
+    void load();
+    void add(Function *function, CachedCode &&cachedCode);
+    void save();
+
+private:
+    CodeCache(ExecutableCompilationUnit *unit, const QString &filePath);
+
+    QByteArray header() const;
+
+    ExecutableCompilationUnit *unit;
+    QString filePath;
+    std::vector<CachedCode> functions;
+    bool writeBarrier;
+    bool dirty = false;
+};
+
+} // JIT namespace
+} // QV4 namespace
+
+QT_END_NAMESPACE
+
+#endif // QT_CONFIG(qml_jit)
+
+#endif // QV4JITCODECACHE_P_H
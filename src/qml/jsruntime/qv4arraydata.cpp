@@ -51,6 +51,9 @@ Q_STATIC_ASSERT(sizeof(Heap::ArrayData) == sizeof(Heap::SparseArrayData));
 void Heap::ArrayData::markObjects(Heap::Base *base, MarkStack *stack)
 {
     ArrayData *a = static_cast<ArrayData *>(base);
+    // Arrays that only ever held numbers don't reference anything on the heap.
+    if (a->hasNumericElements())
+        return;
     a->values.mark(stack);
 }
 
@@ -104,6 +107,10 @@ void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAtt
     newData->setAlloc(alloc);
     newData->setType(newType);
     newData->setAttrs(enforceAttributes ? reinterpret_cast<PropertyAttributes *>(newData->d()->values.values + alloc) : nullptr);
+    if (newType != Heap::ArrayData::Simple || enforceAttributes)
+        newData->d()->elementKind = Heap::ArrayData::HoleyElements;
+    else
+        newData->d()->elementKind = d ? d->d()->elementKind : Heap::ArrayData::PackedInt32Elements;
     o->setArrayData(newData);
 
     if (d) {
@@ -193,6 +200,8 @@ bool SimpleArrayData::put(Object *o, uint index, const Value &value)
     Q_ASSERT(index >= dd->values.size || !dd->attrs || !dd->attrs[index].isAccessor());
     // ### honour attributes
     dd->setData(o->engine(), index, value);
+    if (index > dd->values.size)
+        dd->elementKind = Heap::ArrayData::HoleyElements;
     if (index >= dd->values.size) {
         if (dd->attrs)
             dd->attrs[index] = Attr_Data;
@@ -56,7 +56,7 @@ namespace Heap {
 
 #define ArrayDataMembers(class, Member) \
     Member(class, NoMark, ushort, type) \
-    Member(class, NoMark, ushort, unused) \
+    Member(class, NoMark, ushort, elementKind) \
     Member(class, NoMark, uint, offset) \
     Member(class, NoMark, PropertyAttributes *, attrs) \
     Member(class, NoMark, SparseArray *, sparse) \
@@ -67,8 +67,37 @@ DECLARE_HEAP_OBJECT(ArrayData, Base) {
 
     enum Type { Simple = 0, Sparse = 1, Custom = 2 };
 
+    // What we know about the elements of a Simple array without attributes. The kind only
+    // ever gets more general (towards HoleyElements) while the array is alive, so code that
+    // checks it can rely on it as long as it doesn't write to the array itself.
+    enum ElementKind {
+        HoleyElements = 0,          // no guarantees, also used for Sparse and Custom data
+        PackedElements = 1,         // no holes below values.size
+        PackedDoubleElements = 2,   // no holes, only numbers
+        PackedInt32Elements = 3     // no holes, only int32 values
+    };
+
     bool isSparse() const { return type == Sparse; }
 
+    static ElementKind elementKindOf(Value v) {
+        if (v.isInteger())
+            return PackedInt32Elements;
+        if (v.isDouble())
+            return PackedDoubleElements;
+        return v.isEmpty() ? HoleyElements : PackedElements;
+    }
+    void noteElement(Value v) {
+        const ElementKind kind = elementKindOf(v);
+        if (kind < elementKind)
+            elementKind = kind;
+    }
+    bool hasPackedElements() const {
+        return type == Simple && !attrs && elementKind != HoleyElements;
+    }
+    bool hasNumericElements() const {
+        return hasPackedElements() && elementKind >= PackedDoubleElements;
+    }
+
     const ArrayVTable *vtable() const { return reinterpret_cast<const ArrayVTable *>(internalClass->vtable); }
 
     inline ReturnedValue get(uint i) const {
@@ -88,6 +117,7 @@ DECLARE_HEAP_OBJECT(ArrayData, Base) {
     }
 
     void setArrayData(EngineBase *e, uint index, Value newVal) {
+        noteElement(newVal);
         values.set(e, index, newVal);
     }
 
@@ -99,6 +129,7 @@ struct SimpleArrayData : public ArrayData {
     uint mappedIndex(uint index) const { index += offset; if (index >= values.alloc) index -= values.alloc; return index; }
     const Value &data(uint index) const { return values[mappedIndex(index)]; }
     void setData(EngineBase *e, uint index, Value newVal) {
+        noteElement(newVal);
         values.set(e, mappedIndex(index), newVal);
     }
 
@@ -332,9 +363,12 @@ void ArrayData::setProperty(QV4::EngineBase *e, uint index, const Property *p)
 {
     uint mapped = mappedIndex(index);
     Q_ASSERT(mapped != UINT_MAX);
+    noteElement(p->value);
     values.set(e, mapped, p->value);
-    if (attributes(index).isAccessor())
+    if (attributes(index).isAccessor()) {
+        noteElement(p->set);
         values.set(e, mapped + 1 /*QV4::Object::SetterOffset*/, p->set);
+    }
 }
 
 inline PropertyAttributes ArrayData::attributes(uint i) const
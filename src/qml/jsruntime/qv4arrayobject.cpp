@@ -996,6 +996,18 @@ ReturnedValue ArrayPrototype::method_unshift(const FunctionObject *b, const Valu
     return Encode(newLen);
 }
 
+// Returns the array data of \a instance if its first \a len elements can be read and written
+// directly: a packed Simple array without attributes, and no indexed properties on the prototypes.
+static Heap::SimpleArrayData *packedArrayData(Object *instance, qint64 len)
+{
+    if (!instance->isArrayObject() || instance->protoHasArray())
+        return nullptr;
+    Heap::ArrayData *arrayData = instance->d()->arrayData;
+    if (!arrayData || !arrayData->hasPackedElements() || len > arrayData->values.size)
+        return nullptr;
+    return static_cast<Heap::SimpleArrayData *>(arrayData);
+}
+
 ReturnedValue ArrayPrototype::method_includes(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
 {
     Scope scope(b);
@@ -1023,6 +1035,30 @@ ReturnedValue ArrayPrototype::method_includes(const FunctionObject *b, const Val
         }
     }
 
+    if (k >= len)
+        return Encode(false);
+
+    const Value searchValue = argc ? argv[0] : Value::undefinedValue();
+    if (Heap::SimpleArrayData *sa = packedArrayData(instance, len)) {
+        if (sa->hasNumericElements()) {
+            if (!searchValue.isNumber())
+                return Encode(false);
+            const double search = searchValue.asDouble();
+            const bool searchNaN = std::isnan(search);
+            for (uint i = uint(k); i < uint(len); ++i) {
+                const double element = sa->data(i).asDouble();
+                if (element == search || (searchNaN && std::isnan(element)))
+                    return Encode(true);
+            }
+            return Encode(false);
+        }
+        for (uint i = uint(k); i < uint(len); ++i) {
+            if (sa->data(i).sameValueZero(searchValue))
+                return Encode(true);
+        }
+        return Encode(false);
+    }
+
     ScopedValue val(scope);
     while (k < len) {
         val = instance->get(k);
@@ -1089,6 +1125,25 @@ ReturnedValue ArrayPrototype::method_indexOf(const FunctionObject *b, const Valu
         Heap::SimpleArrayData *sa = instance->d()->arrayData.cast<Heap::SimpleArrayData>();
         if (len > sa->values.size)
             len = sa->values.size;
+        if (sa->hasNumericElements()) {
+            // Only numbers can be strictly equal to the elements, so we can compare them directly.
+            if (!searchValue->isNumber())
+                return Encode(-1);
+            if (sa->elementKind == Heap::ArrayData::PackedInt32Elements && searchValue->isInteger()) {
+                const int search = searchValue->int_32();
+                for (uint idx = fromIndex; idx < len; ++idx) {
+                    if (sa->data(idx).int_32() == search)
+                        return Encode(idx);
+                }
+            } else {
+                const double search = searchValue->asDouble();
+                for (uint idx = fromIndex; idx < len; ++idx) {
+                    if (sa->data(idx).asDouble() == search)
+                        return Encode(idx);
+                }
+            }
+            return Encode(-1);
+        }
         uint idx = fromIndex;
         while (idx < len) {
             value = sa->data(idx);
@@ -1145,6 +1200,26 @@ ReturnedValue ArrayPrototype::method_lastIndexOf(const FunctionObject *b, const
         fromIndex = (uint) f + 1;
     }
 
+    if (Heap::SimpleArrayData *sa = packedArrayData(instance, fromIndex)) {
+        if (sa->hasNumericElements()) {
+            if (!searchValue->isNumber())
+                return Encode(-1);
+            const double search = searchValue->asDouble();
+            for (uint k = fromIndex; k > 0;) {
+                --k;
+                if (sa->data(k).asDouble() == search)
+                    return Encode(k);
+            }
+            return Encode(-1);
+        }
+        for (uint k = fromIndex; k > 0;) {
+            --k;
+            if (RuntimeHelpers::strictEqual(sa->data(k), searchValue))
+                return Encode(k);
+        }
+        return Encode(-1);
+    }
+
     ScopedValue v(scope);
     for (uint k = fromIndex; k > 0;) {
         --k;
@@ -1227,6 +1302,13 @@ ReturnedValue ArrayPrototype::method_fill(const FunctionObject *b, const Value *
     if (sizeof(qsizetype) > sizeof(uint) && fin > qsizetype(std::numeric_limits<uint>::max()))
         return scope.engine->throwRangeError(QString::fromLatin1("Array length out of range."));
 
+    if (Heap::SimpleArrayData *sa = packedArrayData(instance, fin)) {
+        const Value value = argc ? argv[0] : Value::undefinedValue();
+        for (; k < fin; ++k)
+            sa->setData(scope.engine, uint(k), value);
+        return instance.asReturnedValue();
+    }
+
     for (; k < fin; ++k)
         instance->setIndexed(uint(k), argv[0], QV4::Object::DoThrowOnRejection);
 
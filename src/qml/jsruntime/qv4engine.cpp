@@ -35,6 +35,7 @@
 #include <qv4numberobject_p.h>
 #include <qv4regexpobject_p.h>
 #include <qv4regexp_p.h>
+#include <qv4lookup_p.h>
 #include "qv4symbol_p.h"
 #include "qv4setobject_p.h"
 #include "qv4mapobject_p.h"
@@ -108,6 +109,7 @@ using namespace QV4;
 static QBasicAtomicInt engineSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
 int ExecutionEngine::s_maxCallDepth = -1;
 int ExecutionEngine::s_jitCallCountThreshold = 3;
+int ExecutionEngine::s_jitOptimizeCallCountThreshold = 1000;
 int ExecutionEngine::s_maxJSStackSize = 4 * 1024 * 1024;
 int ExecutionEngine::s_maxGCStackSize = 2 * 1024 * 1024;
 
@@ -316,6 +318,13 @@ void ExecutionEngine::initializeStaticMembers()
     if (qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER"))
         s_jitCallCountThreshold = std::numeric_limits<int>::max();
 
+    ok = false;
+    s_jitOptimizeCallCountThreshold = qEnvironmentVariableIntValue("QV4_JIT_OPTIMIZE_THRESHOLD", &ok);
+    if (!ok)
+        s_jitOptimizeCallCountThreshold = 1000;
+    else if (s_jitOptimizeCallCountThreshold < 0)
+        s_jitOptimizeCallCountThreshold = std::numeric_limits<int>::max();
+
     qMetaTypeId<QJSValue>();
     qMetaTypeId<QList<int> >();
 
@@ -400,6 +409,7 @@ ExecutionEngine::ExecutionEngine(QJSEngine *jsEngine)
     jsStackLimit = jsStackBase + s_maxJSStackSize/sizeof(Value);
 
     identifierTable = new IdentifierTable(this);
+    megamorphicLookupCache = new MegamorphicLookupCache;
 
     memset(classes, 0, sizeof(classes));
     classes[Class_Empty] = memoryManager->allocIC<InternalClass>();
@@ -862,6 +872,9 @@ ExecutionEngine::~ExecutionEngine()
     while (!compilationUnits.isEmpty())
         (*compilationUnits.begin())->unlink();
 
+    megamorphicLookupCache->dumpStatistics();
+    delete megamorphicLookupCache;
+
     delete bumperPointerAllocator;
     delete regExpCache;
     delete regExpAllocator;
@@ -982,9 +995,12 @@ Heap::ArrayObject *ExecutionEngine::newArrayObject(const Value *values, int leng
         Heap::SimpleArrayData *d = scope.engine->memoryManager->allocManaged<SimpleArrayData>(size);
         d->init();
         d->type = Heap::ArrayData::Simple;
+        d->elementKind = Heap::ArrayData::PackedInt32Elements;
         d->offset = 0;
         d->values.alloc = length;
         d->values.size = length;
+        for (int i = 0; i < length; ++i)
+            d->noteElement(values[i]);
         // this doesn't require a write barrier, things will be ok, when the new array data gets inserted into
         // the parent object
         memcpy(&d->values.values, values, length*sizeof(Value));
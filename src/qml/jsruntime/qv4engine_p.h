@@ -480,6 +480,9 @@ public:
 
     RegExpCache *regExpCache;
 
+    // Property lookups that have seen too many different objects share this cache.
+    MegamorphicLookupCache *megamorphicLookupCache = nullptr;
+
     // Scarce resources are "exceptionally high cost" QVariant types where allowing the
     // normal JavaScript GC to clean them up is likely to lead to out-of-memory or other
     // out-of-resource situations.  When such a resource is passed into JavaScript we
@@ -676,6 +679,19 @@ public:
 #endif
     }
 
+    bool canOptimizeJIT(Function *f) const
+    {
+#if QT_CONFIG(qml_jit)
+        // Only baseline code that is actually executable gets recompiled, and only once.
+        return f->jittedCode != nullptr
+                && f->baselineCodeRef == nullptr
+                && f->jittedCallCount >= s_jitOptimizeCallCountThreshold;
+#else
+        Q_UNUSED(f);
+        return false;
+#endif
+    }
+
     QV4::ReturnedValue global();
     void initQmlGlobalObject();
     void initializeGlobal();
@@ -813,6 +829,7 @@ private:
 
     static int s_maxCallDepth;
     static int s_jitCallCountThreshold;
+    static int s_jitOptimizeCallCountThreshold;
     static int s_maxJSStackSize;
     static int s_maxGCStackSize;
 
@@ -45,7 +45,8 @@ struct Q_QML_EXPORT EngineBase {
 
     quint8 isExecutingInRegExpJIT = false;
     quint8 isInitialized = false;
-    quint8 padding[2];
+    quint8 isGCOngoing = false; // an incremental mark is in progress, write barriers are active
+    quint8 isGenerationalGC = false; // the write barrier records old-to-young references
     MemoryManager *memoryManager = nullptr;
 
     union {
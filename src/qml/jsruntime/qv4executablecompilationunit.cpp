@@ -22,6 +22,9 @@
 #include <private/inlinecomponentutils_p.h>
 #include <private/qv4resolvedtypereference_p.h>
 #include <private/qv4objectiterator_p.h>
+#if QT_CONFIG(qml_jit)
+#include <private/qv4jitcodecache_p.h>
+#endif
 
 #include <QtQml/qqmlfile.h>
 #include <QtQml/qqmlpropertymap.h>
@@ -31,6 +34,7 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qscopeguard.h>
 #include <QtCore/qcryptographichash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/QScopedValueRollback>
 
 static_assert(QV4::CompiledData::QmlCompileHashSpace > QML_COMPILE_HASH_LENGTH);
@@ -62,21 +66,30 @@ ExecutableCompilationUnit::ExecutableCompilationUnit(
 ExecutableCompilationUnit::~ExecutableCompilationUnit()
 {
     unlink();
+
+    // The base class must not look at the data anymore once we have released it.
+    if (!sharedUnitData.isNull())
+        setUnitData(nullptr);
 }
 
-QString ExecutableCompilationUnit::localCacheFilePath(const QUrl &url)
+QString ExecutableCompilationUnit::localCacheDirectory()
 {
     static const QByteArray envCachePath = qgetenv("QML_DISK_CACHE_PATH");
 
-    const QString localSourcePath = QQmlFile::urlToLocalFileOrQrc(url);
-    const QString cacheFileSuffix = QFileInfo(localSourcePath + QLatin1Char('c')).completeSuffix();
-    QCryptographicHash fileNameHash(QCryptographicHash::Sha1);
-    fileNameHash.addData(localSourcePath.toUtf8());
     QString directory = envCachePath.isEmpty()
             ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qmlcache/")
             : QString::fromLocal8Bit(envCachePath) + QLatin1String("/");
     QDir::root().mkpath(directory);
-    return directory + QString::fromUtf8(fileNameHash.result().toHex()) + QLatin1Char('.') + cacheFileSuffix;
+    return directory;
+}
+
+QString ExecutableCompilationUnit::localCacheFilePath(const QUrl &url)
+{
+    const QString localSourcePath = QQmlFile::urlToLocalFileOrQrc(url);
+    const QString cacheFileSuffix = QFileInfo(localSourcePath + QLatin1Char('c')).completeSuffix();
+    QCryptographicHash fileNameHash(QCryptographicHash::Sha1);
+    fileNameHash.addData(localSourcePath.toUtf8());
+    return localCacheDirectory() + QString::fromUtf8(fileNameHash.result().toHex()) + QLatin1Char('.') + cacheFileSuffix;
 }
 
 static QString toString(QV4::ReturnedValue v)
@@ -200,6 +213,12 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
                                                     advanceAotFunction(i));
     }
 
+#if QT_CONFIG(qml_jit)
+    jitCodeCache = JIT::CodeCache::create(this);
+    if (jitCodeCache)
+        jitCodeCache->load();
+#endif
+
     Scope scope(engine);
     Scoped<InternalClass> ic(scope);
 
@@ -298,6 +317,13 @@ void ExecutableCompilationUnit::unlink()
     delete [] runtimeLookups;
     runtimeLookups = nullptr;
 
+#if QT_CONFIG(qml_jit)
+    if (jitCodeCache) {
+        jitCodeCache->save();
+        jitCodeCache.reset();
+    }
+#endif
+
     for (QV4::Function *f : std::as_const(runtimeFunctions))
         f->destroy();
     runtimeFunctions.clear();
@@ -888,6 +914,101 @@ bool ExecutableCompilationUnit::saveToDisk(const QUrl &unitUrl, QString *errorSt
     });
 }
 
+namespace {
+// The data of the units compiled in memory, by URL. Units loaded from disk are already shared
+// between engines through their mappings.
+class SharedUnitCache
+{
+public:
+    QByteArray get(const QString &url)
+    {
+        QMutexLocker locker(&mutex);
+        return units.value(url);
+    }
+
+    void set(const QString &url, const QByteArray &unitData)
+    {
+        QMutexLocker locker(&mutex);
+        if (units.size() >= pruneSize) {
+            // Drop the units no engine holds anymore.
+            units.removeIf([](const QHash<QString, QByteArray>::iterator &it) {
+                return it.value().isDetached();
+            });
+            pruneSize = std::max(MinimumPruneSize, 2 * units.size());
+        }
+        units.insert(url, unitData);
+    }
+
+private:
+    static constexpr qsizetype MinimumPruneSize = 64;
+
+    QMutex mutex;
+    QHash<QString, QByteArray> units;
+    qsizetype pruneSize = MinimumPruneSize;
+};
+}
+
+Q_GLOBAL_STATIC(SharedUnitCache, sharedUnitCache)
+
+static bool sharedUnitsEnabled()
+{
+    static const bool disabled = qEnvironmentVariableIntValue("QML_DISABLE_SHARED_UNITS") > 0;
+    return !disabled;
+}
+
+bool ExecutableCompilationUnit::loadFromSharedCache(
+        const QUrl &url, const QDateTime &sourceTimeStamp)
+{
+    Q_ASSERT(!data);
+
+    if (!sharedUnitsEnabled())
+        return false;
+
+    const QByteArray unitData = sharedUnitCache()->get(url.toString());
+    if (unitData.isNull())
+        return false;
+
+    const auto *unit = reinterpret_cast<const CompiledData::Unit *>(unitData.constData());
+    QString errorString;
+    if (!verifyHeader(unit, sourceTimeStamp, &errorString))
+        return false;
+
+    setUnitData(unit);
+    sharedUnitData = unitData;
+    return true;
+}
+
+/*!
+    \internal
+    Moves the data of a unit compiled in memory into the process wide cache, so that other engines
+    loading the same source can use it instead of compiling their own. Like for the disk cache,
+    the source file needs a time stamp to detect changes.
+ */
+void ExecutableCompilationUnit::shareUnitData(const QUrl &url)
+{
+    if (!sharedUnitsEnabled() || backingFile || !sharedUnitData.isNull())
+        return;
+
+    if (!data || data->sourceTimeStamp == 0 || (data->flags & CompiledData::Unit::StaticData)
+            || qmlData != data->qmlUnit() || !dynamicStrings.isEmpty()) {
+        return;
+    }
+
+    QByteArray unitData;
+    CompiledData::SaveableUnitPointer(data).saveToDisk<char>(
+            [&unitData](const char *unit, quint32 size) {
+        unitData = QByteArray(unit, size);
+        return true;
+    });
+
+    const CompiledData::Unit *oldData = data;
+    setUnitData(reinterpret_cast<const CompiledData::Unit *>(unitData.constData()));
+    free(const_cast<CompiledData::Unit *>(oldData));
+    sharedUnitData = unitData;
+
+    sharedUnitCache()->set(url.toString(), unitData);
+}
+
 /*!
     \internal
     This function creates a temporary key vector and sorts it to guarantuee a stable
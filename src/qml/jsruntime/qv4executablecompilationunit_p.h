@@ -56,6 +56,9 @@ namespace QV4 {
 typedef QVector<const QQmlPropertyData *> BindingPropertyData;
 
 class CompilationUnitMapper;
+#if QT_CONFIG(qml_jit)
+namespace JIT { class CodeCache; }
+#endif
 class ResolvedTypeReference;
 // map from name index
 struct ResolvedTypeReferenceMap: public QHash<int, ResolvedTypeReference*>
@@ -152,6 +155,11 @@ public:
     QHash<int, InlineComponentData> inlineComponentData;
 
     std::unique_ptr<CompilationUnitMapper> backingFile;
+    // Keeps the unit data alive if it is shared with the other engines in the process.
+    QByteArray sharedUnitData;
+#if QT_CONFIG(qml_jit)
+    std::unique_ptr<JIT::CodeCache> jitCodeCache;
+#endif
 
     // --- interface for QQmlPropertyCacheCreator
     using CompiledObject = const CompiledData::Object;
@@ -275,9 +283,13 @@ public:
 
     bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString);
 
+    static QString localCacheDirectory();
     static QString localCacheFilePath(const QUrl &url);
     bool saveToDisk(const QUrl &unitUrl, QString *errorString);
 
+    bool loadFromSharedCache(const QUrl &url, const QDateTime &sourceTimeStamp);
+    void shareUnitData(const QUrl &url);
+
     QString bindingValueAsString(const CompiledData::Binding *binding) const;
 
     struct TranslationDataIndex
@@ -187,6 +187,10 @@ Function::~Function()
         destroyFunctionTable(this, codeRef);
         delete codeRef;
     }
+    if (baselineCodeRef) {
+        destroyFunctionTable(this, baselineCodeRef);
+        delete baselineCodeRef;
+    }
     if (kind == JsTyped)
         delete typedFunction;
 }
@@ -74,11 +74,22 @@ public:
     typedef ReturnedValue (*JittedCode)(CppStackFrame *, ExecutionEngine *);
     JittedCode jittedCode;
     JSC::MacroAssemblerCodeRef *codeRef;
+    // The baseline code replaced by the optimizing JIT. Frames may still be executing it.
+    JSC::MacroAssemblerCodeRef *baselineCodeRef = nullptr;
     const QQmlPrivate::TypedFunction *typedFunction = nullptr;
 
     // first nArguments names in internalClass are the actual arguments
     Heap::InternalClass *internalClass;
     int interpreterCallCount = 0;
+    int jittedCallCount = 0;
+
+    // Number of executions through each execution path, reported by the profiler. A function may
+    // be interpreted a few times before it is JIT-compiled. AOT-compiled functions always run
+    // their compiled code.
+    quint32 interpretedExecutionCount = 0;
+    quint32 jittedExecutionCount = 0;
+    quint32 aotExecutionCount = 0;
+
     quint16 nFormals;
     enum Kind : quint8 { JsUntyped, JsTyped, AotCompiled, Eval };
     Kind kind = JsUntyped;
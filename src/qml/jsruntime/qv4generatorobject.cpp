@@ -75,6 +75,12 @@ ReturnedValue GeneratorFunction::virtualCall(const FunctionObject *f, const Valu
     for (int i = 0; i < argc; i++)
         gp->values->arrayData->setArrayData(engine, i, argv[i]);
 
+    // The frames below write to the array data directly, behind the back of the element kinds.
+    if (gp->values->arrayData)
+        gp->values->arrayData->elementKind = Heap::ArrayData::HoleyElements;
+    if (gp->jsFrame->arrayData)
+        gp->jsFrame->arrayData->elementKind = Heap::ArrayData::HoleyElements;
+
     gp->cppFrame.init(function, gp->values->arrayData->values.values, argc);
     gp->cppFrame.setupJSFrame(gp->jsFrame->arrayData->values.values, *gf, gf->scope(),
                               thisObject ? *thisObject : Value::undefinedValue(),
@@ -173,6 +173,7 @@ struct MarkStack;
 
 struct IdentifierTable;
 class RegExpCache;
+class MegamorphicLookupCache;
 class MultiplyWrappedQObjectMap;
 
 enum PropertyFlag {
@@ -263,6 +263,24 @@ PropertyKey IdentifierTable::asPropertyKey(const QString &s,
     return resolveStringEntry(s, hash, subtype)->identifier;
 }
 
+// Only creates a QString if the identifier doesn't exist yet.
+PropertyKey IdentifierTable::asPropertyKey(QStringView s)
+{
+    uint subtype;
+    uint hash = String::createHashValue(s.data(), int(s.size()), &subtype);
+    if (subtype == Heap::String::StringType_ArrayIndex)
+        return PropertyKey::fromArrayIndex(hash);
+
+    uint idx = hash % alloc;
+    while (Heap::StringOrSymbol *e = entriesByHash[idx]) {
+        if (e->stringHash == hash && e->toQString() == s)
+            return e->identifier;
+        ++idx;
+        idx %= alloc;
+    }
+    return resolveStringEntry(s.toString(), hash, subtype)->identifier;
+}
+
 PropertyKey IdentifierTable::asPropertyKey(const char *s, int len)
 {
     uint subtype;
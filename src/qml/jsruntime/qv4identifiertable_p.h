@@ -58,6 +58,7 @@ public:
     enum KeyConversionBehavior { Default, ForceConversionToId };
     PropertyKey asPropertyKey(const QString &s, KeyConversionBehavior conversionBehavior = Default);
     PropertyKey asPropertyKey(const char *s, int len);
+    PropertyKey asPropertyKey(QStringView s);
 
     PropertyKey asPropertyKeyImpl(const Heap::String *str);
 
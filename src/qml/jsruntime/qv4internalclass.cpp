@@ -92,7 +92,10 @@ void SharedInternalClassDataPrivate<PropertyKey>::grow()
 {
     const uint a = alloc() * 2;
     const uint s = size();
-    data = MemberData::allocate(engine, a, data);
+    Heap::MemberData *newData = MemberData::allocate(engine, a, data);
+    // data is shared between internal classes, the barrier in set() doesn't see this
+    WriteBarrier::replace(engine, data, newData);
+    data = newData;
     setSize(s);
     Q_ASSERT(alloc() >= a);
 }
@@ -122,7 +125,7 @@ PropertyKey SharedInternalClassDataPrivate<PropertyKey>::at(uint i) const
 void SharedInternalClassDataPrivate<PropertyKey>::set(uint i, PropertyKey t)
 {
     Q_ASSERT(data && i < size());
-    data->values.values[i].rawValueRef() = t.id();
+    data->values.set(engine, i, Value::fromReturnedValue(t.id()));
 }
 
 void SharedInternalClassDataPrivate<PropertyKey>::mark(MarkStack *s)
@@ -269,8 +272,7 @@ void InternalClass::destroy()
         }
     }
 
-    if (parent && parent->engine && parent->isMarked())
-        parent->removeChildEntry(this);
+    unlinkFromParent();
 
     propertyTable.~PropertyHash();
     nameMap.~SharedInternalClassData<PropertyKey>();
@@ -280,6 +282,16 @@ void InternalClass::destroy()
     Base::destroy();
 }
 
+// Called on dead classes during sweeping. A live parent must not hand them out as
+// transition targets anymore.
+void InternalClass::unlinkFromParent()
+{
+    if (parent && parent->engine && parent->isMarked()) {
+        parent->removeChildEntry(this);
+        parent = nullptr;
+    }
+}
+
 QString InternalClass::keyAt(uint index) const
 {
     return nameMap.at(index).toQString();
@@ -331,6 +331,7 @@ struct InternalClass : Base {
     void init(ExecutionEngine *engine);
     void init(InternalClass *other);
     void destroy();
+    void unlinkFromParent();
 
     Q_QML_PRIVATE_EXPORT QString keyAt(uint index) const;
     Q_REQUIRED_RESULT InternalClass *nonExtensible();
@@ -12,6 +12,7 @@
 #include "qv4jscall_p.h"
 #include <qv4symbol_p.h>
 
+#include <qiodevice.h>
 #include <qstack.h>
 #include <qstringlist.h>
 
@@ -36,6 +37,10 @@ DEFINE_OBJECT_VTABLE(JsonObject);
 
 static const int nestingLimit = 1024;
 
+// Objects and arrays are first collected on the JS stack. Beyond this many values they are
+// flushed into the object, to not exhaust the stack with huge arrays.
+static const int maxPendingValues = 1024;
+
 
 JsonParser::JsonParser(ExecutionEngine *engine, const QChar *json, int length)
     : engine(engine), head(json), json(json), nestingLevel(0), lastError(QJsonParseError::NoError)
@@ -177,12 +182,29 @@ ReturnedValue JsonParser::parseObject()
     BEGIN << "parseObject pos=" << json;
     Scope scope(engine);
 
-    ScopedObject o(scope, engine->newObject());
+    ScopedObject o(scope);
+
+    // Each member takes a key and a value slot. Nested values release their stack space
+    // before the next member is allocated, so the members end up next to each other.
+    Value *members = nullptr;
+    int memberCount = 0;
 
     QChar token = nextToken();
     while (token.unicode() == Quote) {
-        if (!parseMember(o))
+        Value *member = scope.alloc(2);
+        if (!members)
+            members = member;
+        Q_ASSERT(member == members + 2 * memberCount);
+        if (!parseMember(member))
             return Encode::undefined();
+        if (++memberCount == maxPendingValues / 2) {
+            if (!o)
+                o = engine->newObject();
+            addMembers(o, members, memberCount);
+            engine->jsStackTop = members;
+            members = nullptr;
+            memberCount = 0;
+        }
         token = nextToken();
         if (token.unicode() != ValueSeparator)
             break;
@@ -199,41 +221,60 @@ ReturnedValue JsonParser::parseObject()
         return Encode::undefined();
     }
 
+    if (!o) {
+        // Create the object with its final internal class right away, so that its member data
+        // gets allocated once. Objects of the same shape share the transitions.
+        Scoped<InternalClass> ic(scope, engine->classes[EngineBase::Class_Object]);
+        InternalClassEntry entry;
+        for (int i = 0; i < memberCount; ++i) {
+            const PropertyKey key = *reinterpret_cast<const PropertyKey *>(members + 2 * i);
+            if (!key.isArrayIndex())
+                ic = ic->d()->addMember(key, Attr_Data, &entry);
+        }
+        o = engine->newObject(ic->d());
+    }
+    addMembers(o, members, memberCount);
+
     END;
 
     --nestingLevel;
     return o.asReturnedValue();
 }
 
+void JsonParser::addMembers(Object *o, const Value *members, int memberCount)
+{
+    for (int i = 0; i < memberCount; ++i) {
+        const PropertyKey key = *reinterpret_cast<const PropertyKey *>(members + 2 * i);
+        const Value &value = members[2 * i + 1];
+        if (key.isArrayIndex()) {
+            o->put(key.asArrayIndex(), value);
+        } else {
+            // avoid trouble with properties named __proto__. Also takes care of duplicate keys.
+            InternalClassEntry entry;
+            Heap::InternalClass::addMember(o, key, Attr_Data, &entry);
+            o->setProperty(entry.index, value);
+        }
+    }
+}
+
 /*
     member = string name-separator value
 */
-bool JsonParser::parseMember(Object *o)
+bool JsonParser::parseMember(Value *member)
 {
     BEGIN << "parseMember";
-    Scope scope(engine);
 
-    QString key;
-    if (!parseString(&key))
+    PropertyKey *key = reinterpret_cast<PropertyKey *>(member);
+    if (!parseKey(key))
         return false;
     QChar token = nextToken();
     if (token.unicode() != NameSeparator) {
         lastError = QJsonParseError::MissingNameSeparator;
         return false;
     }
-    ScopedValue val(scope);
-    if (!parseValue(val))
+    if (!parseValue(member + 1))
         return false;
 
-    ScopedString s(scope, engine->newString(key));
-    PropertyKey skey = s->toPropertyKey();
-    if (skey.isArrayIndex()) {
-        o->put(skey.asArrayIndex(), val);
-    } else {
-        // avoid trouble with properties named __proto__
-        o->insertMember(s, val);
-    }
-
     END;
     return true;
 }
@@ -259,13 +300,27 @@ ReturnedValue JsonParser::parseArray()
     if (json->unicode() == EndArray) {
         nextToken();
     } else {
+        // Same as for objects, values are collected next to each other on the JS stack.
+        Value *values = nullptr;
+        int valueCount = 0;
         uint index = 0;
         while (1) {
-            ScopedValue val(scope);
+            Value *val = scope.alloc(1);
+            if (!values)
+                values = val;
+            Q_ASSERT(val == values + valueCount);
             if (!parseValue(val))
                 return Encode::undefined();
-            array->arraySet(index, val);
+            ++valueCount;
             QChar token = nextToken();
+            if (valueCount == maxPendingValues || token.unicode() != ValueSeparator) {
+                array->arrayReserve(index + 1);
+                array->arrayPut(index + 1 - valueCount, values, valueCount);
+                array->setArrayLengthUnchecked(index + 1);
+                engine->jsStackTop = values;
+                values = nullptr;
+                valueCount = 0;
+            }
             if (token.unicode() == EndArray)
                 break;
             else if (token.unicode() != ValueSeparator) {
@@ -436,14 +491,17 @@ bool JsonParser::parseNumber(Value *val)
             ++json;
     }
 
-    QString number(start, json - start);
+    const QStringView number(start, json - start);
     DEBUG << "numberstring" << number;
 
-    if (isInt) {
-        bool ok;
-        int n = number.toInt(&ok);
-        if (ok && n < (1<<25) && n > -(1<<25)) {
-            *val = Value::fromInt32(n);
+    if (isInt && number.size() <= 9) {
+        // Short integers, which is most numbers in practice, don't need the generic conversion.
+        const bool negative = number.startsWith(u'-');
+        int n = 0;
+        for (QChar digit : number.sliced(negative ? 1 : 0))
+            n = n * 10 + (digit.unicode() - u'0');
+        if (number.size() > (negative ? 1 : 0) && n < (1<<25)) {
+            *val = Value::fromInt32(negative ? -n : n);
             END;
             return true;
         }
@@ -544,10 +602,45 @@ static inline bool scanEscapeSequence(const QChar *&json, const QChar *end, uint
 }
 
 
+static inline const QChar *scanUnescaped(const QChar *json, const QChar *end)
+{
+    while (json < end && *json != u'"' && *json != u'\\' && json->unicode() > 0x1f)
+        ++json;
+    return json;
+}
+
+bool JsonParser::parseKey(PropertyKey *key)
+{
+    // Most keys don't contain any escape sequences. Look those up without creating a string.
+    const QChar *start = json;
+    const QChar *stop = scanUnescaped(json, end);
+    if (stop < end && *stop == u'"') {
+        json = stop + 1;
+        *key = engine->identifierTable->asPropertyKey(QStringView(start, stop - start));
+        return true;
+    }
+
+    QString string;
+    if (!parseString(&string))
+        return false;
+    *key = engine->identifierTable->asPropertyKey(string);
+    return true;
+}
+
 bool JsonParser::parseString(QString *string)
 {
     BEGIN << "parse string stringPos=" << json;
 
+    const QChar *start = json;
+    json = scanUnescaped(json, end);
+    if (json < end && *json == u'"') {
+        *string = QString(start, json - start);
+        ++json;
+        END;
+        return true;
+    }
+    string->append(start, json - start);
+
     while (json < end) {
         if (*json == u'"')
             break;
@@ -582,6 +675,133 @@ bool JsonParser::parseString(QString *string)
     return true;
 }
 
+void JsonStreamParser::addData(QByteArrayView utf8)
+{
+    Q_ASSERT(!ended);
+
+    // Decode straight into the text buffer. The decoder keeps multi-byte sequences that are
+    // split between two chunks in its state.
+    const qsizetype size = text.size();
+    text.resize(size + decoder.requiredSpace(utf8.size()));
+    const QChar *decodedEnd = decoder.appendToBuffer(text.data() + size, utf8);
+    text.truncate(decodedEnd - text.constData());
+    scan();
+}
+
+void JsonStreamParser::endOfData()
+{
+    ended = true;
+    scan();
+}
+
+void JsonStreamParser::scan()
+{
+    // Only finds where the current value ends. Checking its syntax is left to JsonParser.
+    const int size = int(text.size());
+    const QChar *data = text.constData();
+    while (valueEnd < 0 && scanPosition < size) {
+        const char16_t c = data[scanPosition].unicode();
+        if (valueStart < 0) {
+            if (c == Space || c == Tab || c == LineFeed || c == Return) {
+                ++scanPosition;
+                continue;
+            }
+            valueStart = scanPosition;
+            if (c == BeginArray || c == BeginObject)
+                depth = 1;
+            else if (c == Quote)
+                inString = true;
+            else
+                isScalar = true;
+        } else if (inString) {
+            if (inEscape) {
+                inEscape = false;
+            } else if (c == u'\\') {
+                inEscape = true;
+            } else if (c == Quote) {
+                inString = false;
+                if (depth == 0)
+                    valueEnd = scanPosition + 1;
+            }
+        } else if (isScalar) {
+            // Numbers and literals end where something else starts.
+            if (c == Space || c == Tab || c == LineFeed || c == Return || c == BeginArray
+                    || c == BeginObject || c == EndArray || c == EndObject || c == Quote
+                    || c == ValueSeparator) {
+                valueEnd = scanPosition;
+                break;
+            }
+        } else if (c == Quote) {
+            inString = true;
+        } else if (c == BeginArray || c == BeginObject) {
+            ++depth;
+        } else if ((c == EndArray || c == EndObject) && --depth == 0) {
+            valueEnd = scanPosition + 1;
+        }
+        ++scanPosition;
+    }
+
+    // Whatever has been started is all there is. Incomplete values produce a parse error.
+    if (ended && valueEnd < 0 && valueStart >= 0)
+        valueEnd = size;
+}
+
+void JsonStreamParser::resetScan()
+{
+    scanPosition = 0;
+    valueStart = -1;
+    valueEnd = -1;
+    depth = 0;
+    inString = false;
+    inEscape = false;
+    isScalar = false;
+}
+
+ReturnedValue JsonStreamParser::parseNext(QJsonParseError *error)
+{
+    if (decoder.hasError()) {
+        error->offset = int(consumed);
+        error->error = QJsonParseError::IllegalUTF8String;
+        return Encode::undefined();
+    }
+
+    if (!hasValue()) {
+        error->offset = 0;
+        error->error = QJsonParseError::NoError;
+        return Encode::undefined();
+    }
+
+    JsonParser parser(engine, text.constData() + valueStart, valueEnd - valueStart);
+    Scope scope(engine);
+    ScopedValue value(scope, parser.parse(error));
+    if (error->error != QJsonParseError::NoError)
+        error->offset += int(consumed + valueStart);
+
+    // Drop the text of the value, and look for the next one in what is left.
+    consumed += valueEnd;
+    text.remove(0, valueEnd);
+    resetScan();
+    scan();
+    return value->asReturnedValue();
+}
+
+ReturnedValue JsonStreamParser::readNext(QIODevice *device, QJsonParseError *error,
+                                         qint64 maximumChunkSize)
+{
+    // Sequential devices may receive more data later. The caller has to call endOfData() once
+    // they are closed. Any other device ends when no more data can be read from it.
+    chunk.resize(maximumChunkSize);
+    while (!hasValue() && !ended) {
+        const qint64 read = device->read(chunk.data(), maximumChunkSize);
+        if (read > 0)
+            addData(QByteArrayView(chunk.constData(), read));
+        else if (read < 0 || !device->isSequential())
+            endOfData();
+        else
+            break;
+    }
+    return parseNext(error);
+}
 
 struct Stringify
 {
@@ -589,9 +809,13 @@ struct Stringify
     FunctionObject *replacerFunction;
     QV4::String *propertyList;
     int propertyListSize;
+    QV4::String *toJSONName;
     QString gap;
     QString indent;
     QStack<Object *> stack;
+    // All the output is appended to this, instead of concatenating the results for the
+    // members of each object.
+    QString result;
 
     bool stackContains(Object *o) {
         for (int i = 0; i < stack.size(); ++i)
@@ -600,13 +824,14 @@ struct Stringify
         return false;
     }
 
-    Stringify(ExecutionEngine *e) : v4(e), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0) {}
+    Stringify(ExecutionEngine *e) : v4(e), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0), toJSONName(nullptr) {}
 
-    QString Str(const QString &key, const Value &v);
-    QString JA(Object *a);
-    QString JO(Object *o);
+    bool Str(const Value &key, const Value &v);
+    void JA(Object *a);
+    void JO(Object *o);
 
-    QString makeMember(const QString &key, const Value &v);
+    bool makeMember(const Value &key, const Value &v, bool first);
+    void newLine(const QString &indentation);
 };
 
 class [[nodiscard]] CallDepthAndCycleChecker
@@ -631,14 +856,18 @@ private:
     ExecutionEngineCallDepthRecorder<1> m_callDepthRecorder;
 };
 
-static QString quote(const QString &str)
+static void quote(QString &product, QStringView str)
 {
-    QString product;
-    const int length = str.size();
-    product.reserve(length + 2);
     product += u'"';
-    for (int i = 0; i < length; ++i) {
-        QChar c = str.at(i);
+    qsizetype unescaped = 0;
+    const qsizetype length = str.size();
+    for (qsizetype i = 0; i < length; ++i) {
+        const QChar c = str.at(i);
+        if (c.unicode() > 0x1f && c != u'"' && c != u'\\')
+            continue;
+
+        product.append(str.sliced(unescaped, i - unescaped));
+        unescaped = i + 1;
         switch (c.unicode()) {
         case u'"':
             product += QLatin1String("\\\"");
@@ -662,41 +891,36 @@ static QString quote(const QString &str)
             product += QLatin1String("\\t");
             break;
         default:
-            if (c.unicode() <= 0x1f) {
-                product += QLatin1String("\\u00");
-                product += (c.unicode() > 0xf ? u'1' : u'0') +
-                        QLatin1Char("0123456789abcdef"[c.unicode() & 0xf]);
-            } else {
-                product += c;
-            }
+            product += QLatin1String("\\u00");
+            product += (c.unicode() > 0xf ? u'1' : u'0');
+            product += QLatin1Char("0123456789abcdef"[c.unicode() & 0xf]);
         }
     }
+    product.append(str.sliced(unescaped));
     product += u'"';
-    return product;
 }
 
-QString Stringify::Str(const QString &key, const Value &v)
+bool Stringify::Str(const Value &key, const Value &v)
 {
     Scope scope(v4);
 
     ScopedValue value(scope, v);
     ScopedObject o(scope, value);
     if (o) {
-        ScopedString s(scope, v4->newString(QStringLiteral("toJSON")));
-        ScopedFunctionObject toJSON(scope, o->get(s));
+        ScopedFunctionObject toJSON(scope, o->get(toJSONName));
         if (!!toJSON) {
             JSCallArguments jsCallData(scope, 1);
             *jsCallData.thisObject = value;
-            jsCallData.args[0] = v4->newString(key);
+            jsCallData.args[0] = key.toString(v4);
             value = toJSON->call(jsCallData);
             if (v4->hasException)
-                return QString();
+                return false;
         }
     }
 
     if (replacerFunction) {
         JSCallArguments jsCallData(scope, 2);
-        jsCallData.args[0] = v4->newString(key);
+        jsCallData.args[0] = key.toString(v4);
         jsCallData.args[1] = value;
 
         if (stack.isEmpty()) {
@@ -709,7 +933,7 @@ QString Stringify::Str(const QString &key, const Value &v)
 
         value = replacerFunction->call(jsCallData);
         if (v4->hasException)
-            return QString();
+            return false;
     }
 
     o = value->asReturnedValue();
@@ -722,63 +946,87 @@ QString Stringify::Str(const QString &key, const Value &v)
             value = Encode(b->value());
     }
 
-    if (value->isNull())
-        return QStringLiteral("null");
-    if (value->isBoolean())
-        return value->booleanValue() ? QStringLiteral("true") : QStringLiteral("false");
-    if (value->isString())
-        return quote(value->stringValue()->toQString());
+    if (value->isNull()) {
+        result += QLatin1String("null");
+        return true;
+    }
+    if (value->isBoolean()) {
+        result += value->booleanValue() ? QLatin1String("true") : QLatin1String("false");
+        return true;
+    }
+    if (value->isString()) {
+        quote(result, value->stringValue()->toQString());
+        return true;
+    }
 
     if (value->isNumber()) {
         double d = value->toNumber();
-        return std::isfinite(d) ? value->toQString() : QStringLiteral("null");
+        if (std::isfinite(d))
+            result += value->toQString();
+        else
+            result += QLatin1String("null");
+        return true;
     }
 
     if (const QV4::VariantObject *v = value->as<QV4::VariantObject>()) {
-        return quote(v->d()->data().toString());
+        quote(result, v->d()->data().toString());
+        return true;
     }
 
     o = value->asReturnedValue();
     if (o) {
         if (!o->as<FunctionObject>()) {
             if (o->isArrayLike()) {
-                return JA(o.getPointer());
+                JA(o.getPointer());
             } else {
-                return JO(o);
+                JO(o);
             }
+            return true;
         }
     }
 
-    return QString();
+    return false;
 }
 
-QString Stringify::makeMember(const QString &key, const Value &v)
+void Stringify::newLine(const QString &indentation)
 {
-    QString strP = Str(key, v);
-    if (!strP.isEmpty()) {
-        QString member = quote(key) + u':';
-        if (!gap.isEmpty())
-            member += u' ';
-        member += strP;
-        return member;
-    }
-    return QString();
+    if (gap.isEmpty())
+        return;
+    result += u'\n';
+    result += indentation;
+}
+
+bool Stringify::makeMember(const Value &key, const Value &v, bool first)
+{
+    // Members that turn out to be undefined are dropped again.
+    const qsizetype rollback = result.size();
+    if (!first)
+        result += u',';
+    newLine(indent);
+    quote(result, key.toQString());
+    result += u':';
+    if (!gap.isEmpty())
+        result += u' ';
+    if (Str(key, v))
+        return true;
+    result.truncate(rollback);
+    return false;
 }
 
-QString Stringify::JO(Object *o)
+void Stringify::JO(Object *o)
 {
     CallDepthAndCycleChecker check(this, o);
     if (check.foundProblem())
-        return QString();
+        return;
 
     Scope scope(v4);
 
-    QString result;
     stack.push(o);
     QString stepback = indent;
     indent += gap;
 
-    QStringList partial;
+    result += u'{';
+    bool empty = true;
     if (!propertyListSize) {
         ObjectIterator it(scope, o, ObjectIterator::EnumerableOnly);
         ScopedValue name(scope);
@@ -788,10 +1036,8 @@ QString Stringify::JO(Object *o)
             name = it.nextPropertyNameAsString(val);
             if (name->isNull())
                 break;
-            QString key = name->toQString();
-            QString member = makeMember(key, val);
-            if (!member.isEmpty())
-                partial += member;
+            if (makeMember(name, val, empty))
+                empty = false;
         }
     } else {
         ScopedValue v(scope);
@@ -803,69 +1049,52 @@ QString Stringify::JO(Object *o)
             v = o->get(s, &exists);
             if (!exists)
                 continue;
-            QString member = makeMember(s->toQString(), v);
-            if (!member.isEmpty())
-                partial += member;
+            if (makeMember(*s, v, empty))
+                empty = false;
         }
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("{}");
-    } else if (gap.isEmpty()) {
-        result = u'{' + partial.join(u',') + u'}';
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("{\n") + indent + partial.join(separator) + u'\n'
-                 + stepback + u'}';
-    }
+    if (!empty)
+        newLine(stepback);
+    result += u'}';
 
     indent = stepback;
     stack.pop();
-    return result;
 }
 
-QString Stringify::JA(Object *a)
+void Stringify::JA(Object *a)
 {
     CallDepthAndCycleChecker check(this, a);
     if (check.foundProblem())
-        return QString();
+        return;
 
     Scope scope(a->engine());
 
-    QString result;
     stack.push(a);
     QString stepback = indent;
     indent += gap;
 
-    QStringList partial;
+    result += u'[';
     uint len = a->getLength();
     ScopedValue v(scope);
+    ScopedValue key(scope);
     for (uint i = 0; i < len; ++i) {
+        if (i)
+            result += u',';
+        newLine(indent);
         bool exists;
         v = a->get(i, &exists);
-        if (!exists) {
-            partial += QStringLiteral("null");
-            continue;
-        }
-        QString strP = Str(QString::number(i), v);
-        if (!strP.isEmpty())
-            partial += strP;
-        else
-            partial += QStringLiteral("null");
+        key = Encode(i);
+        if (!exists || !Str(key, v))
+            result += QLatin1String("null");
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("[]");
-    } else if (gap.isEmpty()) {
-        result = u'[' + partial.join(u',') + u']';
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("[\n") + indent + partial.join(separator) + u'\n' + stepback + u']';
-    }
+    if (len)
+        newLine(stepback);
+    result += u']';
 
     indent = stepback;
     stack.pop();
-    return result;
 }
 
 
@@ -945,11 +1174,13 @@ ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value
     }
 
 
+    ScopedString toJSONName(scope, scope.engine->newIdentifier(QStringLiteral("toJSON")));
+    stringify.toJSONName = toJSONName;
+
     ScopedValue arg0(scope, argc ? argv[0] : Value::undefinedValue());
-    QString result = stringify.Str(QString(), arg0);
-    if (result.isEmpty() || scope.hasException())
+    if (!stringify.Str(*scope.engine->id_empty(), arg0) || scope.hasException())
         RETURN_UNDEFINED();
-    return Encode(scope.engine->newString(result));
+    return Encode(scope.engine->newString(stringify.result));
 }
 
 
@@ -20,9 +20,12 @@
 #include <qjsonvalue.h>
 #include <qjsondocument.h>
 #include <qhash.h>
+#include <qstringconverter.h>
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+
 namespace QV4 {
 
 namespace Heap {
@@ -86,11 +89,14 @@ private:
 
     ReturnedValue parseObject();
     ReturnedValue parseArray();
-    bool parseMember(Object *o);
+    bool parseMember(Value *member);
     bool parseString(QString *string);
+    bool parseKey(PropertyKey *key);
     bool parseValue(Value *val);
     bool parseNumber(Value *val);
 
+    void addMembers(Object *o, const Value *members, int memberCount);
+
     ExecutionEngine *engine;
     const QChar *head;
     const QChar *json;
@@ -100,6 +106,45 @@ private:
     QJsonParseError::ParseError lastError;
 };
 
+// Parses a stream of concatenated or newline delimited JSON values that arrives in chunks. Each
+// top-level value is parsed as soon as it is complete, and its text is dropped afterwards, so
+// only the value currently being received is held in memory.
+class Q_QML_PRIVATE_EXPORT JsonStreamParser
+{
+public:
+    explicit JsonStreamParser(ExecutionEngine *engine) : engine(engine) {}
+
+    void addData(QByteArrayView utf8);
+    void endOfData();
+
+    bool hasValue() const { return valueEnd >= 0; }
+    bool atEnd() const { return ended && valueStart < 0 && scanPosition == text.size(); }
+
+    ReturnedValue parseNext(QJsonParseError *error);
+    ReturnedValue readNext(QIODevice *device, QJsonParseError *error,
+                           qint64 maximumChunkSize = 16 * 1024);
+
+private:
+    void scan();
+    void resetScan();
+
+    ExecutionEngine *engine;
+    QStringDecoder decoder = QStringDecoder(QStringDecoder::Utf8);
+    QString text;
+    QByteArray chunk;
+    qint64 consumed = 0;
+
+    // State of the scan for the end of the current top-level value
+    int scanPosition = 0;
+    int valueStart = -1;
+    int valueEnd = -1;
+    int depth = 0;
+    bool inString = false;
+    bool inEscape = false;
+    bool isScalar = false;
+    bool ended = false;
+};
+
 }
 
 QT_END_NAMESPACE
@@ -5,11 +5,62 @@
 #include <private/qv4identifiertable_p.h>
 #include <QtQml/private/qv4runtime_p.h>
 #include <QtQml/private/qv4qobjectwrapper_p.h>
+#include <QtCore/qloggingcategory.h>
 
 QT_BEGIN_NAMESPACE
 
+Q_LOGGING_CATEGORY(lcLookupStats, "qt.qml.lookup.statistics")
+
 using namespace QV4;
 
+LookupCacheEntry LookupCacheEntry::fromLookup(const Lookup &l, Heap::InternalClass *ic)
+{
+    LookupCacheEntry entry;
+    memset(&entry, 0, sizeof(LookupCacheEntry));
+    if (l.getter == Lookup::getter0Inline || l.getter == Lookup::getter0MemberData) {
+        entry.kind = (l.getter == Lookup::getter0Inline) ? InlineProperty : MemberDataProperty;
+        entry.ic = l.objectLookup.ic;
+        entry.offset = l.objectLookup.offset;
+    } else if (l.getter == Lookup::getterProto) {
+        entry.kind = ProtoProperty;
+        entry.ic = ic;
+        entry.protoId = l.protoLookup.protoId;
+        entry.data = l.protoLookup.data;
+    }
+    return entry;
+}
+
+void MegamorphicLookupCache::insert(PropertyKey name, const LookupCacheEntry &entry)
+{
+    if (!entries)
+        entries.reset(new Entry[Size]());
+
+    Entry &e = entries[index(entry.ic, name)];
+    e.name = name.id();
+    e.entry = entry;
+}
+
+void MegamorphicLookupCache::clear()
+{
+    if (entries)
+        memset(entries.get(), 0, Size * sizeof(Entry));
+}
+
+void MegamorphicLookupCache::dumpStatistics() const
+{
+    const QLoggingCategory &stats = lcLookupStats();
+    if (!stats.isDebugEnabled())
+        return;
+
+    qDebug(stats) << "Qml lookup cache statistics:";
+    qDebug(stats) << "Polymorphic lookups:" << statistics.polymorphicLookups
+                  << "hits:" << statistics.polymorphicHits
+                  << "misses:" << statistics.polymorphicMisses;
+    qDebug(stats) << "Megamorphic lookups:" << statistics.megamorphicLookups
+                  << "hits:" << statistics.megamorphicHits
+                  << "misses:" << statistics.megamorphicMisses;
+}
+
 
 void Lookup::resolveProtoGetter(PropertyKey name, const Heap::Object *proto)
 {
@@ -140,6 +191,89 @@ static inline void setupProtoLookupTwoClasses(Lookup *l, const Lookup &first, co
     l->protoLookupTwoClasses.data2 = data2;
 }
 
+static LookupCacheEntry ownPropertyEntry(
+        LookupCacheEntry::Kind kind, Heap::InternalClass *ic, uint offset)
+{
+    LookupCacheEntry entry;
+    memset(&entry, 0, sizeof(LookupCacheEntry));
+    entry.kind = kind;
+    entry.ic = ic;
+    entry.offset = offset;
+    return entry;
+}
+
+static LookupCacheEntry protoPropertyEntry(quintptr protoId, const Value *data)
+{
+    LookupCacheEntry entry;
+    memset(&entry, 0, sizeof(LookupCacheEntry));
+    entry.kind = LookupCacheEntry::ProtoProperty;
+    entry.protoId = protoId;
+    entry.data = data;
+    return entry;
+}
+
+static void setupPolymorphicLookup(
+        Lookup *l, ExecutionEngine *engine,
+        const LookupCacheEntry &first, const LookupCacheEntry &second)
+{
+    PolymorphicLookupCache *cache = new PolymorphicLookupCache;
+    cache->insert(first);
+    cache->insert(second);
+    l->setPolymorphicCache(cache);
+    ++engine->megamorphicLookupCache->statistics.polymorphicLookups;
+}
+
+static ReturnedValue setupPolymorphicLookupFromTwoClasses(
+        Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    if (l->getter == Lookup::getterProtoTwoClasses) {
+        setupPolymorphicLookup(
+                    l, engine,
+                    protoPropertyEntry(l->protoLookupTwoClasses.protoId,
+                                       l->protoLookupTwoClasses.data),
+                    protoPropertyEntry(l->protoLookupTwoClasses.protoId2,
+                                       l->protoLookupTwoClasses.data2));
+    } else {
+        const LookupCacheEntry::Kind kind1 = (l->getter == Lookup::getter0MemberDatagetter0MemberData)
+                ? LookupCacheEntry::MemberDataProperty
+                : LookupCacheEntry::InlineProperty;
+        const LookupCacheEntry::Kind kind2 = (l->getter == Lookup::getter0Inlinegetter0Inline)
+                ? LookupCacheEntry::InlineProperty
+                : LookupCacheEntry::MemberDataProperty;
+        setupPolymorphicLookup(
+                    l, engine,
+                    ownPropertyEntry(kind1, l->objectLookupTwoClasses.ic,
+                                     l->objectLookupTwoClasses.offset),
+                    ownPropertyEntry(kind2, l->objectLookupTwoClasses.ic2,
+                                     l->objectLookupTwoClasses.offset2));
+    }
+    return Lookup::getterPolymorphic(l, engine, object);
+}
+
+// Resolves the property on a fresh lookup, and returns the part of the result we can cache.
+static ReturnedValue resolveCacheEntry(
+        Lookup *l, ExecutionEngine *engine, const Object *o, LookupCacheEntry *entry)
+{
+    Heap::InternalClass *ic = o->internalClass();
+
+    Lookup resolved;
+    memset(&resolved, 0, sizeof(Lookup));
+    resolved.nameIndex = l->nameIndex;
+    resolved.forCall = l->forCall;
+    resolved.getter = Lookup::getterGeneric;
+    const ReturnedValue result = resolved.resolveGetter(engine, o);
+
+    *entry = LookupCacheEntry::fromLookup(resolved, ic);
+    resolved.releasePropertyCache();
+    return result;
+}
+
+static PropertyKey lookupName(const Lookup *l, ExecutionEngine *engine)
+{
+    return engine->identifierTable->asPropertyKey(
+                engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+}
+
 ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     if (const Object *o = object.as<Object>()) {
@@ -183,6 +317,13 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
             return result;
         }
 
+        const LookupCacheEntry first = LookupCacheEntry::fromLookup(*l, nullptr);
+        const LookupCacheEntry next = LookupCacheEntry::fromLookup(second, nullptr);
+        if (first.kind != LookupCacheEntry::Empty && next.kind != LookupCacheEntry::Empty) {
+            setupPolymorphicLookup(l, engine, first, next);
+            return result;
+        }
+
         // If any of the above options were true, the propertyCache was inactive.
         second.releasePropertyCache();
     }
@@ -251,8 +392,7 @@ ReturnedValue Lookup::getter0Inlinegetter0Inline(Lookup *l, ExecutionEngine *eng
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset2)->asReturnedValue();
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return setupPolymorphicLookupFromTwoClasses(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -266,8 +406,7 @@ ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return setupPolymorphicLookupFromTwoClasses(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -281,8 +420,7 @@ ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEng
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return setupPolymorphicLookupFromTwoClasses(l, engine, object);
 }
 
 ReturnedValue Lookup::getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -298,10 +436,66 @@ ReturnedValue Lookup::getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine,
             return l->protoLookupTwoClasses.data->asReturnedValue();
         if (l->protoLookupTwoClasses.protoId2 == o->internalClass->protoId)
             return l->protoLookupTwoClasses.data2->asReturnedValue();
+    }
+    return setupPolymorphicLookupFromTwoClasses(l, engine, object);
+}
+
+ReturnedValue Lookup::getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    MegamorphicLookupCache *shared = engine->megamorphicLookupCache;
+
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        if (const Value *v = l->polymorphicCache()->lookup(o)) {
+            ++shared->statistics.polymorphicHits;
+            return v->asReturnedValue();
+        }
+    }
+
+    const Object *obj = object.as<Object>();
+    if (!obj)
         return getterFallback(l, engine, object);
+
+    ++shared->statistics.polymorphicMisses;
+    LookupCacheEntry entry;
+    const ReturnedValue result = resolveCacheEntry(l, engine, obj, &entry);
+
+    // Resolving may have run JavaScript that changed the lookup under our feet.
+    if (entry.kind == LookupCacheEntry::Empty || l->getter != getterPolymorphic
+            || l->polymorphicCache()->insert(entry)) {
+        return result;
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+
+    // Too many shapes for this call site. Share the engine-wide cache with the others.
+    l->releasePropertyCache();
+    l->clear();
+    l->getter = getterMegamorphic;
+    ++shared->statistics.megamorphicLookups;
+    shared->insert(lookupName(l, engine), entry);
+    return result;
+}
+
+ReturnedValue Lookup::getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    const Object *o = object.as<Object>();
+    if (!o)
+        return getterFallback(l, engine, object);
+
+    MegamorphicLookupCache *shared = engine->megamorphicLookupCache;
+    const PropertyKey name = lookupName(l, engine);
+    if (const Value *v = shared->lookup(o->d(), name)) {
+        ++shared->statistics.megamorphicHits;
+        return v->asReturnedValue();
+    }
+
+    ++shared->statistics.megamorphicMisses;
+    LookupCacheEntry entry;
+    const ReturnedValue result = resolveCacheEntry(l, engine, o, &entry);
+    if (entry.kind != LookupCacheEntry::Empty)
+        shared->insert(name, entry);
+    return result;
 }
 
 ReturnedValue Lookup::getterAccessor(Lookup *l, ExecutionEngine *engine, const Value &object)
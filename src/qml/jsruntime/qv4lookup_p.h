@@ -28,6 +28,127 @@ namespace Heap {
     struct QObjectMethod;
 }
 
+// A cached plain data property, as used by the polymorphic and megamorphic lookups.
+struct LookupCacheEntry
+{
+    enum Kind : quint32 {
+        Empty,
+        InlineProperty,
+        MemberDataProperty,
+        ProtoProperty
+    };
+
+    static LookupCacheEntry fromLookup(const Lookup &l, Heap::InternalClass *ic);
+
+    const Value *lookup(const Heap::Object *o) const
+    {
+        switch (kind) {
+        case InlineProperty:
+            return ic == o->internalClass ? o->inlinePropertyDataWithOffset(offset) : nullptr;
+        case MemberDataProperty:
+            return ic == o->internalClass ? o->memberData->values.data() + offset : nullptr;
+        case ProtoProperty:
+            return protoId == o->internalClass->protoId ? data : nullptr;
+        case Empty:
+            break;
+        }
+        return nullptr;
+    }
+
+    Heap::InternalClass *ic;
+    quintptr protoId;
+    const Value *data;
+    uint offset;
+    Kind kind;
+};
+
+// The shapes seen by a single call site, once there are more than two of them.
+struct PolymorphicLookupCache
+{
+    enum { Size = 4 };
+
+    const Value *lookup(const Heap::Object *o) const
+    {
+        for (uint i = 0; i < count; ++i) {
+            if (const Value *v = entries[i].lookup(o))
+                return v;
+        }
+        return nullptr;
+    }
+
+    bool insert(const LookupCacheEntry &entry)
+    {
+        if (count == Size)
+            return false;
+        entries[count++] = entry;
+        return true;
+    }
+
+    void markObjects(MarkStack *stack)
+    {
+        for (uint i = 0; i < count; ++i) {
+            if (entries[i].kind != LookupCacheEntry::ProtoProperty)
+                entries[i].ic->mark(stack);
+        }
+    }
+
+    LookupCacheEntry entries[Size];
+    uint count = 0;
+};
+
+// Shared by all call sites that have seen too many shapes for a polymorphic cache. The
+// entries are keyed on internal class and property key. They don't keep the internal
+// classes alive, so the cache is cleared whenever the garbage collector sweeps.
+class Q_QML_PRIVATE_EXPORT MegamorphicLookupCache
+{
+    Q_DISABLE_COPY_MOVE(MegamorphicLookupCache)
+public:
+    enum { Size = 1024 };
+
+    struct Statistics
+    {
+        quint64 polymorphicHits = 0;
+        quint64 polymorphicMisses = 0;
+        quint64 megamorphicHits = 0;
+        quint64 megamorphicMisses = 0;
+        quint64 polymorphicLookups = 0;
+        quint64 megamorphicLookups = 0;
+    };
+
+    MegamorphicLookupCache() = default;
+
+    const Value *lookup(const Heap::Object *o, PropertyKey name) const
+    {
+        if (!entries)
+            return nullptr;
+        const Entry &e = entries[index(o->internalClass, name)];
+        if (e.name != name.id() || e.entry.ic != o->internalClass)
+            return nullptr;
+        return e.entry.lookup(o);
+    }
+
+    void insert(PropertyKey name, const LookupCacheEntry &entry);
+    void clear();
+    void dumpStatistics() const;
+
+    Statistics statistics;
+
+private:
+    struct Entry
+    {
+        quint64 name;
+        LookupCacheEntry entry;
+    };
+
+    static uint index(const Heap::InternalClass *ic, PropertyKey name)
+    {
+        const quint64 key = quint64(quintptr(ic) >> 4) ^ (name.id() >> 3) ^ (name.id() >> 13);
+        return uint(key) & (Size - 1);
+    }
+
+    std::unique_ptr<Entry[]> entries;
+};
+
 // Note: We cannot hide the copy ctor and assignment operator of this class because it needs to
 //       be trivially copyable. But you should never ever copy it. There are refcounted members
 //       in there.
@@ -77,6 +198,10 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             const Value *data;
             quintptr type;
         } primitiveLookup;
+        struct {
+            quintptr cache; // a (PolymorphicLookupCache * | 1), see markObjects
+            quintptr unused;
+        } polymorphicLookup;
         struct {
             Heap::InternalClass *newClass;
             quintptr protoId;
@@ -172,6 +297,8 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
     static ReturnedValue getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoAccessorTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -203,6 +330,20 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             markDef.h1->mark(stack);
         if (markDef.h2 && !(reinterpret_cast<quintptr>(markDef.h2) & 1))
             markDef.h2->mark(stack);
+        if (getter == getterPolymorphic)
+            polymorphicCache()->markObjects(stack);
+    }
+
+    PolymorphicLookupCache *polymorphicCache() const
+    {
+        return reinterpret_cast<PolymorphicLookupCache *>(polymorphicLookup.cache & ~quintptr(1));
+    }
+
+    void setPolymorphicCache(PolymorphicLookupCache *cache)
+    {
+        polymorphicLookup.cache = quintptr(cache) | 1;
+        polymorphicLookup.unused = 0;
+        getter = getterPolymorphic;
     }
 
     void clear() {
@@ -224,6 +365,9 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
                    || qmlContextPropertyGetter == QQmlContextWrapper::lookupContextObjectMethod) {
             if (const QQmlPropertyCache *pc = qobjectMethodLookup.propertyCache)
                 pc->release();
+        } else if (getter == getterPolymorphic) {
+            // Not a property cache, but owned by the lookup all the same.
+            delete polymorphicCache();
         }
     }
 };
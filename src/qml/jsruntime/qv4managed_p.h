@@ -79,7 +79,8 @@ struct Q_QML_PRIVATE_EXPORT Managed : Value, VTableBase
         IsObject = false,
         IsFunctionObject = false,
         IsErrorObject = false,
-        IsArrayData = false
+        IsArrayData = false,
+        MarksOnEngineThread = false // markObjects() can't run on a GC worker thread
     };
 private:
     void *operator new(size_t);
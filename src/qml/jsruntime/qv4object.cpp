@@ -499,6 +499,8 @@ bool Object::internalPut(PropertyKey id, const Value &value, Value *receiver)
                     if (!ok)
                         return false;
                 } else {
+                    if (id.isArrayIndex())
+                        d()->arrayData->noteElement(value);
                     propertyIndex.set(scope.engine, value);
                 }
                 return true;
@@ -707,6 +709,7 @@ void Object::copyArrayData(Object *other)
             Heap::ArrayData *dd = d()->arrayData;
             dd->values.size = other->d()->arrayData->values.size;
             dd->offset = other->d()->arrayData->offset;
+            dd->elementKind = other->d()->arrayData->elementKind;
         }
         // ### need a write barrier
         memcpy(d()->arrayData->values.values, other->d()->arrayData->values.values, other->d()->arrayData->values.alloc*sizeof(Value));
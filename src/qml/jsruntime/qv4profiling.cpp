@@ -12,10 +12,15 @@ namespace Profiling {
 
 FunctionLocation FunctionCall::resolveLocation() const
 {
+    FunctionExecutionCounts executionCounts;
+    executionCounts.interpreted = m_function->interpretedExecutionCount;
+    executionCounts.jitCompiled = m_function->jittedExecutionCount;
+    executionCounts.aotCompiled = m_function->aotExecutionCount;
     return FunctionLocation(m_function->name()->toQString(),
                             m_function->executableCompilationUnit()->fileName(),
                             m_function->compiledFunction->location.line(),
-                            m_function->compiledFunction->location.column());
+                            m_function->compiledFunction->location.column(),
+                            executionCounts);
 }
 
 FunctionCallProperties FunctionCall::properties() const
@@ -23,7 +28,8 @@ FunctionCallProperties FunctionCall::properties() const
     FunctionCallProperties props = {
         m_start,
         m_end,
-        reinterpret_cast<quintptr>(m_function)
+        reinterpret_cast<quintptr>(m_function),
+        m_executionMode
     };
     return props;
 }
@@ -64,13 +70,14 @@ void Profiler::reportData()
         properties.append(call.properties());
         Function *function = call.function();
         Q_ASSERT(function);
+        // The location is sent again with every report, so that it carries the current
+        // execution counts of the function.
+        FunctionLocation &location = locations[properties.constLast().id];
+        if (!location.isValid())
+            location = call.resolveLocation();
         SentMarker &marker = m_sentLocations[reinterpret_cast<quintptr>(function)];
-        if (!marker.isValid()) {
-            FunctionLocation &location = locations[properties.constLast().id];
-            if (!location.isValid())
-                location = call.resolveLocation();
+        if (!marker.isValid())
             marker.setFunction(function);
-        }
     }
 
     emit dataReady(locations, properties, m_memory_data);
@@ -31,9 +31,16 @@ QT_BEGIN_NAMESPACE
 namespace QV4 {
 namespace Profiling {
 class Profiler {};
+enum ExecutionMode {
+    Interpreted,
+    JitCompiled,
+    AotCompiled
+};
+
 class FunctionCallProfiler {
 public:
     FunctionCallProfiler(ExecutionEngine *, Function *) {}
+    void setExecutionMode(ExecutionMode) {}
 };
 }
 }
@@ -69,16 +76,30 @@ enum MemoryType {
     SmallItem
 };
 
+enum ExecutionMode {
+    Interpreted,
+    JitCompiled,
+    AotCompiled
+};
+
 struct FunctionCallProperties {
     qint64 start;
     qint64 end;
     quintptr id;
+    ExecutionMode executionMode;
+};
+
+struct FunctionExecutionCounts {
+    quint32 interpreted = 0;
+    quint32 jitCompiled = 0;
+    quint32 aotCompiled = 0;
 };
 
 struct FunctionLocation {
     FunctionLocation(const QString &name = QString(), const QString &file = QString(),
-                     int line = -1, int column = -1) :
-        name(name), file(file), line(line), column(column)
+                     int line = -1, int column = -1,
+                     const FunctionExecutionCounts &executionCounts = FunctionExecutionCounts()) :
+        name(name), file(file), line(line), column(column), executionCounts(executionCounts)
     {}
 
     bool isValid()
@@ -90,6 +111,9 @@ struct FunctionLocation {
     QString file;
     int line;
     int column;
+
+    // Sampled when the data is reported, counting all executions since the function was created.
+    FunctionExecutionCounts executionCounts;
 };
 
 typedef QHash<quintptr, QV4::Profiling::FunctionLocation> FunctionLocationHash;
@@ -102,20 +126,22 @@ struct MemoryAllocationProperties {
 
 class FunctionCall {
 public:
-    FunctionCall() : m_function(nullptr), m_start(0), m_end(0) {}
+    FunctionCall() : m_function(nullptr), m_start(0), m_end(0), m_executionMode(Interpreted) {}
 
-    FunctionCall(Function *function, qint64 start, qint64 end) :
-        m_function(function), m_start(start), m_end(end)
+    FunctionCall(Function *function, qint64 start, qint64 end, ExecutionMode executionMode) :
+        m_function(function), m_start(start), m_end(end), m_executionMode(executionMode)
     { m_function->executableCompilationUnit()->addref(); }
 
     FunctionCall(const FunctionCall &other) :
-        m_function(other.m_function), m_start(other.m_start), m_end(other.m_end)
+        m_function(other.m_function), m_start(other.m_start), m_end(other.m_end),
+        m_executionMode(other.m_executionMode)
     { m_function->executableCompilationUnit()->addref(); }
 
     FunctionCall(FunctionCall &&other) noexcept
         : m_function(std::exchange(other.m_function, nullptr))
         , m_start(std::exchange(other.m_start, 0))
         , m_end(std::exchange(other.m_end, 0))
+        , m_executionMode(other.m_executionMode)
     {}
 
     ~FunctionCall()
@@ -133,6 +159,7 @@ public:
             m_function = other.m_function;
             m_start = other.m_start;
             m_end = other.m_end;
+            m_executionMode = other.m_executionMode;
         }
         return *this;
     }
@@ -144,6 +171,7 @@ public:
         qt_ptr_swap(m_function, other.m_function);
         std::swap(m_start, other.m_start);
         std::swap(m_end, other.m_end);
+        std::swap(m_executionMode, other.m_executionMode);
     }
 
     Function *function() const
@@ -160,6 +188,7 @@ private:
     Function *m_function;
     qint64 m_start;
     qint64 m_end;
+    ExecutionMode m_executionMode;
 };
 
 class Q_QML_EXPORT Profiler : public QObject {
@@ -269,13 +298,18 @@ public:
 
     ~FunctionCallProfiler()
     {
-        if (profiler)
-            profiler->m_data.append(FunctionCall(function, startTime, profiler->m_timer.nsecsElapsed()));
+        if (profiler) {
+            profiler->m_data.append(FunctionCall(function, startTime,
+                                                 profiler->m_timer.nsecsElapsed(), executionMode));
+        }
     }
 
+    void setExecutionMode(ExecutionMode mode) { executionMode = mode; }
+
     Profiler *profiler = nullptr;
     Function *function = nullptr;
     qint64 startTime = 0;
+    ExecutionMode executionMode = Interpreted;
 };
 
 
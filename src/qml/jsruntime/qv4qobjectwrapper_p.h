@@ -128,6 +128,9 @@ struct Q_QML_EXPORT QObjectWrapper : public Object
     V4_OBJECT2(QObjectWrapper, Object)
     V4_NEEDS_DESTROY
 
+    // Marking looks at the QObject and uses the JS stack of the engine.
+    enum { MarksOnEngineThread = true };
+
     enum Flag {
         NoFlag         = 0x0,
         CheckRevision  = 0x1,
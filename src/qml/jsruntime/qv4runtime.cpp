@@ -600,6 +600,8 @@ QV4::ReturnedValue RuntimeHelpers::addHelper(ExecutionEngine *engine, const Valu
             return sright->asReturnedValue();
         if (!sright->d()->length())
             return sleft->asReturnedValue();
+        if (Heap::String *appended = sleft->d()->appendToBuffer(sright->d()))
+            return appended->asReturnedValue();
         MemoryManager *mm = engine->memoryManager;
         return (mm->alloc<ComplexString>(sleft->d(), sright->d()))->asReturnedValue();
     }
@@ -978,6 +980,17 @@ void Runtime::StoreNameStrict::call(ExecutionEngine *engine, int nameIndex, cons
         engine->throwReferenceError(name);
 }
 
+void Runtime::StoreScopedLocal::call(ExecutionEngine *engine, int scope, int index, const Value &value)
+{
+    Heap::ExecutionContext *context = engine->currentContext()->d();
+    while (scope > 0) {
+        --scope;
+        context = context->outer;
+    }
+    Q_ASSERT(context);
+    static_cast<Heap::CallContext *>(context)->locals.set(engine, index, value);
+}
+
 ReturnedValue Runtime::LoadProperty::call(ExecutionEngine *engine, const Value &object, int nameIndex)
 {
     Scope scope(engine);
@@ -2393,6 +2406,7 @@ QHash<const void *, const char *> Runtime::symbolTable()
 
             {symbol<StoreNameStrict>(), "StoreNameStrict" },
             {symbol<StoreNameSloppy>(), "StoreNameSloppy" },
+            {symbol<StoreScopedLocal>(), "StoreScopedLocal" },
             {symbol<StoreProperty>(), "StoreProperty" },
             {symbol<StoreElement>(), "StoreElement" },
             {symbol<LoadProperty>(), "LoadProperty" },
@@ -107,6 +107,10 @@ struct Q_QML_PRIVATE_EXPORT Runtime {
     {
         static void call(ExecutionEngine *, int, const Value &);
     };
+    struct Q_QML_PRIVATE_EXPORT StoreScopedLocal : Method<Throws::No>
+    {
+        static void call(ExecutionEngine *, int, int, const Value &);
+    };
     struct Q_QML_PRIVATE_EXPORT StoreProperty : Method<Throws::Yes>
     {
         static void call(ExecutionEngine *, const Value &, int, const Value &);
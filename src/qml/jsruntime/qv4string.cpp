@@ -59,6 +59,48 @@ void Heap::String::init(const QString &t)
     subtype = String::StringType_Unknown;
 }
 
+// Returns a flat string holding this string followed by other, or nullptr if this string
+// doesn't end its buffer. The text of other is copied into the spare capacity of the buffer,
+// which grows geometrically, so that building a string with += is linear overall. The buffer
+// is only shared among the strings of one such chain, as handing it out with toQString()
+// ends the chain.
+Heap::String *Heap::String::appendToBuffer(const String *other) const
+{
+    if (!(builderFlags & OwnsBufferEnd))
+        return nullptr;
+    Q_ASSERT(subtype < StringType_Complex);
+
+    MemoryManager *mm = internalClass->engine->memoryManager;
+    QStringPrivate &buffer = text();
+    const qsizetype size = buffer.size + other->length();
+    builderFlags &= ~OwnsBufferEnd;
+
+    // One more character is needed for the terminating '\0'
+    if (buffer.freeSpaceAtEnd() <= other->length()) {
+        QString grown;
+        grown.reserve(2 * size);
+        grown.resize(size);
+        QChar *ch = grown.data();
+        memcpy(static_cast<void *>(ch), buffer.data(), buffer.size * sizeof(QChar));
+        append(other, ch + buffer.size);
+        String *result = mm->allocWithStringData<QV4::String>(size * sizeof(QChar), grown);
+        result->builderFlags = OwnsBufferEnd;
+        return result;
+    }
+
+    // Nobody sees the characters after our end yet, so they can be written to even though
+    // the buffer is shared. Our own '\0' gets overwritten, toQString() copies from now on.
+    QChar *end = reinterpret_cast<QChar *>(buffer.data()) + buffer.size;
+    append(other, end);
+    end[other->length()] = u'\0';
+    builderFlags |= Unterminated;
+    QStringPrivate extended = buffer;
+    extended.size = size;
+    String *result = mm->alloc<QV4::String>(QString(std::move(extended)));
+    result->builderFlags = OwnsBufferEnd | SharesBuffer;
+    return result;
+}
+
 void Heap::ComplexString::init(String *l, String *r)
 {
     StringOrSymbol::init();
@@ -95,7 +137,7 @@ void Heap::ComplexString::init(Heap::String *ref, int from, int len)
 
 void Heap::StringOrSymbol::destroy()
 {
-    if (subtype < Heap::String::StringType_AddedString) {
+    if (subtype < Heap::String::StringType_AddedString && !(builderFlags & SharesBuffer)) {
         internalClass->engine->memoryManager->changeUnmanagedHeapSizeUsage(
                     qptrdiff(-text()->size) * qptrdiff(sizeof(QChar)));
     }
@@ -134,13 +176,20 @@ void Heap::String::simplifyString() const
     Q_ASSERT(subtype >= StringType_AddedString);
 
     int l = length();
-    QString result(l, Qt::Uninitialized);
+    // Long concatenations are most likely built piece by piece, and will be appended to again.
+    const bool builder = subtype == StringType_AddedString && l >= 256;
+    QString result;
+    if (builder)
+        result.reserve(l + l / 2);
+    result.resize(l);
     QChar *ch = const_cast<QChar *>(result.constData());
     append(this, ch);
     text() = result.data_ptr();
     const ComplexString *cs = static_cast<const ComplexString *>(this);
     identifier = PropertyKey::invalid();
     cs->left = cs->right = nullptr;
+    if (builder)
+        builderFlags = OwnsBufferEnd;
 
     internalClass->engine->memoryManager->changeUnmanagedHeapSizeUsage(
                 qptrdiff(text().size) * qptrdiff(sizeof(QChar)));
@@ -41,21 +41,31 @@ struct Q_QML_PRIVATE_EXPORT StringOrSymbol : Base
         StringType_Complex = StringType_AddedString
     };
 
+    // Repeated concatenation appends to the spare capacity of a shared buffer.
+    enum BuilderFlag : uint {
+        OwnsBufferEnd = 0x1, // nothing has been written to the buffer after our text
+        SharesBuffer = 0x2,  // the text is accounted for by the string that allocated it
+        Unterminated = 0x4   // text was appended after ours, overwriting our '\0'
+    };
+
     void init() {
         Base::init();
         new (&textStorage) QStringPrivate;
+        builderFlags = 0;
     }
 
     void init(QStringPrivate text)
     {
         Base::init();
         new (&textStorage) QStringPrivate(std::move(text));
+        builderFlags = 0;
     }
 
     mutable struct { alignas(QStringPrivate) unsigned char data[sizeof(QStringPrivate)]; } textStorage;
     mutable PropertyKey identifier;
     mutable uint subtype;
     mutable uint stringHash;
+    mutable uint builderFlags;
 
     static void markObjects(Heap::Base *that, MarkStack *markStack);
     void destroy();
@@ -63,6 +73,12 @@ struct Q_QML_PRIVATE_EXPORT StringOrSymbol : Base
     QStringPrivate &text() const { return *reinterpret_cast<QStringPrivate *>(&textStorage); }
 
     inline QString toQString() const {
+        if (Q_UNLIKELY(builderFlags)) {
+            if (builderFlags & Unterminated)
+                return QString(reinterpret_cast<const QChar *>(text().data()), text().size);
+            // The buffer is now shared outside of the engine, nothing may be appended to it.
+            builderFlags &= ~OwnsBufferEnd;
+        }
         QStringPrivate dd = text();
         return QString(std::move(dd));
     }
@@ -105,10 +121,12 @@ struct Q_QML_PRIVATE_EXPORT String : StringOrSymbol {
         if (subtype == Heap::String::StringType_ArrayIndex && other->subtype == Heap::String::StringType_ArrayIndex)
             return true;
 
-        return toQString() == other->toQString();
+        return QStringView(text().data(), text().size)
+                == QStringView(other->text().data(), other->text().size);
     }
 
     bool startsWithUpper() const;
+    String *appendToBuffer(const String *other) const;
 
 private:
     static void append(const String *data, QChar *ch);
@@ -7,7 +7,9 @@
 #include "qv4symbol_p.h"
 #include "qv4runtime_p.h"
 #include <QtCore/qatomic.h>
+#include <private/qsimd_p.h>
 
+#include <algorithm>
 #include <cmath>
 
 using namespace QV4;
@@ -189,6 +191,156 @@ ReturnedValue atomicStore(char *data, Value v)
     return typeToValue(value);
 }
 
+// The bulk operations below work on the raw elements. Clamping only matters when converting
+// values, so the elements of an Uint8ClampedArray can be handled as plain quint8.
+template <typename T>
+struct RawElement { using Type = T; };
+template <>
+struct RawElement<ClampedUInt8> { using Type = quint8; };
+
+// Converts value to the element type, if that is possible without changing its value.
+template <typename T>
+static bool toExactElement(Value value, T *element)
+{
+    Q_ASSERT(value.isNumber());
+    const double d = value.asDouble();
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isfinite(d) && std::abs(d) > double(std::numeric_limits<T>::max()))
+            return false;
+    } else {
+        if (!(d >= double(std::numeric_limits<T>::min()) && d <= double(std::numeric_limits<T>::max())))
+            return false;
+    }
+    *element = static_cast<T>(d);
+    return *element == d;
+}
+
+#if defined(__SSE2__)
+// Returns the index of the first chunk of 16 bytes that may contain element, or the index
+// after the last complete chunk.
+template <typename T>
+static uint skipNonMatchingChunks(const T *data, uint i, uint to, T element)
+{
+    constexpr uint Lanes = sizeof(__m128i) / sizeof(T);
+    for (; i + Lanes <= to; i += Lanes) {
+        int mask;
+        if constexpr (std::is_same_v<T, float>) {
+            mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), _mm_set1_ps(element)));
+        } else if constexpr (std::is_same_v<T, double>) {
+            mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), _mm_set1_pd(element)));
+        } else {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            if constexpr (sizeof(T) == 2)
+                mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, _mm_set1_epi16(short(element))));
+            else
+                mask = _mm_movemask_epi8(_mm_cmpeq_epi32(chunk, _mm_set1_epi32(int(element))));
+        }
+        if (mask)
+            break;
+    }
+    return i;
+}
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+template <typename T>
+static uint skipNonMatchingChunks(const T *data, uint i, uint to, T element)
+{
+    constexpr uint Lanes = 16 / sizeof(T);
+    for (; i + Lanes <= to; i += Lanes) {
+        bool found;
+        if constexpr (std::is_same_v<T, float>) {
+            found = vmaxvq_u32(vceqq_f32(vld1q_f32(data + i), vdupq_n_f32(element)));
+        } else if constexpr (std::is_same_v<T, double>) {
+            found = vmaxvq_u32(vreinterpretq_u32_u64(
+                    vceqq_f64(vld1q_f64(data + i), vdupq_n_f64(element))));
+        } else if constexpr (sizeof(T) == 2) {
+            found = vmaxvq_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const quint16 *>(data + i)),
+                                         vdupq_n_u16(quint16(element))));
+        } else {
+            found = vmaxvq_u32(vceqq_u32(vld1q_u32(reinterpret_cast<const quint32 *>(data + i)),
+                                         vdupq_n_u32(quint32(element))));
+        }
+        if (found)
+            break;
+    }
+    return i;
+}
+#endif
+
+template <typename T>
+static qint64 scanElements(const T *data, uint from, uint to, T element)
+{
+    if constexpr (sizeof(T) == 1) {
+        // memchr() is vectorized in all the C libraries we care about.
+        const void *found = memchr(data + from, quint8(element), to - from);
+        return found ? static_cast<const T *>(found) - data : -1;
+    } else {
+        uint i = from;
+#if defined(__SSE2__) || (defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64))
+        i = skipNonMatchingChunks(data, i, to, element);
+#endif
+        for (; i < to; ++i) {
+            if (data[i] == element)
+                return i;
+        }
+        return -1;
+    }
+}
+
+template <typename T>
+void fill(char *data, uint count, Value value)
+{
+    const T element = valueToType<T>(value);
+    if constexpr (sizeof(T) == 1) {
+        memset(data, *reinterpret_cast<const quint8 *>(&element), count);
+    } else {
+        T *elements = reinterpret_cast<T *>(data);
+        std::fill(elements, elements + count, element);
+    }
+}
+
+template <typename T>
+qint64 indexOf(const char *data, uint from, uint to, Value value, bool sameValueZero)
+{
+    using Element = typename RawElement<T>::Type;
+    const Element *elements = reinterpret_cast<const Element *>(data);
+    Element element;
+    if (toExactElement(value, &element))
+        return scanElements(elements, from, to, element);
+
+    if constexpr (std::is_floating_point_v<Element>) {
+        if (sameValueZero && std::isnan(value.asDouble())) {
+            for (uint i = from; i < to; ++i) {
+                if (std::isnan(elements[i]))
+                    return i;
+            }
+        }
+    }
+    return -1;
+}
+
+template <typename T>
+qint64 lastIndexOf(const char *data, uint from, Value value)
+{
+    using Element = typename RawElement<T>::Type;
+    const Element *elements = reinterpret_cast<const Element *>(data);
+    Element element;
+    if (!toExactElement(value, &element))
+        return -1;
+    for (uint i = from; i > 0;) {
+        --i;
+        if (elements[i] == element)
+            return i;
+    }
+    return -1;
+}
+
+template <typename T>
+void reverse(char *data, uint count)
+{
+    using Element = typename RawElement<T>::Type;
+    Element *elements = reinterpret_cast<Element *>(data);
+    std::reverse(elements, elements + count);
+}
 
 template<typename T>
 constexpr TypedArrayOperations TypedArrayOperations::create(const char *name)
@@ -200,7 +352,11 @@ constexpr TypedArrayOperations TypedArrayOperations::create(const char *name)
              { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr },
              nullptr,
              nullptr,
-             nullptr
+             nullptr,
+             ::fill<T>,
+             ::indexOf<T>,
+             ::lastIndexOf<T>,
+             ::reverse<T>
     };
 }
 
@@ -214,7 +370,11 @@ constexpr TypedArrayOperations TypedArrayOperations::createWithAtomics(const cha
              { ::atomicAdd<T>, ::atomicAnd<T>, ::atomicExchange<T>, ::atomicOr<T>, ::atomicSub<T>, ::atomicXor<T> },
              ::atomicCompareExchange<T>,
              ::atomicLoad<T>,
-             ::atomicStore<T>
+             ::atomicStore<T>,
+             ::fill<T>,
+             ::indexOf<T>,
+             ::lastIndexOf<T>,
+             ::reverse<T>
     };
 }
 
@@ -771,10 +931,8 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_fill(const FunctionObject *b,
     uint bytesPerElement = v->bytesPerElement();
     uint byteOffset = v->byteOffset();
 
-    while (k < fin) {
-        v->d()->type->write(data + byteOffset + k * bytesPerElement, value);
-        k++;
-    }
+    if (k < fin)
+        v->d()->type->fill(data + byteOffset + k * bytesPerElement, fin - k, value);
 
     return v.asReturnedValue();
 }
@@ -976,6 +1134,13 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_includes(const FunctionObject
         }
     }
 
+    if (k < len && !v->hasDetachedArrayData()) {
+        if (!argc || !argv[0].isNumber())
+            return Encode(false);
+        const char *data = v->constArrayData() + v->byteOffset();
+        return Encode(v->d()->type->indexOf(data, uint(k), len, argv[0], true) >= 0);
+    }
+
     while (k < len) {
         ScopedValue val(scope, v->get(k));
         if (val->sameValueZero(argv[0])) {
@@ -1022,6 +1187,13 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_indexOf(const FunctionObject
         return Encode(-1);
     }
 
+    if (!v->hasDetachedArrayData()) {
+        if (!searchValue->isNumber())
+            return Encode(-1);
+        const char *data = v->constArrayData() + v->byteOffset();
+        return Encode(v->d()->type->indexOf(data, fromIndex, len, searchValue, false));
+    }
+
     ScopedValue value(scope);
 
     for (uint i = fromIndex; i < len; ++i) {
@@ -1119,6 +1291,13 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_lastIndexOf(const FunctionObj
         fromIndex = (uint) f + 1;
     }
 
+    if (!instance->hasDetachedArrayData()) {
+        if (!searchValue->isNumber())
+            return Encode(-1);
+        const char *data = instance->constArrayData() + instance->byteOffset();
+        return Encode(instance->d()->type->lastIndexOf(data, fromIndex, searchValue));
+    }
+
     ScopedValue value(scope);
     for (uint k = fromIndex; k > 0;) {
         --k;
@@ -1280,23 +1459,7 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_reverse(const FunctionObject
     if (!instance || instance->hasDetachedArrayData())
         return scope.engine->throwTypeError();
 
-    uint length = instance->length();
-
-    int lo = 0, hi = length - 1;
-
-    ScopedValue lval(scope);
-    ScopedValue hval(scope);
-    for (; lo < hi; ++lo, --hi) {
-        bool loExists, hiExists;
-        lval = instance->get(lo, &loExists);
-        hval = instance->get(hi, &hiExists);
-        Q_ASSERT(hiExists && loExists);
-        bool ok;
-        ok = instance->put(lo, hval);
-        Q_ASSERT(ok);
-        ok = instance->put(hi, lval);
-        Q_ASSERT(ok);
-    }
+    instance->d()->type->reverse(instance->arrayData() + instance->byteOffset(), instance->length());
     return instance->asReturnedValue();
 }
 
@@ -1348,6 +1511,30 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_values(const FunctionObject *
     return ao->asReturnedValue();
 }
 
+// Returns true if converting the elements of a typed array of type from to type to doesn't
+// change their bits. The integer conversions in TypedArray::set are all modular, except for
+// clamping negative values when converting to Uint8ClampedArray.
+static bool hasSameRepresentation(TypedArrayType from, TypedArrayType to)
+{
+    switch (from) {
+    case Int8Array:
+        return to == UInt8Array;
+    case UInt8Array:
+    case UInt8ClampedArray:
+        return to == Int8Array || to == UInt8Array || to == UInt8ClampedArray;
+    case Int16Array:
+        return to == UInt16Array;
+    case UInt16Array:
+        return to == Int16Array;
+    case Int32Array:
+        return to == UInt32Array;
+    case UInt32Array:
+        return to == Int32Array;
+    default:
+        return false;
+    }
+}
+
 ReturnedValue IntrinsicTypedArrayPrototype::method_set(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
 {
     Scope scope(b);
@@ -1417,8 +1604,9 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_set(const FunctionObject *b,
 
     char *dest = buffer->arrayData() + a->byteOffset() + offset*elementSize;
     const char *src = srcBuffer->d()->constArrayData() + srcTypedArray->byteOffset();
-    if (srcTypedArray->d()->type == a->d()->type) {
-        // same type of typed arrays, use memmove (as srcbuffer and buffer could be the same)
+    if (srcTypedArray->d()->type == a->d()->type
+            || hasSameRepresentation(srcTypedArray->arrayType(), a->arrayType())) {
+        // same representation of elements, use memmove (as srcbuffer and buffer could be the same)
         memmove(dest, src, srcTypedArray->byteLength());
         RETURN_UNDEFINED();
     }
@@ -1480,6 +1668,16 @@ ReturnedValue IntrinsicTypedArrayPrototype::method_slice(const FunctionObject *b
     if (!a)
         return Encode::undefined();
 
+    if (count && a->d()->type == instance->d()->type) {
+        if (instance->hasDetachedArrayData())
+            return scope.engine->throwTypeError();
+        const uint bytesPerElement = instance->bytesPerElement();
+        memmove(a->arrayData() + a->byteOffset(),
+                instance->constArrayData() + instance->byteOffset() + start * bytesPerElement,
+                count * bytesPerElement);
+        return a->asReturnedValue();
+    }
+
     ScopedValue v(scope);
     uint n = 0;
     for (uint i = start; i < end; ++i) {
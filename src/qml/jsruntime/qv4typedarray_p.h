@@ -54,6 +54,10 @@ struct TypedArrayOperations {
     typedef ReturnedValue (*AtomicCompareExchange)(char *data, Value expected, Value v);
     typedef ReturnedValue (*AtomicLoad)(char *data);
     typedef ReturnedValue (*AtomicStore)(char *data, Value value);
+    typedef void (*Fill)(char *data, uint count, Value value);
+    typedef qint64 (*IndexOf)(const char *data, uint from, uint to, Value value, bool sameValueZero);
+    typedef qint64 (*LastIndexOf)(const char *data, uint from, Value value);
+    typedef void (*Reverse)(char *data, uint count);
 
     template<typename T>
     static constexpr TypedArrayOperations create(const char *name);
@@ -68,6 +72,12 @@ struct TypedArrayOperations {
     AtomicCompareExchange atomicCompareExchange;
     AtomicLoad atomicLoad;
     AtomicStore atomicStore;
+
+    // Bulk operations working on the raw elements. value has to be a number.
+    Fill fill;
+    IndexOf indexOf;
+    LastIndexOf lastIndexOf;
+    Reverse reverse;
 };
 
 namespace Heap {
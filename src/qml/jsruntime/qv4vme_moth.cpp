@@ -411,6 +411,8 @@ void VME::exec(MetaTypesStackFrame *frame, ExecutionEngine *engine)
                   function->compiledFunction->location.line(),
                   function->compiledFunction->location.column());
     Profiling::FunctionCallProfiler profiler(engine, function); // start execution profiling
+    profiler.setExecutionMode(Profiling::AotCompiled);
+    ++function->aotExecutionCount;
 
     const qsizetype numFunctionArguments = function->typedFunction->argumentTypes.size();
 
@@ -538,6 +540,13 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
                 QV4::JIT::BaselineJIT(function).generate();
             else
                 ++function->interpreterCallCount;
+        } else if (function->jittedCode != nullptr && function->baselineCodeRef == nullptr) {
+            // Hot baseline code gets recompiled once, using the type feedback the lookups
+            // have collected in the meantime.
+            if (engine->canOptimizeJIT(function))
+                QV4::JIT::BaselineJIT(function, QV4::JIT::BaselineJIT::Optimizing).generate();
+            else
+                ++function->jittedCallCount;
         }
     }
 #endif // QT_CONFIG(qml_jit)
@@ -549,9 +558,12 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
     ReturnedValue result;
     Q_ASSERT(function->kind != Function::AotCompiled);
     if (function->jittedCode != nullptr && debugger == nullptr) {
+        profiler.setExecutionMode(Profiling::JitCompiled);
+        ++function->jittedExecutionCount;
         result = function->jittedCode(frame, engine);
     } else {
         // interpreter
+        ++function->interpretedExecutionCount;
         result = interpret(frame, engine, function->codeData);
     }
 
@@ -151,7 +151,13 @@ void Base::mark(QV4::MarkStack *markStack)
     quintptr *bitmap = c->blackBitmap + Chunk::bitmapIndex(index);
     quintptr bit = Chunk::bitForIndex(index);
     if (!(*bitmap & bit)) {
-        *bitmap |= bit;
+        if (Q_UNLIKELY(markStack->isParallel())) {
+            // another thread might be marking this object right now
+            if (!Chunk::testAndSetBit(bitmap, bit))
+                return;
+        } else {
+            *bitmap |= bit;
+        }
         markStack->push(this);
     }
 }
@@ -6,6 +6,7 @@
 #include "qv4mm_p.h"
 #include "qv4qobjectwrapper_p.h"
 #include "qv4identifiertable_p.h"
+#include "qv4lookup_p.h"
 #include <QtCore/qalgorithms.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/qloggingcategory.h>
@@ -17,6 +18,11 @@
 #include <QElapsedTimer>
 #include <QMap>
 #include <QScopedValueRollback>
+#include <QDeadlineTimer>
+#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 #include <iostream>
 #include <cstdlib>
@@ -267,16 +273,53 @@ static void increaseFreedCountForClass(const char *className)
 //bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
 bool Chunk::sweep(ExecutionEngine *engine)
 {
-    bool hasUsedSlots = false;
     SDUMP() << "sweeping chunk" << this;
+    destroyDeadObjects();
+    uint freedSlots = 0;
+    const bool hasUsedSlots = sweepBitmaps(&freedSlots);
+    Q_V4_PROFILE_DEALLOC(engine, freedSlots * Chunk::SlotSize, Profiling::SmallItem);
+    //    DEBUG << "swept chunk" << this << "freed" << freedSlots << "slots.";
+    return hasUsedSlots;
+}
+
+void Chunk::destroyDeadObjects()
+{
     HeapItem *o = realBase();
-    bool lastSlotFree = false;
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(incremental)
         Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
 #endif
         quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
         Q_ASSERT((toFree & objectBitmap[i]) == toFree); // check all black objects are marked as being used
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            toFree ^= (static_cast<quintptr>(1) << index); // mask out freed slot
+
+            HeapItem *itemToFree = o + index;
+            Heap::Base *b = *itemToFree;
+            const VTable *v = b->internalClass->vtable;
+//            if (Q_UNLIKELY(classCountPtr))
+//                classCountPtr(v->className);
+            if (v->destroy) {
+                v->destroy(b);
+                b->_checkIsDestroyed();
+            }
+#ifdef V4_USE_HEAPTRACK
+            heaptrack_report_free(itemToFree);
+#endif
+        }
+        o += Chunk::Bits;
+    }
+}
+
+// Only touches the bitmaps of this chunk, so that chunks can be swept in parallel.
+bool Chunk::sweepBitmaps(uint *freedSlots)
+{
+    bool hasUsedSlots = false;
+    bool lastSlotFree = false;
+    uint slotsFreed = 0;
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
         quintptr e = extendsBitmap[i];
         SDUMP() << "   index=" << i;
         SDUMP() << "        toFree      =" << binary(toFree);
@@ -300,23 +343,9 @@ bool Chunk::sweep(ExecutionEngine *engine)
             Q_ASSERT(qCountTrailingZeroBits(result) - index != 0); // ensure we freed something
             result |= mask; // ensure we don't clear stuff to the right of the current object
             e &= result;
-
-            HeapItem *itemToFree = o + index;
-            Heap::Base *b = *itemToFree;
-            const VTable *v = b->internalClass->vtable;
-//            if (Q_UNLIKELY(classCountPtr))
-//                classCountPtr(v->className);
-            if (v->destroy) {
-                v->destroy(b);
-                b->_checkIsDestroyed();
-            }
-#ifdef V4_USE_HEAPTRACK
-            heaptrack_report_free(itemToFree);
-#endif
         }
-        Q_V4_PROFILE_DEALLOC(engine, qPopulationCount((objectBitmap[i] | extendsBitmap[i])
-                                                      - (blackBitmap[i] | e)) * Chunk::SlotSize,
-                             Profiling::SmallItem);
+        slotsFreed += qPopulationCount((objectBitmap[i] | extendsBitmap[i])
+                                       - (blackBitmap[i] | e));
         objectBitmap[i] = blackBitmap[i];
         grayBitmap[i] = 0;
         hasUsedSlots |= (blackBitmap[i] != 0);
@@ -325,9 +354,8 @@ bool Chunk::sweep(ExecutionEngine *engine)
         SDUMP() << "        new extends =" << binary(e);
         SDUMP() << "        lastSlotFree" << lastSlotFree;
         Q_ASSERT((objectBitmap[i] & extendsBitmap[i]) == 0);
-        o += Chunk::Bits;
     }
-    //    DEBUG << "swept chunk" << this << "freed" << slotsFreed << "slots.";
+    *freedSlots = slotsFreed;
     return hasUsedSlots;
 }
 
@@ -378,6 +406,8 @@ void Chunk::freeAll(ExecutionEngine *engine)
 void Chunk::resetBlackBits()
 {
     memset(blackBitmap, 0, sizeof(blackBitmap));
+    // gray bits only make sense on black objects
+    memset(grayBitmap, 0, sizeof(grayBitmap));
 }
 
 void Chunk::collectGrayItems(MarkStack *markStack)
@@ -385,7 +415,7 @@ void Chunk::collectGrayItems(MarkStack *markStack)
     //    DEBUG << "sweeping chunk" << this << (*freeList);
     HeapItem *o = realBase();
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(incremental)
         Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
 #endif
         quintptr toMark = blackBitmap[i] & grayBitmap[i]; // correct for a Steele type barrier
@@ -606,6 +636,97 @@ void BlockAllocator::sweep()
     chunks.erase(firstEmptyChunk, chunks.end());
 }
 
+void BlockAllocator::sweep(QThreadPool *pool, int nThreads, qint64 *threadTimes)
+{
+    nextFree = nullptr;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+    usedSlotsAfterLastSweep = 0;
+
+    // Destructors access the engine, the QObjects and reference counted data that is not
+    // thread safe. Run them all on the engine thread, before any of the bitmaps change.
+    QElapsedTimer timer;
+    timer.start();
+    for (Chunk *c : chunks)
+        c->destroyDeadObjects();
+    threadTimes[0] += timer.nsecsElapsed();
+
+    const int nChunks = int(chunks.size());
+    std::vector<uint> freedSlots(nChunks, 0);
+    std::vector<char> hasUsedSlots(nChunks, 0);
+    QAtomicInt nextChunk = 0;
+    const auto sweepChunks = [&](int thread) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = nextChunk.fetchAndAddRelaxed(1); i < nChunks;
+             i = nextChunk.fetchAndAddRelaxed(1)) {
+            hasUsedSlots[i] = chunks[i]->sweepBitmaps(&freedSlots[i]);
+        }
+        threadTimes[thread] += timer.nsecsElapsed();
+    };
+    for (int i = 1; i < nThreads; ++i)
+        pool->start([&sweepChunks, i]() { sweepChunks(i); });
+    sweepChunks(0);
+    pool->waitForDone();
+
+    std::vector<Chunk *> usedChunks;
+    usedChunks.reserve(nChunks);
+    for (int i = 0; i < nChunks; ++i) {
+        Chunk *c = chunks[i];
+        Q_V4_PROFILE_DEALLOC(engine, freedSlots[i] * Chunk::SlotSize, Profiling::SmallItem);
+        if (hasUsedSlots[i]) {
+            c->sortIntoBins(freeBins, NumBins);
+            usedSlotsAfterLastSweep += c->nUsedSlots();
+            usedChunks.push_back(c);
+        } else {
+            Q_V4_PROFILE_DEALLOC(engine, Chunk::DataSize, Profiling::HeapPage);
+            chunkAllocator->free(c);
+        }
+    }
+    chunks = std::move(usedChunks);
+}
+
+void BlockAllocator::beginSweep()
+{
+    nextFree = nullptr;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+
+    usedSlotsAfterLastSweep = 0;
+    nChunksToSweep = chunks.size();
+    nextChunkToSweep = 0;
+}
+
+bool BlockAllocator::sweepChunk()
+{
+    if (nextChunkToSweep == nChunksToSweep)
+        return false;
+
+    // Chunks allocated after beginSweep() are appended to the vector and are not swept.
+    Chunk *c = chunks[nextChunkToSweep++];
+    if (c->sweep(engine)) {
+        c->sortIntoBins(freeBins, NumBins);
+        usedSlotsAfterLastSweep += c->nUsedSlots();
+    } else {
+        // don't hand out memory from empty chunks, they get released in endSweep()
+        emptyChunks.push_back(c);
+    }
+    return true;
+}
+
+void BlockAllocator::endSweep()
+{
+    Q_ASSERT(nextChunkToSweep == nChunksToSweep);
+    for (Chunk *c : emptyChunks) {
+        Q_V4_PROFILE_DEALLOC(engine, Chunk::DataSize, Profiling::HeapPage);
+        chunks.erase(std::find(chunks.begin(), chunks.end(), c));
+        chunkAllocator->free(c);
+    }
+    emptyChunks.clear();
+    nChunksToSweep = 0;
+    nextChunkToSweep = 0;
+}
+
 void BlockAllocator::freeAll()
 {
     for (auto c : chunks)
@@ -679,8 +800,8 @@ static void freeHugeChunk(ChunkAllocator *chunkAllocator, const HugeItemAllocato
 void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 {
     auto isBlack = [this, classCountPtr] (const HugeChunk &c) {
+        // The black bits are reset in MemoryManager::finishGC(), unless they stick
         bool b = c.chunk->first()->isBlack();
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
         if (!b) {
             Q_V4_PROFILE_DEALLOC(engine, c.size, Profiling::LargeItem);
             freeHugeChunk(chunkAllocator, c, classCountPtr);
@@ -694,20 +815,27 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 
 void HugeItemAllocator::resetBlackBits()
 {
-    for (auto c : chunks)
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+    for (auto c : chunks) {
+        const size_t index = c.chunk->first() - c.chunk->realBase();
+        Chunk::clearBit(c.chunk->blackBitmap, index);
+        Chunk::clearBit(c.chunk->grayBitmap, index);
+    }
 }
 
 void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
 {
-    for (auto c : chunks)
+    for (auto c : chunks) {
+        const size_t index = c.chunk->first() - c.chunk->realBase();
         // Correct for a Steele type barrier
-        if (Chunk::testBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase()) &&
-            Chunk::testBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase())) {
+        if (Chunk::testBit(c.chunk->blackBitmap, index) &&
+            Chunk::testBit(c.chunk->grayBitmap, index)) {
+            Chunk::clearBit(c.chunk->grayBitmap, index);
             HeapItem *i = c.chunk->first();
             Heap::Base *b = *i;
-            b->mark(markStack);
+            // b is black already, so b->mark() would not push it again
+            markStack->push(b);
         }
+    }
 }
 
 void HugeItemAllocator::freeAll()
@@ -731,10 +859,25 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     , aggressiveGC(!qEnvironmentVariableIsEmpty("QV4_MM_AGGRESSIVE_GC"))
     , gcStats(lcGcStats().isDebugEnabled())
     , gcCollectorStats(lcGcAllocatorStats().isDebugEnabled())
+    , incrementalGC(qEnvironmentVariableIntValue(QV4_MM_INCREMENTAL_GC) != 0)
 {
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
+    bool ok = false;
+    const int timeSlice = qEnvironmentVariableIntValue(QV4_MM_GC_TIMESLICE, &ok);
+    if (ok && timeSlice > 0)
+        gcTimeSlice = timeSlice;
+    if (!incrementalGC && qEnvironmentVariableIntValue(QV4_MM_GENERATIONAL_GC) != 0)
+        setGenerationalGC(true);
+    const int nurseryKB = qEnvironmentVariableIntValue(QV4_MM_NURSERY_SIZE, &ok);
+    if (ok && nurseryKB > 0)
+        nurserySize = std::size_t(nurseryKB) * 1024;
+    if (qEnvironmentVariableIsSet(QV4_MM_GC_THREADS)) {
+        const int threads = qEnvironmentVariableIntValue(QV4_MM_GC_THREADS, &ok);
+        // 0 means one thread per core
+        setGCThreadCount(ok && threads > 0 ? threads : QThread::idealThreadCount());
+    }
     memset(statistics.allocations, 0, sizeof(statistics.allocations));
     if (gcStats)
         blockAllocator.allocationStats = statistics.allocations;
@@ -751,7 +894,7 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
 
     HeapItem *m = allocate(&blockAllocator, stringSize);
     memset(m, 0, stringSize);
-    if (gcBlocked) {
+    if (allocateBlack()) {
         // If the gc is running right now, it will not have a chance to mark the newly created item
         // and may therefore sweep it right away.
         // Protect the new object from the current GC run to avoid this.
@@ -773,7 +916,7 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
 
     HeapItem *m = allocate(&blockAllocator, size);
     memset(m, 0, size);
-    if (gcBlocked) {
+    if (allocateBlack()) {
         // If the gc is running right now, it will not have a chance to mark the newly created item
         // and may therefore sweep it right away.
         // Protect the new object from the current GC run to avoid this.
@@ -811,6 +954,8 @@ Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable
             Chunk::setBit(c->objectBitmap, index);
             Chunk::clearBit(c->extendsBitmap, index);
         }
+        if (allocateBlack())
+            m->setMarkBit();
         o->memberData.set(engine, m);
         m->internalClass.set(engine, engine->internalClasses(EngineBase::Class_MemberData));
         Q_ASSERT(o->memberData->internalClass);
@@ -835,16 +980,288 @@ MarkStack::MarkStack(ExecutionEngine *engine)
     m_softLimit = m_base + size * 3 / 4;
 }
 
+MarkStack::MarkStack(ExecutionEngine *engine, ParallelMarker *marker, int thread,
+                     Heap::Base **base, size_t size)
+    : m_top(base)
+    , m_base(base)
+    , m_softLimit(base + size * 3 / 4)
+    , m_hardLimit(base + size)
+    , m_engine(engine)
+    , m_marker(marker)
+    , m_thread(thread)
+{
+}
+
+MarkStack::~MarkStack()
+{
+    drain();
+    markStackSize += m_markedObjects;
+}
+
 void MarkStack::drain()
 {
     while (m_top > m_base) {
         Heap::Base *h = pop();
-        ++markStackSize;
         Q_ASSERT(h); // at this point we should only have Heap::Base objects in this area on the stack. If not, weird things might happen.
-        h->internalClass->vtable->markObjects(h, this);
+        if (m_marker) {
+            markParallel(h);
+        } else {
+            ++m_markedObjects;
+            h->internalClass->vtable->markObjects(h, this);
+        }
     }
 }
 
+MarkStack::DrainState MarkStack::drain(QDeadlineTimer deadline)
+{
+    // Querying the clock is expensive compared to marking a single object
+    enum { ObjectsPerDeadlineCheck = 64 };
+
+    do {
+        for (int i = 0; i < ObjectsPerDeadlineCheck; ++i) {
+            if (m_top == m_base)
+                return DrainState::Complete;
+            Heap::Base *h = pop();
+            ++m_markedObjects;
+            Q_ASSERT(h);
+            h->internalClass->vtable->markObjects(h, this);
+        }
+    } while (!deadline.hasExpired());
+    return m_top == m_base ? DrainState::Complete : DrainState::Ongoing;
+}
+
+// Shares the marking between the engine thread (thread 0) and the GC worker threads. Each
+// thread marks from its own mark stack. A thread that runs out of work asks for more, and
+// the threads that still have some give away half of their mark stack. The objects that can
+// only be marked on the engine thread are collected and handed over to it in batches.
+struct ParallelMarker
+{
+    enum {
+        BalanceInterval = 64, // objects marked between two checks for idle threads
+        BatchSize = 64 // objects passed to the engine thread at once
+    };
+
+    struct Thread {
+        std::unique_ptr<Heap::Base *[]> stackData;
+        std::unique_ptr<MarkStack> markStack;
+        std::vector<Heap::Base *> forEngineThread;
+        qint64 busyTime = 0; // in ns
+    };
+
+    ParallelMarker(ExecutionEngine *engine, int nThreads);
+
+    MarkStack *markStack(int thread) { return threads[thread].markStack.get(); }
+    void run(int thread);
+    void balance(MarkStack *stack);
+    void passToEngineThread(int thread, Heap::Base *h);
+
+private:
+    bool waitForWork(int thread);
+    void flushLocked(int thread);
+    void takeEngineThreadWorkLocked(MarkStack *stack);
+
+public:
+    std::vector<Thread> threads;
+
+private:
+    QMutex mutex;
+    QWaitCondition workAvailable;
+    std::vector<std::vector<Heap::Base *>> sharedWork;
+    std::vector<Heap::Base *> engineThreadWork;
+    QAtomicInt waiting = 0; // threads asking for work
+    QAtomicInt hasEngineThreadWork = 0;
+    int idle = 0;
+    bool done = false;
+};
+
+ParallelMarker::ParallelMarker(ExecutionEngine *engine, int nThreads)
+    : threads(nThreads)
+{
+    const size_t size = engine->maxGCStackSize() / sizeof(Heap::Base);
+    for (int i = 0; i < nThreads; ++i) {
+        Heap::Base **base;
+        if (i == 0) {
+            base = (Heap::Base **)engine->gcStack->base();
+        } else {
+            threads[i].stackData.reset(new Heap::Base *[size]);
+            base = threads[i].stackData.get();
+        }
+        threads[i].markStack = std::make_unique<MarkStack>(engine, this, i, base, size);
+    }
+}
+
+void ParallelMarker::run(int thread)
+{
+    Thread &t = threads[thread];
+    QElapsedTimer timer;
+    do {
+        timer.start();
+        t.markStack->drain();
+        t.busyTime += timer.nsecsElapsed();
+    } while (waitForWork(thread));
+}
+
+void ParallelMarker::balance(MarkStack *stack)
+{
+    if (stack->m_thread == 0 && hasEngineThreadWork.loadRelaxed()) {
+        QMutexLocker locker(&mutex);
+        takeEngineThreadWorkLocked(stack);
+    }
+
+    if (!waiting.loadRelaxed() || stack->m_top - stack->m_base < 2)
+        return;
+
+    QMutexLocker locker(&mutex);
+    if (sharedWork.size() >= size_t(waiting.loadRelaxed()))
+        return;
+
+    // Give away the bottom half. Those objects were pushed first and tend to lead to the
+    // larger parts of the object graph.
+    const qptrdiff n = (stack->m_top - stack->m_base) / 2;
+    sharedWork.emplace_back(stack->m_base, stack->m_base + n);
+    std::move(stack->m_base + n, stack->m_top, stack->m_base);
+    stack->m_top -= n;
+    workAvailable.wakeAll();
+}
+
+void ParallelMarker::passToEngineThread(int thread, Heap::Base *h)
+{
+    Thread &t = threads[thread];
+    t.forEngineThread.push_back(h);
+    if (t.forEngineThread.size() < BatchSize)
+        return;
+
+    QMutexLocker locker(&mutex);
+    flushLocked(thread);
+}
+
+void ParallelMarker::flushLocked(int thread)
+{
+    Thread &t = threads[thread];
+    if (t.forEngineThread.empty())
+        return;
+
+    engineThreadWork.insert(engineThreadWork.end(),
+                            t.forEngineThread.begin(), t.forEngineThread.end());
+    t.forEngineThread.clear();
+    hasEngineThreadWork.storeRelaxed(1);
+    workAvailable.wakeAll();
+}
+
+void ParallelMarker::takeEngineThreadWorkLocked(MarkStack *stack)
+{
+    // The objects are marked already, they only need to be scanned.
+    if (stack->m_top >= stack->m_softLimit)
+        return;
+    const size_t space = stack->m_softLimit - stack->m_top;
+    const size_t n = std::min(space, engineThreadWork.size());
+    const auto begin = engineThreadWork.end() - n;
+    stack->m_top = std::copy(begin, engineThreadWork.end(), stack->m_top);
+    engineThreadWork.erase(begin, engineThreadWork.end());
+    if (engineThreadWork.empty())
+        hasEngineThreadWork.storeRelaxed(0);
+}
+
+// Returns false once all threads have run out of work.
+bool ParallelMarker::waitForWork(int thread)
+{
+    MarkStack *stack = markStack(thread);
+    QMutexLocker locker(&mutex);
+    flushLocked(thread);
+    ++idle;
+    waiting.ref();
+    for (;;) {
+        if (thread == 0 && !engineThreadWork.empty()) {
+            takeEngineThreadWorkLocked(stack);
+            break;
+        }
+        if (!sharedWork.empty()) {
+            const std::vector<Heap::Base *> &work = sharedWork.back();
+            Q_ASSERT(stack->m_top + work.size() <= stack->m_hardLimit);
+            stack->m_top = std::copy(work.begin(), work.end(), stack->m_top);
+            sharedWork.pop_back();
+            break;
+        }
+        if (!done && idle == int(threads.size()) && engineThreadWork.empty()) {
+            done = true;
+            workAvailable.wakeAll();
+        }
+        if (done) {
+            waiting.deref();
+            return false;
+        }
+        workAvailable.wait(&mutex);
+    }
+    --idle;
+    waiting.deref();
+    return true;
+}
+
+void MarkStack::markParallel(Heap::Base *h)
+{
+    if (m_thread != 0 && h->internalClass->vtable->marksOnEngineThread) {
+        m_marker->passToEngineThread(m_thread, h);
+        return;
+    }
+
+    h->internalClass->vtable->markObjects(h, this);
+    if (++m_markedObjects % ParallelMarker::BalanceInterval == 0)
+        m_marker->balance(this);
+}
+
+namespace WriteBarrier {
+
+static void shadeObject(Heap::Base *b)
+{
+    // Objects shaded by the barrier are black and gray. The next marking step picks them up
+    // through collectGrayItems(). We must not push them here, as the mark stack might then
+    // drain and scan objects the mutator is in the middle of modifying.
+    if (b && !b->isMarked()) {
+        b->setMarkBit();
+        b->setGrayBit();
+    }
+}
+
+void shade(EngineBase *engine, ReturnedValue oldValue, ReturnedValue newValue)
+{
+    Q_UNUSED(engine);
+    shadeObject(Value::fromReturnedValue(oldValue).heapObject());
+    shadeObject(Value::fromReturnedValue(newValue).heapObject());
+}
+
+void shade(EngineBase *engine, Heap::Base *oldValue, Heap::Base *newValue)
+{
+    Q_UNUSED(engine);
+    shadeObject(oldValue);
+    shadeObject(newValue);
+}
+
+// Between two GCs, black objects are old. Young objects are white.
+void remember(Heap::Base *base, Heap::Base *value)
+{
+    if (value && !value->isMarked() && base && base->isMarked())
+        base->setGrayBit();
+}
+
+void remember(Heap::Base *base, ReturnedValue value)
+{
+    remember(base, Value::fromReturnedValue(value).heapObject());
+}
+
+void replace(EngineBase *engine, Heap::Base *oldValue, Heap::Base *newValue)
+{
+    if (engine->isGCOngoing) {
+        shade(engine, oldValue, newValue);
+    } else if (engine->isGenerationalGC && oldValue && oldValue->isMarked()
+               && newValue && !newValue->isMarked()) {
+        // Promote newValue right away. It's gray, so its contents are rescanned.
+        newValue->setMarkBit();
+        newValue->setGrayBit();
+    }
+}
+
+} // namespace WriteBarrier
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -887,15 +1304,86 @@ void MemoryManager::collectRoots(MarkStack *markStack)
     }
 }
 
-void MemoryManager::mark()
+void MemoryManager::mark(bool fromGrayItems)
 {
     markStackSize = 0;
+    if (gcThreads > 1) {
+        markInParallel(fromGrayItems);
+        return;
+    }
+
     MarkStack markStack(engine);
     collectRoots(&markStack);
+    if (fromGrayItems) {
+        blockAllocator.collectGrayItems(&markStack);
+        hugeItemAllocator.collectGrayItems(&markStack);
+        icAllocator.collectGrayItems(&markStack);
+    }
     // dtor of MarkStack drains
 }
 
+void MemoryManager::markInParallel(bool fromGrayItems)
+{
+    ParallelMarker marker(engine, gcThreads);
+    for (int i = 1; i < gcThreads; ++i)
+        gcThreadPool->start([&marker, i]() { marker.run(i); });
+
+    // The roots can only be collected on the engine thread. The workers wait for the engine
+    // thread to hand out work.
+    MarkStack *markStack = marker.markStack(0);
+    collectRoots(markStack);
+    if (fromGrayItems) {
+        blockAllocator.collectGrayItems(markStack);
+        hugeItemAllocator.collectGrayItems(markStack);
+        icAllocator.collectGrayItems(markStack);
+    }
+    marker.run(0);
+    gcThreadPool->waitForDone();
+
+    statistics.threads.resize(gcThreads);
+    for (int i = 0; i < gcThreads; ++i) {
+        const ParallelMarker::Thread &t = marker.threads[i];
+        const qint64 markTime = t.busyTime / 1000;
+        GCThreadStatistics &threadStats = statistics.threads[i];
+        threadStats.markTime += markTime;
+        threadStats.markedObjects += t.markStack->markedObjects();
+        if (gcCollectorStats) {
+            qDebug(lcGcAllocatorStats) << "   GC thread" << i << "marked"
+                                       << t.markStack->markedObjects() << "objects in"
+                                       << markTime << "us";
+        }
+    }
+    // dtors of the mark stacks add up the marked objects
+}
+
 void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
+{
+    sweepWeakReferences(lastSweep);
+
+    if (!lastSweep) {
+        engine->identifierTable->sweep();
+        // The shared lookup cache doesn't mark the internal classes it refers to.
+        engine->megamorphicLookupCache->clear();
+        if (gcThreads > 1) {
+            std::vector<qint64> threadTimes(gcThreads, 0);
+            blockAllocator.sweep(gcThreadPool.get(), gcThreads, threadTimes.data());
+            statistics.threads.resize(gcThreads);
+            for (int i = 0; i < gcThreads; ++i) {
+                statistics.threads[i].sweepTime += threadTimes[i] / 1000;
+                if (gcCollectorStats) {
+                    qDebug(lcGcAllocatorStats) << "   GC thread" << i << "swept chunks in"
+                                               << threadTimes[i] / 1000 << "us";
+                }
+            }
+        } else {
+            blockAllocator.sweep(/*classCountPtr*/);
+        }
+        hugeItemAllocator.sweep(classCountPtr);
+        icAllocator.sweep(/*classCountPtr*/);
+    }
+}
+
+void MemoryManager::sweepWeakReferences(bool lastSweep)
 {
     for (PersistentValueStorage::Iterator it = m_weakValues->begin(); it != m_weakValues->end(); ++it) {
         Managed *m = (*it).managed();
@@ -962,14 +1450,6 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
                 ++it;
         }
     }
-
-
-    if (!lastSweep) {
-        engine->identifierTable->sweep();
-        blockAllocator.sweep(/*classCountPtr*/);
-        hugeItemAllocator.sweep(classCountPtr);
-        icAllocator.sweep(/*classCountPtr*/);
-    }
 }
 
 bool MemoryManager::shouldRunGC() const
@@ -1019,11 +1499,28 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    // A full collection supersedes an incremental one. Marking progress can be dropped, but
+    // once sweeping has started it has to be completed before we can mark again.
+    if (gcState == GCState::Marking)
+        abortGC();
+    else if (gcState == GCState::Sweeping)
+        finishIncrementalSweep();
+
     if (gcStats) {
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
     }
 
+    // A full collection has to trace the old objects, too.
+    if (generationalGC) {
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        icAllocator.resetBlackBits();
+    }
+
     if (!gcCollectorStats) {
         mark();
         sweep();
@@ -1104,10 +1601,19 @@ void MemoryManager::runGC()
         qDebug(stats) << "======== End GC ========";
     }
 
+    finishGC();
+
+    ++statistics.gcCycles;
+    statistics.maxPauseTime = qMax(statistics.maxPauseTime, pauseTimer.nsecsElapsed() / 1000);
+}
+
+void MemoryManager::finishGC()
+{
     if (gcStats)
         statistics.maxUsedMem = qMax(statistics.maxUsedMem, getUsedMem() + getLargeItemsMem());
 
-    if (aggressiveGC) {
+    // An incremental cycle doesn't reclaim the unused tails of chunks it added while sweeping.
+    if (aggressiveGC && !incrementalGC) {
         // ensure we don't 'loose' any memory
         Q_ASSERT(blockAllocator.allocatedMem()
                  == blockAllocator.usedMem() + dumpBins(&blockAllocator, nullptr));
@@ -1116,6 +1622,11 @@ void MemoryManager::runGC()
     }
 
     usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    nurseryUsage = 0;
+
+    // With generational GC the survivors stay black, they are old now.
+    if (generationalGC)
+        return;
 
     // reset all black bits
     blockAllocator.resetBlackBits();
@@ -1123,6 +1634,277 @@ void MemoryManager::runGC()
     icAllocator.resetBlackBits();
 }
 
+bool MemoryManager::setIncrementalGC(bool enabled)
+{
+    if (incrementalGC == enabled)
+        return true;
+
+    if (enabled && !needsWriteBarrier() && jitCodeWithoutWriteBarrier) {
+        qWarning("Cannot enable incremental garbage collection after JIT compiling code");
+        return false;
+    }
+
+    if (enabled)
+        setGenerationalGC(false);
+
+    incrementalGC = enabled;
+    if (!enabled && isGCOngoing())
+        runGC();
+    return true;
+}
+
+bool MemoryManager::setGenerationalGC(bool enabled)
+{
+    if (generationalGC == enabled)
+        return true;
+
+    if (enabled && !needsWriteBarrier() && jitCodeWithoutWriteBarrier) {
+        qWarning("Cannot enable generational garbage collection after JIT compiling code");
+        return false;
+    }
+
+    if (enabled) {
+        // All objects are white between two non-generational GCs, i.e. young.
+        setIncrementalGC(false);
+    } else {
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        icAllocator.resetBlackBits();
+    }
+
+    generationalGC = enabled;
+    engine->isGenerationalGC = enabled;
+    return true;
+}
+
+void MemoryManager::setGCThreadCount(int count)
+{
+    count = std::max(count, 1);
+    if (gcThreads == count)
+        return;
+
+    gcThreads = count;
+    if (count == 1) {
+        gcThreadPool.reset();
+        return;
+    }
+
+    if (!gcThreadPool) {
+        gcThreadPool = std::make_unique<QThreadPool>();
+        gcThreadPool->setObjectName(QStringLiteral("QV4 GC"));
+    }
+    gcThreadPool->setMaxThreadCount(count - 1);
+}
+
+// Collects the young objects only. Old objects are black already, so marking stops at them.
+// Young objects referenced from old ones are found through the old objects the write barrier
+// remembered. Those are gray and get rescanned.
+void MemoryManager::runMinorGC()
+{
+    Q_ASSERT(generationalGC);
+    if (gcBlocked)
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    if (gcStats) {
+        statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
+        statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
+    }
+
+    const size_t oldSlots = usedSlotsAfterLastFullSweep;
+    const size_t youngMem = nurseryUsage;
+
+    mark(/*fromGrayItems*/true);
+    sweep();
+    finishGC();
+
+    const size_t promotedMem = usedSlotsAfterLastFullSweep > oldSlots
+            ? (usedSlotsAfterLastFullSweep - oldSlots) * Chunk::SlotSize : 0;
+    statistics.youngMem += youngMem;
+    statistics.promotedMem += promotedMem;
+    ++statistics.minorGCCycles;
+    const qint64 pauseTime = pauseTimer.nsecsElapsed() / 1000;
+    statistics.maxPauseTime = qMax(statistics.maxPauseTime, pauseTime);
+
+    if (gcCollectorStats) {
+        qDebug(lcGcAllocatorStats) << "Minor GC:" << markStackSize << "objects marked,"
+                                   << promotedMem << "of" << youngMem << "bytes promoted in"
+                                   << pauseTime << "us";
+    }
+}
+
+// Runs one step of an incremental garbage collection, starting a new cycle if none is ongoing.
+// A step takes roughly gcTimeSlice milliseconds and always makes some progress. Collecting the
+// roots at the beginning and the end of the marking phase, processing the weak references and
+// sweeping the huge items and internal classes can't be interrupted, though.
+void MemoryManager::runGCStep()
+{
+    if (gcBlocked)
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+    const QDeadlineTimer deadline(gcTimeSlice, Qt::PreciseTimer);
+
+    if (gcState == GCState::Idle)
+        beginIncrementalMark();
+
+    if (gcState == GCState::Marking) {
+        blockAllocator.collectGrayItems(m_markStack.get());
+        hugeItemAllocator.collectGrayItems(m_markStack.get());
+        icAllocator.collectGrayItems(m_markStack.get());
+        // If we ran out of time just as the last object got marked, the remark is left for
+        // the next step. That one then finds an empty mark stack.
+        if (m_markStack->isEmpty()
+                || (m_markStack->drain(deadline) == MarkStack::DrainState::Complete
+                    && !deadline.hasExpired())) {
+            finishIncrementalMark();
+            beginIncrementalSweep();
+        }
+    }
+
+    if (gcState == GCState::Sweeping) {
+        // sweep at least one chunk per step, so that we make progress with any time slice
+        do {
+            if (!blockAllocator.sweepChunk()) {
+                finishIncrementalSweep();
+                break;
+            }
+        } while (!deadline.hasExpired());
+    }
+
+    ++statistics.gcSteps;
+    statistics.maxPauseTime = qMax(statistics.maxPauseTime, pauseTimer.nsecsElapsed() / 1000);
+
+    if (gcState != GCState::Idle)
+        scheduleGCStep();
+}
+
+void MemoryManager::beginIncrementalMark()
+{
+    Q_ASSERT(gcState == GCState::Idle);
+
+    if (gcStats) {
+        statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
+        statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
+    }
+
+    markStackSize = 0;
+    m_markStack = std::make_unique<MarkStack>(engine);
+    gcState = GCState::Marking;
+    engine->isGCOngoing = true;
+
+    // Everything reachable from here on is kept alive by the write barrier, see shade().
+    collectRoots(m_markStack.get());
+}
+
+void MemoryManager::finishIncrementalMark()
+{
+    Q_ASSERT(gcState == GCState::Marking);
+
+    // The JS stack, the persistent values and the C++ side of the engine are not covered by
+    // the write barrier. Rescan them and complete the marking in one go.
+    collectRoots(m_markStack.get());
+    blockAllocator.collectGrayItems(m_markStack.get());
+    hugeItemAllocator.collectGrayItems(m_markStack.get());
+    icAllocator.collectGrayItems(m_markStack.get());
+    m_markStack.reset(); // dtor of MarkStack drains
+    engine->isGCOngoing = false;
+}
+
+// InternalClass transitions are weak. Unlink the dead classes from their live parents before
+// the heap is swept incrementally, so that the mutator can't pick them up again in between.
+static void unlinkDeadInternalClasses(const std::vector<Chunk *> &chunks)
+{
+    for (Chunk *c : chunks) {
+        HeapItem *o = c->realBase();
+        for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+            quintptr dead = c->objectBitmap[i] & ~c->blackBitmap[i];
+            while (dead) {
+                uint index = qCountTrailingZeroBits(dead);
+                dead ^= (static_cast<quintptr>(1) << index);
+                Heap::Base *b = *(o + index);
+                static_cast<Heap::InternalClass *>(b)->unlinkFromParent();
+            }
+            o += Chunk::Bits;
+        }
+    }
+}
+
+void MemoryManager::beginIncrementalSweep()
+{
+    Q_ASSERT(gcState == GCState::Marking);
+    gcState = GCState::Sweeping;
+
+    sweepWeakReferences(false);
+    engine->identifierTable->sweep();
+    // The shared lookup cache doesn't mark the internal classes it refers to.
+    engine->megamorphicLookupCache->clear();
+    unlinkDeadInternalClasses(icAllocator.chunks);
+
+    // Dead objects still need their internal classes when being destroyed. Therefore those
+    // are only swept after all the chunks of the block allocator are done.
+    blockAllocator.beginSweep();
+}
+
+void MemoryManager::finishIncrementalSweep()
+{
+    Q_ASSERT(gcState == GCState::Sweeping);
+
+    while (blockAllocator.sweepChunk()) {}
+    hugeItemAllocator.sweep(nullptr);
+    icAllocator.sweep();
+    // only free the chunks at the end to avoid that the sweep() calls indirectly
+    // access freed memory
+    blockAllocator.endSweep();
+
+    gcState = GCState::Idle;
+    ++statistics.gcCycles;
+    finishGC();
+}
+
+void MemoryManager::scheduleGCStep()
+{
+    // Give the event loop a chance to run between two steps. Without a QJSEngine (or when
+    // there is no event loop) the remaining steps are triggered by allocations.
+    QJSEngine *jsEngine = engine->jsEngine();
+    if (gcStepScheduled || !jsEngine)
+        return;
+
+    gcStepScheduled = true;
+    QMetaObject::invokeMethod(jsEngine, [this]() {
+        gcStepScheduled = false;
+        if (isGCOngoing())
+            runGCStep();
+    }, Qt::QueuedConnection);
+}
+
+void MemoryManager::abortGC()
+{
+    if (m_markStack) {
+        m_markStack->discard();
+        m_markStack.reset();
+    }
+    engine->isGCOngoing = false;
+
+    // Chunks that are not swept yet, or turned out to be empty, are still owned by the
+    // allocator and get cleaned up like any other.
+    blockAllocator.emptyChunks.clear();
+    blockAllocator.nChunksToSweep = 0;
+    blockAllocator.nextChunkToSweep = 0;
+
+    gcState = GCState::Idle;
+    blockAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
+    icAllocator.resetBlackBits();
+}
+
 size_t MemoryManager::getUsedMem() const
 {
     return blockAllocator.usedMem() + icAllocator.usedMem();
@@ -1152,6 +1934,10 @@ void MemoryManager::registerWeakSet(Heap::SetObject *set)
 
 MemoryManager::~MemoryManager()
 {
+    // Parts of the engine are gone already. Don't try to complete an incremental cycle.
+    if (isGCOngoing())
+        abortGC();
+
     delete m_persistentValues;
 
     dumpStats();
@@ -1183,6 +1969,20 @@ void MemoryManager::dumpStats() const
     for (int i = 1; i < BlockAllocator::NumBins - 1; ++i)
         qDebug(stats) << "     <" << (i << Chunk::SlotSizeShift) << " bytes: " << statistics.allocations[i];
     qDebug(stats) << "     >=" << ((BlockAllocator::NumBins - 1) << Chunk::SlotSizeShift) << " bytes: " << statistics.allocations[BlockAllocator::NumBins - 1];
+    qDebug(stats) << "GC cycles:" << statistics.gcCycles << (incrementalGC ? "(incremental)" : "");
+    qDebug(stats) << "Incremental GC steps:" << statistics.gcSteps;
+    qDebug(stats) << "Minor GC cycles:" << statistics.minorGCCycles;
+    if (statistics.youngMem) {
+        qDebug(stats) << "Promotion rate:"
+                      << (100. * statistics.promotedMem / statistics.youngMem) << "%";
+    }
+    for (size_t i = 0; i < statistics.threads.size(); ++i) {
+        const GCThreadStatistics &threadStats = statistics.threads[i];
+        qDebug(stats) << "GC thread" << i << ":" << threadStats.markedObjects << "objects marked,"
+                      << threadStats.markTime << "us marking," << threadStats.sweepTime
+                      << "us sweeping";
+    }
+    qDebug(stats) << "Longest GC pause:" << statistics.maxPauseTime << "us";
 }
 
 void MemoryManager::collectFromJSStack(MarkStack *markStack) const
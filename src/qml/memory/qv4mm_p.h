@@ -22,14 +22,23 @@
 #include <private/qv4mmdefs_p.h>
 #include <QVector>
 
+#include <memory>
+
 #define QV4_MM_MAXBLOCK_SHIFT "QV4_MM_MAXBLOCK_SHIFT"
 #define QV4_MM_MAX_CHUNK_SIZE "QV4_MM_MAX_CHUNK_SIZE"
 #define QV4_MM_STATS "QV4_MM_STATS"
+#define QV4_MM_INCREMENTAL_GC "QV4_MM_INCREMENTAL_GC"
+#define QV4_MM_GC_TIMESLICE "QV4_MM_GC_TIMESLICE"
+#define QV4_MM_GENERATIONAL_GC "QV4_MM_GENERATIONAL_GC"
+#define QV4_MM_NURSERY_SIZE "QV4_MM_NURSERY_SIZE"
+#define QV4_MM_GC_THREADS "QV4_MM_GC_THREADS"
 
 #define MM_DEBUG 0
 
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
+
 namespace QV4 {
 
 struct ChunkAllocator;
@@ -65,10 +74,20 @@ struct BlockAllocator {
     }
 
     void sweep();
+    // Sweeps the chunks on nThreads threads, the engine thread and nThreads - 1 threads of the
+    // pool. Adds the time each thread spent to threadTimes (in ns).
+    void sweep(QThreadPool *pool, int nThreads, qint64 *threadTimes);
     void freeAll();
     void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
 
+    // Incremental sweeping: beginSweep() drops all free lists, sweepChunk() sweeps one of the
+    // chunks that existed at that time and makes its free slots available again, endSweep()
+    // releases the chunks that turned out to be empty.
+    void beginSweep();
+    bool sweepChunk();
+    void endSweep();
+
     // bump allocations
     HeapItem *nextFree = nullptr;
     size_t nFree = 0;
@@ -77,6 +96,9 @@ struct BlockAllocator {
     ChunkAllocator *chunkAllocator;
     ExecutionEngine *engine;
     std::vector<Chunk *> chunks;
+    std::vector<Chunk *> emptyChunks;
+    size_t nChunksToSweep = 0;
+    size_t nextChunkToSweep = 0;
     uint *allocationStats = nullptr;
 };
 
@@ -221,6 +243,38 @@ public:
 
     void runGC();
 
+    // Incremental GC: marking and sweeping are split into steps of at most gcTimeSlice
+    // milliseconds. Steps are triggered by allocations and from the event loop.
+    enum class GCState {
+        Idle,
+        Marking,
+        Sweeping
+    };
+
+    bool setIncrementalGC(bool enabled);
+    bool isIncrementalGC() const { return incrementalGC; }
+    bool isGCOngoing() const { return gcState != GCState::Idle; }
+    void runGCStep();
+
+    // Generational GC: objects surviving a GC keep their mark bit and are considered old. Minor
+    // GCs run whenever nurserySize bytes have been allocated, and only trace and free young
+    // objects. Old objects are reclaimed by a full GC, triggered by heap growth as usual.
+    // Generational and incremental collection are mutually exclusive.
+    bool setGenerationalGC(bool enabled);
+    bool isGenerationalGC() const { return generationalGC; }
+    void runMinorGC();
+
+    // Parallel GC: marking and sweeping of the block allocator's chunks are shared between the
+    // engine thread and count - 1 worker threads. A count of 1 disables it.
+    void setGCThreadCount(int count);
+    int gcThreadCount() const { return gcThreads; }
+
+    // JIT compiled code has to call the write barrier when storing to locals. Whether it does
+    // is decided when compiling, so once code without the barrier exists, neither incremental
+    // nor generational GC can be enabled anymore. Enabling them returns false then.
+    bool needsWriteBarrier() const { return incrementalGC || generationalGC; }
+    void jitCodeLinked() { jitCodeWithoutWriteBarrier |= !needsWriteBarrier(); }
+
     void dumpStats() const;
 
     size_t getUsedMem() const;
@@ -235,6 +289,8 @@ public:
     typename ManagedType::Data *allocIC()
     {
         Heap::Base *b = *allocate(&icAllocator, align(sizeof(typename ManagedType::Data)));
+        if (allocateBlack())
+            b->setMarkBit();
         return static_cast<typename ManagedType::Data *>(b);
     }
 
@@ -253,24 +309,50 @@ private:
     };
 
     void collectFromJSStack(MarkStack *markStack) const;
-    void mark();
+    void mark(bool fromGrayItems = false);
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
+    void sweepWeakReferences(bool lastSweep);
     bool shouldRunGC() const;
     void collectRoots(MarkStack *markStack);
+    void markInParallel(bool fromGrayItems);
+
+    void triggerGC()
+    {
+        if (incrementalGC)
+            runGCStep();
+        else
+            runGC();
+    }
+    void beginIncrementalMark();
+    void finishIncrementalMark();
+    void beginIncrementalSweep();
+    void finishIncrementalSweep();
+    void finishGC();
+    void scheduleGCStep();
+    void abortGC();
+
+    // Objects allocated while a GC cycle is in progress survive it.
+    bool allocateBlack() const { return gcBlocked || gcState != GCState::Idle; }
 
     HeapItem *allocate(BlockAllocator *allocator, std::size_t size)
     {
         bool didGCRun = false;
         if (aggressiveGC) {
-            runGC();
+            triggerGC();
+            didGCRun = true;
+        } else if (Q_UNLIKELY(generationalGC) && nurseryUsage > nurserySize) {
+            runMinorGC();
             didGCRun = true;
         }
 
         if (unmanagedHeapSize > unmanagedHeapSizeGCLimit) {
             if (!didGCRun)
-                runGC();
+                triggerGC();
 
-            if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
+            // While an incremental cycle is running, nothing has been freed yet.
+            if (isGCOngoing()) {
+                // adjust the limit once the cycle is done
+            } else if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
                 // more than 75% full, raise limit
                 unmanagedHeapSizeGCLimit = std::max(unmanagedHeapSizeGCLimit,
                                                     unmanagedHeapSize) * 2;
@@ -285,11 +367,13 @@ private:
         if (size > Chunk::DataSize)
             return hugeItemAllocator.allocate(size);
 
+        nurseryUsage += size;
+
         if (HeapItem *m = allocator->allocate(size))
             return m;
 
-        if (!didGCRun && shouldRunGC())
-            runGC();
+        if (!didGCRun && (isGCOngoing() || shouldRunGC()))
+            triggerGC();
 
         return allocator->allocate(size, true);
     }
@@ -305,6 +389,7 @@ public:
     QVector<Value *> m_pendingFreedObjectWrapperValue;
     Heap::MapObject *weakMaps = nullptr;
     Heap::SetObject *weakSets = nullptr;
+    std::unique_ptr<MarkStack> m_markStack; // only set while marking incrementally
 
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
@@ -314,6 +399,22 @@ public:
     bool aggressiveGC = false;
     bool gcStats = false;
     bool gcCollectorStats = false;
+    bool incrementalGC = false;
+    bool gcStepScheduled = false;
+    GCState gcState = GCState::Idle;
+    int gcTimeSlice = 2; // in ms
+    bool generationalGC = false;
+    bool jitCodeWithoutWriteBarrier = false;
+    std::size_t nurserySize = 2 * 1024 * 1024;
+    std::size_t nurseryUsage = 0; // bytes allocated in the block allocator since the last GC
+    int gcThreads = 1;
+    std::unique_ptr<QThreadPool> gcThreadPool;
+
+    struct GCThreadStatistics {
+        qint64 markTime = 0; // in us
+        qint64 sweepTime = 0; // in us
+        quint64 markedObjects = 0;
+    };
 
     int allocationCount = 0;
     size_t lastAllocRequestedSlots = 0;
@@ -323,6 +424,13 @@ public:
         size_t maxAllocatedMem = 0;
         size_t maxUsedMem = 0;
         uint allocations[BlockAllocator::NumBins];
+        qint64 maxPauseTime = 0; // in us, longest time the mutator was blocked by the GC
+        uint gcCycles = 0;
+        uint gcSteps = 0;
+        uint minorGCCycles = 0;
+        size_t youngMem = 0; // bytes allocated before minor GCs
+        size_t promotedMem = 0; // bytes surviving minor GCs
+        std::vector<GCThreadStatistics> threads; // one entry per GC thread, if parallel
     } statistics;
 };
 
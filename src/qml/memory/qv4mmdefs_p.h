@@ -18,6 +18,8 @@
 #include <private/qv4runtimeapi_p.h>
 #include <QtCore/qalgorithms.h>
 #include <QtCore/qmath.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qbasicatomic.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -99,6 +101,11 @@ struct Chunk {
         quintptr bit = bitForIndex(index);
         *bitmap &= ~bit;
     }
+    // For marking from several threads. Returns false if the bit was set already.
+    static bool testAndSetBit(quintptr *bitmapEntry, quintptr bit) {
+        auto *entry = reinterpret_cast<QBasicAtomicInteger<quintptr> *>(bitmapEntry);
+        return !(entry->fetchAndOrRelaxed(bit) & bit);
+    }
     static bool testBit(quintptr *bitmap, size_t index) {
 //        Q_ASSERT(index >= HeaderSize/SlotSize && index < ChunkSize/SlotSize);
         bitmap += bitmapIndex(index);
@@ -156,6 +163,10 @@ struct Chunk {
     bool sweep(ExecutionEngine *engine);
     void freeAll(ExecutionEngine *engine);
 
+    // sweep() in two passes. Only the second one can run on a GC worker thread.
+    void destroyDeadObjects();
+    bool sweepBitmaps(uint *freedSlots);
+
     void sortIntoBins(HeapItem **bins, uint nBins);
 };
 
@@ -234,9 +245,14 @@ Q_STATIC_ASSERT(sizeof(HeapItem) == Chunk::SlotSize);
 Q_STATIC_ASSERT(QT_POINTER_SIZE*8 == Chunk::Bits);
 Q_STATIC_ASSERT((1 << Chunk::BitShift) == Chunk::Bits);
 
+struct ParallelMarker;
+
 struct Q_QML_PRIVATE_EXPORT MarkStack {
     MarkStack(ExecutionEngine *engine);
-    ~MarkStack() { drain(); }
+    // A mark stack of one of the threads marking in parallel, see ParallelMarker in qv4mm.cpp.
+    MarkStack(ExecutionEngine *engine, ParallelMarker *marker, int thread,
+              Heap::Base **base, size_t size);
+    ~MarkStack();
 
     void push(Heap::Base *m) {
         *(m_top++) = m;
@@ -258,10 +274,20 @@ struct Q_QML_PRIVATE_EXPORT MarkStack {
     }
 
     ExecutionEngine *engine() const { return m_engine; }
+    bool isParallel() const { return m_marker != nullptr; }
+    uint markedObjects() const { return m_markedObjects; }
+
+    enum class DrainState { Ongoing, Complete };
+    DrainState drain(QDeadlineTimer deadline);
+    bool isEmpty() const { return m_top == m_base; }
+    void discard() { m_top = m_base; }
 
 private:
     Heap::Base *pop() { return *(--m_top); }
     void drain();
+    void markParallel(Heap::Base *h);
+
+    friend struct ParallelMarker;
 
     Heap::Base **m_top = nullptr;
     Heap::Base **m_base = nullptr;
@@ -269,6 +295,9 @@ private:
     Heap::Base **m_hardLimit = nullptr;
     ExecutionEngine *m_engine = nullptr;
     quintptr m_drainRecursion = 0;
+    ParallelMarker *m_marker = nullptr;
+    int m_thread = 0;
+    uint m_markedObjects = 0;
 };
 
 // Some helper to automate the generation of our
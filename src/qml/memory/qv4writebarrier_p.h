@@ -15,10 +15,11 @@
 //
 
 #include <private/qv4global_p.h>
+#include <private/qv4enginebase_p.h>
 
 QT_BEGIN_NAMESPACE
 
-#define WRITEBARRIER_none 1
+#define WRITEBARRIER_incremental 1
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
@@ -39,26 +40,49 @@ enum NewValueType {
 };
 
 // ### this needs to be filled with a real memory fence once marking is concurrent
+// (incremental marking runs on the engine thread and doesn't need one)
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(incremental)
+
+// While the memory manager is marking incrementally, the mutator can run between two
+// marking steps. We then shade both the value being overwritten (Yuasa deletion barrier,
+// keeps everything reachable at the start of the cycle alive) and the value being written
+// (Dijkstra insertion barrier, catches objects resurrected through weak references).
+// Otherwise, and unless generational collection is enabled, the barrier only costs two
+// predictable branches.
+Q_QML_EXPORT void shade(EngineBase *engine, ReturnedValue oldValue, ReturnedValue newValue);
+Q_QML_EXPORT void shade(EngineBase *engine, Heap::Base *oldValue, Heap::Base *newValue);
+
+// With generational collection, old objects are not traced by a minor GC. An old object that
+// gets a reference to a young one is remembered (grayed), so that the next minor GC rescans it.
+Q_QML_EXPORT void remember(Heap::Base *base, ReturnedValue value);
+Q_QML_EXPORT void remember(Heap::Base *base, Heap::Base *value);
+
+// For heap items that are only referenced from C++ data shared between other heap items, like
+// the property tables of internal classes. newValue replaces oldValue and is kept alive like it.
+Q_QML_EXPORT void replace(EngineBase *engine, Heap::Base *oldValue, Heap::Base *newValue);
 
 template <NewValueType type>
 static constexpr inline bool isRequired() {
-    return false;
+    return true;
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, ReturnedValue *slot, ReturnedValue value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
+    if (Q_UNLIKELY(engine->isGCOngoing))
+        shade(engine, *slot, value);
+    else if (Q_UNLIKELY(engine->isGenerationalGC))
+        remember(base, value);
     *slot = value;
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
+    if (Q_UNLIKELY(engine->isGCOngoing))
+        shade(engine, *slot, value);
+    else if (Q_UNLIKELY(engine->isGenerationalGC))
+        remember(base, value);
     *slot = value;
 }
 
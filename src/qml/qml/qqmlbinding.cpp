@@ -6,6 +6,7 @@
 #include "qqmlcontext.h"
 #include "qqmldata_p.h"
 
+#include <private/qqmlbindingbatch_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 
@@ -140,12 +141,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        const QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        reportBindingLoop();
         return;
     }
     setUpdatingFlag(true);
@@ -167,6 +163,16 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
         setUpdatingFlag(false);
 }
 
+void QQmlBinding::reportBindingLoop() const
+{
+    const QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 QV4::ReturnedValue QQmlBinding::evaluate(bool *isUndefined)
 {
     QV4::ExecutionEngine *v4 = engine()->handle();
@@ -600,7 +606,11 @@ QVariant QQmlBinding::evaluate()
 
 void QQmlBinding::expressionChanged()
 {
-    update();
+    QQmlEngine *qmlEngine = engine();
+    if (qmlEngine && QQmlEnginePrivate::get(qmlEngine)->batchBindingUpdates)
+        QQmlBindingBatch::invalidate(this);
+    else
+        update();
 }
 
 void QQmlBinding::refresh()
@@ -33,6 +33,7 @@ class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
     friend class QQmlAbstractBinding;
+    friend class QQmlBindingBatch;
 public:
     typedef QExplicitlySharedDataPointer<QQmlBinding> Ptr;
 
@@ -127,7 +128,15 @@ private:
 
     QQmlSourceLocation *m_sourceLocation = nullptr; // used for Qt.binding() created functions
     QV4::PersistentValue m_boundFunction; // used for Qt.binding() that are created from a bound function object
+
+    // used by QQmlBindingBatch
+    quint32 m_batchLevel = 0;
+    quint32 m_batchPass = 0;
+    quint16 m_batchEvaluations = 0;
+    bool m_batchQueued = false;
+
     void handleWriteError(const void *result, QMetaType resultType, QMetaType metaType);
+    void reportBindingLoop() const;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,89 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlbindingbatch_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_CONSTINIT thread_local int QQmlBindingBatch::s_depth = 0;
+Q_CONSTINIT thread_local bool QQmlBindingBatch::s_pending = false;
+
+QQmlBindingBatch &QQmlBindingBatch::instance()
+{
+    static thread_local QQmlBindingBatch batch;
+    return batch;
+}
+
+void QQmlBindingBatch::invalidate(QQmlBinding *binding)
+{
+    // A binding that invalidates itself reports a binding loop, as it does without batching.
+    if (binding->updatingFlag()) {
+        binding->update();
+        return;
+    }
+
+    QQmlBindingBatch &batch = instance();
+
+    bool levelChanged = false;
+    if (batch.current && binding->m_batchLevel <= batch.current->m_batchLevel) {
+        binding->m_batchLevel = batch.current->m_batchLevel + 1;
+        levelChanged = true;
+    }
+
+    if (binding->m_batchPass != batch.pass) {
+        binding->m_batchPass = batch.pass;
+        binding->m_batchEvaluations = 0;
+    } else if (binding->m_batchEvaluations >= MaxEvaluations) {
+        binding->reportBindingLoop();
+        return;
+    }
+
+    // An entry with an outdated level is skipped when it comes up.
+    if (binding->m_batchQueued && !levelChanged)
+        return;
+
+    binding->m_batchQueued = true;
+    // The queue is a min-heap of levels.
+    batch.queue.push_back({ binding->m_batchLevel, QQmlBinding::Ptr(binding) });
+    std::push_heap(batch.queue.begin(), batch.queue.end(), isDeeper);
+
+    if (batch.flushing)
+        return;
+
+    s_pending = true;
+    if (s_depth == 0)
+        flush();
+}
+
+void QQmlBindingBatch::flush()
+{
+    QQmlBindingBatch &batch = instance();
+    Q_ASSERT(!batch.flushing);
+
+    s_pending = false;
+    batch.flushing = true;
+    while (!batch.queue.empty()) {
+        std::pop_heap(batch.queue.begin(), batch.queue.end(), isDeeper);
+        const Entry entry = std::move(batch.queue.back());
+        batch.queue.pop_back();
+
+        QQmlBinding *binding = entry.binding.data();
+        if (!binding->m_batchQueued || entry.level != binding->m_batchLevel)
+            continue;
+
+        binding->m_batchQueued = false;
+        ++binding->m_batchEvaluations;
+        if (!binding->isAddedToObject())
+            continue;
+
+        QQmlBinding *previous = std::exchange(batch.current, binding);
+        binding->update();
+        batch.current = previous;
+    }
+    batch.flushing = false;
+    ++batch.pass;
+}
+
+QT_END_NAMESPACE
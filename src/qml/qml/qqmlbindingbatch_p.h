@@ -0,0 +1,77 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLBINDINGBATCH_P_H
+#define QQMLBINDINGBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlbinding_p.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+// Used by engines that batch binding updates. Instead of evaluating a binding as soon as one of
+// its dependencies changes, the binding is queued, and all queued bindings are evaluated once the
+// outermost change notification has been delivered. A binding invalidated by the evaluation of
+// another one is placed on a deeper level than that one, and the queue is evaluated level by
+// level. The levels are kept across updates, so that once a dependency graph has been updated,
+// each binding in it is evaluated once per change, after all the bindings it depends on.
+class QQmlBindingBatch
+{
+    Q_DISABLE_COPY_MOVE(QQmlBindingBatch)
+public:
+    // Change notifications are delivered within a scope. Leaving the outermost one evaluates the
+    // bindings invalidated by them.
+    class NotifyScope
+    {
+        Q_DISABLE_COPY_MOVE(NotifyScope)
+    public:
+        NotifyScope() { ++s_depth; }
+        ~NotifyScope()
+        {
+            if (--s_depth == 0 && s_pending)
+                flush();
+        }
+    };
+
+    static void invalidate(QQmlBinding *binding);
+
+private:
+    struct Entry
+    {
+        quint32 level;
+        QQmlBinding::Ptr binding;
+    };
+
+    // Evaluating a binding that often per update means it depends on itself.
+    static constexpr quint16 MaxEvaluations = 64;
+
+    QQmlBindingBatch() = default;
+
+    static bool isDeeper(const Entry &a, const Entry &b) { return a.level > b.level; }
+    static QQmlBindingBatch &instance();
+    static void flush();
+
+    static thread_local int s_depth;
+    static thread_local bool s_pending;
+
+    std::vector<Entry> queue;
+    QQmlBinding *current = nullptr;
+    quint32 pass = 0;
+    bool flushing = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLBINDINGBATCH_P_H
@@ -40,6 +40,7 @@ class QQmlNotifier;
 class QQmlDataExtended;
 class QQmlNotifierEndpoint;
 class QQmlPropertyObserver;
+class QQmlBoundSignalExpression;
 
 namespace QV4 {
 class ExecutableCompilationUnit;
@@ -126,9 +127,21 @@ public:
     struct NotifyList {
         QAtomicInteger<quint64> connectionMask;
         QQmlNotifierEndpoint *todo = nullptr;
+        // Only covers the signals from the lowest to the highest connected one. Objects
+        // created from QML documents are mostly connected to the signals of the properties
+        // declared in QML, which come after all the signals of their C++ base types.
         QQmlNotifierEndpoint**notifies = nullptr;
         quint16 maximumTodoIndex = 0;
+        quint16 minimumTodoIndex = 0xFFFF;
+        quint16 notifiesOffset = 0;
         quint16 notifiesSize = 0;
+
+        QQmlNotifierEndpoint **slot(int index) const
+        {
+            const uint offset = uint(index - notifiesOffset);
+            return offset < notifiesSize ? notifies + offset : nullptr;
+        }
+
         void layout();
     private:
         void layout(QQmlNotifierEndpoint*);
@@ -151,7 +164,7 @@ public:
 
     QQmlAbstractBinding *bindings;
     QQmlBoundSignal *signalHandlers;
-    std::vector<QQmlPropertyObserver> propertyObservers;
+    QQmlPropertyObserver &addPropertyObserver(QQmlBoundSignalExpression *expression);
 
     // Linked list for QQmlContext::contextObjects
     QQmlData *nextContextObject;
@@ -183,8 +196,39 @@ public:
         QQmlRefPointer<QQmlContextData> context;
         Q_DISABLE_COPY(DeferredData);
     };
+
+    // Few objects have deferred properties. Only allocate the list for those.
+    class DeferredDataList
+    {
+        Q_DISABLE_COPY_MOVE(DeferredDataList)
+    public:
+        using List = QVector<DeferredData *>;
+
+        DeferredDataList() = default;
+        ~DeferredDataList() { clear(); }
+
+        bool isEmpty() const { return !list || list->isEmpty(); }
+        qsizetype size() const { return list ? list->size() : 0; }
+        DeferredData *first() const { return list->first(); }
+        DeferredData *last() const { return list->last(); }
+
+        List::iterator begin() { return list ? list->begin() : List::iterator(); }
+        List::iterator end() { return list ? list->end() : List::iterator(); }
+        List::const_iterator begin() const { return list ? list->cbegin() : List::const_iterator(); }
+        List::const_iterator end() const { return list ? list->cend() : List::const_iterator(); }
+        List::reverse_iterator rbegin() { return List::reverse_iterator(end()); }
+        List::reverse_iterator rend() { return List::reverse_iterator(begin()); }
+
+        void append(DeferredData *deferData);
+        List::iterator erase(List::iterator it) { return list->erase(it); }
+        void clear();
+
+    private:
+        List *list = nullptr;
+    };
+
     QQmlRefPointer<QV4::ExecutableCompilationUnit> compilationUnit;
-    QVector<DeferredData *> deferredData;
+    DeferredDataList deferredData;
 
     void deferData(int objectIndex, const QQmlRefPointer<QV4::ExecutableCompilationUnit> &,
                    const QQmlRefPointer<QQmlContextData> &);
@@ -333,13 +377,13 @@ QQmlNotifierEndpoint *QQmlData::notify(int index) const
     if (!list || !isIndexInConnectionMask(list->connectionMask.loadRelaxed(), index))
         return nullptr;
 
-    if (index < list->notifiesSize)
-        return list->notifies[index];
+    if (QQmlNotifierEndpoint **slot = list->slot(index))
+        return *slot;
 
-    if (index <= list->maximumTodoIndex) {
+    if (index <= list->maximumTodoIndex && index >= list->minimumTodoIndex) {
         list->layout();
-        if (index < list->notifiesSize)
-            return list->notifies[index];
+        if (QQmlNotifierEndpoint **slot = list->slot(index))
+            return *slot;
     }
 
     return nullptr;
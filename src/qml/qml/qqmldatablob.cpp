@@ -64,7 +64,7 @@ Create a new QQmlDataBlob for \a url and of the provided \a type.
 */
 QQmlDataBlob::QQmlDataBlob(const QUrl &url, Type type, QQmlTypeLoader *manager)
 : m_typeLoader(manager), m_type(type), m_url(url), m_finalUrl(url), m_redirectCount(0),
-  m_inCallback(false), m_isDone(false)
+  m_inCallback(false), m_isDone(false), m_isCompilingInBackground(false)
 {
     //Set here because we need to get the engine from the manager
     if (const QQmlEngine *qmlEngine = m_typeLoader->engine())
@@ -438,6 +438,50 @@ void QQmlDataBlob::allDependenciesDone()
     m_data.setStatus(QQmlDataBlob::ResolvingDependencies);
 }
 
+/*!
+Hands the work done in backgroundCompile() to a worker thread of the loader. The load
+thread then calls backgroundCompileDone() at some later point, but before the blob could
+possibly be done. If the loader has no worker threads, both are called right away.
+
+May only be called from within dataReceived(). The blob must not be touched from the load
+thread until backgroundCompileDone() is called.
+*/
+void QQmlDataBlob::compileInBackground()
+{
+    ASSERT_CALLBACK();
+
+    // The URL strings are created lazily. Make sure the worker thread only reads them.
+    urlString();
+    finalUrlString();
+
+    if (!m_typeLoader->startBackgroundCompile(this)) {
+        backgroundCompile();
+        backgroundCompileDone();
+    }
+}
+
+/*!
+Does the part of processing the data that doesn't need the loader, another blob or the
+engine, after compileInBackground() was called.  As this runs concurrently with the load
+thread, it may only use the state that was set up for it in dataReceived().  In
+particular it must not call setError() or addDependency().
+
+The default implementation does nothing.
+*/
+void QQmlDataBlob::backgroundCompile()
+{
+}
+
+/*!
+Called in the load thread after backgroundCompile() has returned.  This is again a
+callback in which errors can be set and dependencies added, as in dataReceived().
+
+The default implementation does nothing.
+*/
+void QQmlDataBlob::backgroundCompileDone()
+{
+}
+
 /*!
 Called when the download progress of this blob changes.  \a progress goes
 from 0 to 1.
@@ -119,6 +119,14 @@ protected:
     virtual void dependencyComplete(QQmlDataBlob *);
     virtual void allDependenciesDone();
 
+    // Can be called from within dataReceived()
+    void compileInBackground();
+
+    // Callbacks made in a worker thread of the loader, or in load thread if there is none
+    virtual void backgroundCompile();
+    // Callback made in load thread once backgroundCompile() has returned
+    virtual void backgroundCompileDone();
+
     // Callbacks made in main thread
     virtual void downloadProgressChanged(qreal);
     virtual void completed();
@@ -222,9 +230,10 @@ private:
     // List of QQmlDataBlob's that I am waiting for to complete.
     QVector<QQmlRefPointer<QQmlDataBlob>> m_waitingFor;
 
-    int m_redirectCount:30;
+    int m_redirectCount:29;
     bool m_inCallback:1;
     bool m_isDone:1;
+    bool m_isCompilingInBackground:1;
 };
 
 QT_END_NAMESPACE
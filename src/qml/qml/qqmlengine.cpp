@@ -195,8 +195,76 @@ QQmlImageProviderBase::~QQmlImageProviderBase()
 {
 }
 
+namespace {
+// Counts the memory QQmlData and everything it allocates take, if QML_SHOW_OBJECT_STATS is set,
+// and remembers how it was distributed when it was largest.
+class QQmlObjectStats
+{
+public:
+    enum Kind { Data, BindingBits, NotifyLists, ExtendedData, DeferredData, KindCount };
+
+    static bool isEnabled()
+    {
+        static const bool enabled = qEnvironmentVariableIsSet("QML_SHOW_OBJECT_STATS");
+        return enabled;
+    }
+
+    void add(Kind kind, qint64 bytes, qint64 objects)
+    {
+        QMutexLocker locker(&mutex);
+        current[kind] += bytes;
+        total += bytes;
+        objectCount += objects;
+        if (total > peakTotal) {
+            peakTotal = total;
+            peakObjectCount = objectCount;
+            std::copy(std::begin(current), std::end(current), std::begin(peak));
+        }
+    }
+
+    void print()
+    {
+        static const char *names[KindCount] = {
+            "QQmlData", "binding bits", "notify lists", "extended data", "deferred data"
+        };
+
+        QMutexLocker locker(&mutex);
+        if (!peakObjectCount)
+            return;
+
+        qDebug().nospace() << "QML objects at peak memory use: " << peakObjectCount
+                           << " objects, " << peakTotal << " bytes, "
+                           << double(peakTotal) / peakObjectCount << " bytes per object";
+        for (int kind = 0; kind < KindCount; ++kind) {
+            qDebug().nospace() << "    " << names[kind] << ": " << peak[kind] << " bytes, "
+                               << double(peak[kind]) / peakObjectCount << " bytes per object";
+        }
+    }
+
+private:
+    QMutex mutex;
+    qint64 current[KindCount] = {};
+    qint64 peak[KindCount] = {};
+    qint64 total = 0;
+    qint64 peakTotal = 0;
+    qint64 objectCount = 0;
+    qint64 peakObjectCount = 0;
+};
+
+Q_GLOBAL_STATIC(QQmlObjectStats, objectStats)
+
+void countObjectMemory(QQmlObjectStats::Kind kind, qint64 bytes, qint64 objects = 0)
+{
+    if (QQmlObjectStats::isEnabled())
+        objectStats()->add(kind, bytes, objects);
+}
+}
+
 QQmlEnginePrivate::~QQmlEnginePrivate()
 {
+    if (QQmlObjectStats::isEnabled())
+        objectStats()->print();
+
     if (inProgressCreations)
         qWarning() << QQmlEngine::tr("There are still \"%1\" items in the process of being created at engine destruction.").arg(inProgressCreations);
 
@@ -266,6 +334,7 @@ QQmlData::QQmlData(Ownership ownership)
 {
     memset(bindingBitsValue, 0, sizeof(bindingBitsValue));
     init();
+    countObjectMemory(QQmlObjectStats::Data, sizeof(QQmlData), 1);
 }
 
 QQmlData::~QQmlData()
@@ -482,6 +551,8 @@ void QQmlEnginePrivate::init()
 
     q->handle()->setQmlEngine(q);
 
+    batchBindingUpdates = qEnvironmentVariableIntValue("QML_BATCH_BINDING_UPDATES") > 0;
+
     rootContext = new QQmlContext(q,true);
 }
 
@@ -1128,14 +1199,17 @@ public:
     ~QQmlDataExtended();
 
     QHash<QQmlAttachedPropertiesFunc, QObject *> attachedProperties;
+    std::vector<QQmlPropertyObserver> propertyObservers;
 };
 
 QQmlDataExtended::QQmlDataExtended()
 {
+    countObjectMemory(QQmlObjectStats::ExtendedData, sizeof(QQmlDataExtended));
 }
 
 QQmlDataExtended::~QQmlDataExtended()
 {
+    countObjectMemory(QQmlObjectStats::ExtendedData, -qint64(sizeof(QQmlDataExtended)));
 }
 
 void QQmlData::NotifyList::layout(QQmlNotifierEndpoint *endpoint)
@@ -1155,10 +1229,12 @@ void QQmlData::NotifyList::layout(QQmlNotifierEndpoint *endpoint)
         int index = endpoint->sourceSignal;
         index = qMin(index, 0xFFFF - 1);
 
-        endpoint->next = notifies[index];
+        QQmlNotifierEndpoint **slot = this->slot(index);
+        Q_ASSERT(slot);
+        endpoint->next = *slot;
         if (endpoint->next) endpoint->next->prev = &endpoint->next;
-        endpoint->prev = &notifies[index];
-        notifies[index] = endpoint;
+        endpoint->prev = slot;
+        *slot = endpoint;
 
         endpoint = ep;
     }
@@ -1166,28 +1242,37 @@ void QQmlData::NotifyList::layout(QQmlNotifierEndpoint *endpoint)
 
 void QQmlData::NotifyList::layout()
 {
-    Q_ASSERT(maximumTodoIndex >= notifiesSize);
-
     if (todo) {
-        QQmlNotifierEndpoint **old = notifies;
-        const int reallocSize = (maximumTodoIndex + 1) * sizeof(QQmlNotifierEndpoint*);
-        notifies = (QQmlNotifierEndpoint**)realloc(notifies, reallocSize);
-        const int memsetSize = (maximumTodoIndex - notifiesSize + 1) *
-                               sizeof(QQmlNotifierEndpoint*);
-        memset(notifies + notifiesSize, 0, memsetSize);
-
-        if (notifies != old) {
-            for (int ii = 0; ii < notifiesSize; ++ii)
-                if (notifies[ii])
-                    notifies[ii]->prev = &notifies[ii];
+        int first = minimumTodoIndex;
+        int last = maximumTodoIndex;
+        if (notifiesSize) {
+            first = qMin(first, int(notifiesOffset));
+            last = qMax(last, notifiesOffset + notifiesSize - 1);
         }
+        const int size = last - first + 1;
+        Q_ASSERT(size > notifiesSize);
+
+        QQmlNotifierEndpoint **resized = static_cast<QQmlNotifierEndpoint **>(
+                calloc(size, sizeof(QQmlNotifierEndpoint *)));
+        for (int ii = 0; ii < notifiesSize; ++ii) {
+            QQmlNotifierEndpoint *&head = resized[notifiesOffset - first + ii];
+            head = notifies[ii];
+            if (head)
+                head->prev = &head;
+        }
+        free(notifies);
 
-        notifiesSize = maximumTodoIndex + 1;
+        countObjectMemory(QQmlObjectStats::NotifyLists,
+                          (size - notifiesSize) * qint64(sizeof(QQmlNotifierEndpoint *)));
+        notifies = resized;
+        notifiesOffset = first;
+        notifiesSize = size;
 
         layout(todo);
     }
 
     maximumTodoIndex = 0;
+    minimumTodoIndex = 0xFFFF;
     todo = nullptr;
 }
 
@@ -1225,6 +1310,26 @@ void QQmlData::releaseDeferredData()
             ++it;
         }
     }
+    if (deferredData.isEmpty())
+        deferredData.clear();
+}
+
+void QQmlData::DeferredDataList::append(DeferredData *deferData)
+{
+    if (!list) {
+        list = new List;
+        countObjectMemory(QQmlObjectStats::DeferredData, sizeof(List));
+    }
+    list->append(deferData);
+}
+
+void QQmlData::DeferredDataList::clear()
+{
+    if (list) {
+        countObjectMemory(QQmlObjectStats::DeferredData, -qint64(sizeof(List)));
+        delete list;
+        list = nullptr;
+    }
 }
 
 void QQmlData::addNotify(int index, QQmlNotifierEndpoint *endpoint)
@@ -1235,6 +1340,7 @@ void QQmlData::addNotify(int index, QQmlNotifierEndpoint *endpoint)
 
     if (!list) {
         list = new NotifyList;
+        countObjectMemory(QQmlObjectStats::NotifyLists, sizeof(NotifyList));
         // We don't really care when this change takes effect on other threads. The notifyList can
         // only become non-null once in the life time of a QQmlData. It becomes null again when the
         // underlying QObject is deleted. At that point any interaction with the QQmlData is UB
@@ -1253,13 +1359,14 @@ void QQmlData::addNotify(int index, QQmlNotifierEndpoint *endpoint)
     list->connectionMask.storeRelaxed(
             list->connectionMask.loadRelaxed() | (1ULL << quint64(index % 64)));
 
-    if (index < list->notifiesSize) {
-        endpoint->next = list->notifies[index];
+    if (QQmlNotifierEndpoint **slot = list->slot(index)) {
+        endpoint->next = *slot;
         if (endpoint->next) endpoint->next->prev = &endpoint->next;
-        endpoint->prev = &list->notifies[index];
-        list->notifies[index] = endpoint;
+        endpoint->prev = slot;
+        *slot = endpoint;
     } else {
         list->maximumTodoIndex = qMax(int(list->maximumTodoIndex), index);
+        list->minimumTodoIndex = qMin(int(list->minimumTodoIndex), index);
 
         endpoint->next = list->todo;
         if (endpoint->next) endpoint->next->prev = &endpoint->next;
@@ -1279,6 +1386,8 @@ void QQmlData::disconnectNotifiers(QQmlData::DeleteNotifyList doDelete)
                 ep->disconnect();
         }
         free(list->notifies);
+        countObjectMemory(QQmlObjectStats::NotifyLists,
+                          -qint64(list->notifiesSize * sizeof(QQmlNotifierEndpoint *)));
 
         if (doDelete == DeleteNotifyList::Yes) {
             // We can only get here from QQmlData::destroyed(), and that can only come from the
@@ -1286,12 +1395,15 @@ void QQmlData::disconnectNotifiers(QQmlData::DeleteNotifyList doDelete)
             // without any threads. Therefore, it's enough to apply relaxed semantics.
             notifyList.storeRelaxed(nullptr);
             delete list;
+            countObjectMemory(QQmlObjectStats::NotifyLists, -qint64(sizeof(NotifyList)));
         } else {
             // We can use relaxed semantics here. The worst thing that can happen is that some
             // signal is falsely reported as connected. Signal connectedness across threads
             // is not quite deterministic anyway.
             list->connectionMask.storeRelaxed(0);
             list->maximumTodoIndex = 0;
+            list->minimumTodoIndex = 0xFFFF;
+            list->notifiesOffset = 0;
             list->notifiesSize = 0;
             list->notifies = nullptr;
 
@@ -1305,6 +1417,12 @@ QHash<QQmlAttachedPropertiesFunc, QObject *> *QQmlData::attachedProperties() con
     return &extendedData->attachedProperties;
 }
 
+QQmlPropertyObserver &QQmlData::addPropertyObserver(QQmlBoundSignalExpression *expression)
+{
+    if (!extendedData) extendedData = new QQmlDataExtended;
+    return extendedData->propertyObservers.emplace_back(expression);
+}
+
 void QQmlData::destroyed(QObject *object)
 {
     if (nextContextObject)
@@ -1365,8 +1483,11 @@ void QQmlData::destroyed(QObject *object)
         signalHandler = next;
     }
 
-    if (bindingBitsArraySize > InlineBindingArraySize)
+    if (bindingBitsArraySize > InlineBindingArraySize) {
         free(bindingBits);
+        countObjectMemory(QQmlObjectStats::BindingBits,
+                          -qint64(bindingBitsArraySize * sizeof(BindingBitsType)));
+    }
 
     if (propertyCache)
         propertyCache.reset();
@@ -1388,6 +1509,8 @@ void QQmlData::destroyed(QObject *object)
     // Dispose the handle.
     jsWrapper.clear();
 
+    countObjectMemory(QQmlObjectStats::Data, -qint64(sizeof(QQmlData)), -1);
+
     if (ownMemory)
         delete this;
     else
@@ -1409,8 +1532,12 @@ QQmlData::BindingBitsType *QQmlData::growBits(QObject *obj, int bit)
     memcpy(newBits, bits, bindingBitsArraySize * sizeof(BindingBitsType));
     memset(newBits + bindingBitsArraySize, 0, sizeof(BindingBitsType) * (arraySize - bindingBitsArraySize));
 
-    if (bindingBitsArraySize > InlineBindingArraySize)
+    if (bindingBitsArraySize > InlineBindingArraySize) {
         free(bits);
+        countObjectMemory(QQmlObjectStats::BindingBits,
+                          -qint64(bindingBitsArraySize * sizeof(BindingBitsType)));
+    }
+    countObjectMemory(QQmlObjectStats::BindingBits, arraySize * sizeof(BindingBitsType));
     bindingBits = newBits;
     bits = newBits;
     bindingBitsArraySize = arraySize;
@@ -131,6 +131,7 @@ public:
 #endif
 
     bool outputWarningsToMsgLog = true;
+    bool batchBindingUpdates = false;
 
     // Bindings that have had errors during startup
     QQmlDelayedError *erroredBindings = nullptr;
@@ -1738,6 +1738,22 @@ QStringList QQmlImportDatabase::dynamicPlugins() const
     return QQmlPluginImporter::plugins();
 }
 
+/*!
+    \internal
+
+    Returns the snapshot of previous module lookups for the current import and plugin paths,
+    or \nullptr if snapshots are disabled.
+*/
+QQmlImportSnapshot *QQmlImportDatabase::snapshot()
+{
+    if (!QQmlImportSnapshot::isEnabled() || !engine->handle()->diskCacheEnabled())
+        return nullptr;
+
+    if (!importSnapshot || !importSnapshot->matches(fileImportPath, filePluginPath))
+        importSnapshot = QQmlImportSnapshot::create(fileImportPath, filePluginPath);
+    return importSnapshot.get();
+}
+
 void QQmlImportDatabase::clearDirCache()
 {
     QStringHash<QmldirCache *>::ConstIterator itr = qmldirCache.constBegin();
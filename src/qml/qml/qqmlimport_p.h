@@ -17,6 +17,7 @@
 #include <private/qstringhash_p.h>
 #include <private/qv4compileddata_p.h>
 #include <private/qfieldlist_p.h>
+#include <private/qqmlimportsnapshot_p.h>
 
 //
 //  W A R N I N G
@@ -305,6 +306,8 @@ public:
     static QTypeRevision lockModule(const QString &uri, const QString &typeNamespace,
                                     QTypeRevision version, QList<QQmlError> *errors);
 
+    QQmlImportSnapshot *snapshot();
+
 private:
     friend class QQmlImports;
     friend class QQmlPluginImporter;
@@ -329,6 +332,8 @@ private:
     QSet<QString> modulesForWhichPluginsHaveBeenLoaded;
     QSet<QString> initializedPlugins;
     QQmlEngine *engine;
+
+    std::unique_ptr<QQmlImportSnapshot> importSnapshot;
 };
 
 template<typename Callback>
@@ -367,6 +372,35 @@ QQmlImportDatabase::LocalQmldirResult QQmlImportDatabase::locateLocalQmldir(
 
     const bool hasInterceptors = !engine->urlInterceptors().isEmpty();
 
+    const auto addToCache = [&](const QString &qmldirFilePath, const QString &qmldirPathUrl) {
+        QmldirCache *cache = new QmldirCache;
+        cache->version = version;
+        cache->qmldirFilePath = qmldirFilePath;
+        cache->qmldirPathUrl = qmldirPathUrl;
+        cache->next = nullptr;
+        if (cacheTail)
+            cacheTail->next = cache;
+        else
+            qmldirCache.insert(uri, cache);
+        cacheTail = cache;
+
+        if (result != QmldirFound)
+            result = callback(qmldirFilePath, qmldirPathUrl) ? QmldirFound : QmldirRejected;
+    };
+
+    // Interceptors can change the result any time, so don't use the snapshot with them.
+    QQmlImportSnapshot *importSnapshot = hasInterceptors ? nullptr : snapshot();
+    QList<QQmlImportSnapshot::QmldirLocation> snapshotLocations;
+    if (importSnapshot && importSnapshot->qmldirLocations(uri, version, &snapshotLocations)) {
+        for (const QQmlImportSnapshot::QmldirLocation &location : std::as_const(snapshotLocations))
+            addToCache(location.filePath, location.pathUrl);
+
+        qCDebug(lcQmlImport)
+                << "locateLocalQmldir:" << qPrintable(uri) << "module's qmldir found at"
+                << snapshotLocations.first().filePath << "in snapshot";
+        return result;
+    }
+
     // Interceptor might redirect remote files to local ones.
     QStringList localImportPaths = importPathList(hasInterceptors ? LocalOrRemote : Local);
 
@@ -406,19 +440,9 @@ QQmlImportDatabase::LocalQmldirResult QQmlImportDatabase::locateLocalQmldir(
                 }
             }
 
-            QmldirCache *cache = new QmldirCache;
-            cache->version = version;
-            cache->qmldirFilePath = qmldirAbsoluteFilePath;
-            cache->qmldirPathUrl = url;
-            cache->next = nullptr;
-            if (cacheTail)
-                cacheTail->next = cache;
-            else
-                qmldirCache.insert(uri, cache);
-            cacheTail = cache;
-
-            if (result != QmldirFound)
-                result = callback(qmldirAbsoluteFilePath, url) ? QmldirFound : QmldirRejected;
+            addToCache(qmldirAbsoluteFilePath, url);
+            if (importSnapshot)
+                snapshotLocations.append({ qmldirAbsoluteFilePath, url });
 
             // Do not return here. Rather, construct the complete cache for this URI.
         }
@@ -444,6 +468,8 @@ QQmlImportDatabase::LocalQmldirResult QQmlImportDatabase::locateLocalQmldir(
         qCDebug(lcQmlImport)
                 << "locateLocalQmldir:" << qPrintable(uri) << "module's qmldir found at"
                 << qmldirAbsoluteFilePath;
+        if (importSnapshot && !snapshotLocations.isEmpty())
+            importSnapshot->addQmldirLocations(uri, version, snapshotLocations);
     }
 
     return result;
@@ -0,0 +1,259 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlimportsnapshot_p.h"
+
+#include <private/qml_compile_hash_p.h>
+#include <private/qqmlimport_p.h>
+#include <private/qv4compileddata_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+
+QT_BEGIN_NAMESPACE
+
+static const char magic[] = "qmlimports";
+static const quint32 formatVersion = 1;
+
+bool QQmlImportSnapshot::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QML_IMPORT_SNAPSHOT") > 0;
+    return enabled;
+}
+
+std::unique_ptr<QQmlImportSnapshot> QQmlImportSnapshot::create(
+        const QStringList &importPaths, const QStringList &pluginPaths)
+{
+    // Applications with different import or plugin paths find different modules.
+    QCryptographicHash fileNameHash(QCryptographicHash::Sha1);
+    fileNameHash.addData(QCoreApplication::applicationFilePath().toUtf8());
+    for (const QStringList *paths : { &importPaths, &pluginPaths }) {
+        fileNameHash.addData(QByteArrayView("\n"));
+        fileNameHash.addData(paths->join(QLatin1Char('\n')).toUtf8());
+    }
+
+    std::unique_ptr<QQmlImportSnapshot> snapshot(new QQmlImportSnapshot(
+            importPaths, pluginPaths,
+            QV4::ExecutableCompilationUnit::localCacheDirectory()
+                    + QString::fromUtf8(fileNameHash.result().toHex())
+                    + QLatin1String(".qmlimports")));
+    snapshot->load();
+    return snapshot;
+}
+
+QQmlImportSnapshot::QQmlImportSnapshot(
+        const QStringList &importPaths, const QStringList &pluginPaths, const QString &filePath)
+    : m_importPaths(importPaths)
+    , m_pluginPaths(pluginPaths)
+    , m_filePath(filePath)
+{
+}
+
+QQmlImportSnapshot::~QQmlImportSnapshot()
+{
+    save();
+}
+
+QQmlImportSnapshot::FileStamp QQmlImportSnapshot::stamp(const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    FileStamp stamp;
+    if (info.exists()) {
+        stamp.size = info.size();
+        stamp.lastModified = info.lastModified().toMSecsSinceEpoch();
+    }
+    return stamp;
+}
+
+QString QQmlImportSnapshot::moduleKey(const QString &uri, QTypeRevision version)
+{
+    return uri + QLatin1Char(' ') + QString::number(version.toEncodedVersion<quint16>());
+}
+
+QString QQmlImportSnapshot::pluginKey(const QString &qmldirPath, const QString &pluginPath,
+                                      const QString &baseName)
+{
+    return qmldirPath + QLatin1Char('\n') + pluginPath + QLatin1Char('\n') + baseName;
+}
+
+QByteArray QQmlImportSnapshot::header() const
+{
+    // Static plugins, resources and type registrations are part of the application binary. If
+    // that changes, anything might have changed.
+    const QString applicationFilePath = QCoreApplication::applicationFilePath();
+    const FileStamp application = stamp(applicationFilePath);
+
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << QByteArray(magic) << formatVersion
+           << QByteArray(QML_COMPILE_HASH, QML_COMPILE_HASH_LENGTH)
+           << applicationFilePath << application.size << application.lastModified
+           << m_importPaths << m_pluginPaths;
+    return header;
+}
+
+void QQmlImportSnapshot::load()
+{
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    uchar *mapped = file.map(0, file.size());
+    if (!mapped)
+        return;
+
+    const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                                    file.size());
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    QByteArray fileHeader;
+    stream >> fileHeader;
+    if (stream.status() != QDataStream::Ok || fileHeader != header()) {
+        qCDebug(lcQmlImport) << "Ignoring outdated import snapshot" << m_filePath;
+        return;
+    }
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        FileStamp fileStamp;
+        stream >> path >> fileStamp.size >> fileStamp.lastModified;
+        m_files.insert(path, fileStamp);
+    }
+
+    stream >> m_qmldirLocations >> m_qmldirContents >> m_pluginFilePaths;
+
+    if (stream.status() != QDataStream::Ok) {
+        qCDebug(lcQmlImport) << "Error reading import snapshot" << m_filePath;
+        m_files.clear();
+        m_qmldirLocations.clear();
+        m_qmldirContents.clear();
+        m_pluginFilePaths.clear();
+        return;
+    }
+
+    qCDebug(lcQmlImport) << "Loaded import snapshot with" << m_qmldirLocations.size()
+                         << "modules from" << m_filePath;
+}
+
+void QQmlImportSnapshot::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_dirty)
+        return;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << header() << quint32(m_files.size());
+    for (auto it = m_files.cbegin(), end = m_files.cend(); it != end; ++it)
+        stream << it.key() << it->size << it->lastModified;
+    stream << m_qmldirLocations << m_qmldirContents << m_pluginFilePaths;
+
+    QString errorString;
+    if (QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+                m_filePath, data.constData(), quint32(data.size()), &errorString)) {
+        m_dirty = false;
+    } else {
+        qCDebug(lcQmlImport) << "Error saving import snapshot" << m_filePath << ":"
+                             << errorString;
+    }
+}
+
+bool QQmlImportSnapshot::isUpToDate(const QString &filePath)
+{
+    auto checked = m_checkedFiles.constFind(filePath);
+    if (checked != m_checkedFiles.constEnd())
+        return *checked;
+
+    const auto recorded = m_files.constFind(filePath);
+    const bool upToDate = recorded != m_files.constEnd() && recorded->size >= 0
+            && *recorded == stamp(filePath);
+    m_checkedFiles.insert(filePath, upToDate);
+    return upToDate;
+}
+
+void QQmlImportSnapshot::record(const QString &filePath)
+{
+    const FileStamp fileStamp = stamp(filePath);
+    m_files.insert(filePath, fileStamp);
+    m_checkedFiles.insert(filePath, fileStamp.size >= 0);
+    m_dirty = true;
+}
+
+/*!
+  \internal
+
+  Returns the qmldir files found for \a uri and \a version in \a locations, in the order
+  QQmlImportDatabase::locateLocalQmldir() found them when they were recorded. Returns false if
+  there are none, or any of them has changed since.
+ */
+bool QQmlImportSnapshot::qmldirLocations(const QString &uri, QTypeRevision version,
+                                         QList<QmldirLocation> *locations)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_qmldirLocations.constFind(moduleKey(uri, version));
+    if (it == m_qmldirLocations.constEnd())
+        return false;
+
+    for (const QmldirLocation &location : *it) {
+        if (!isUpToDate(location.filePath))
+            return false;
+    }
+
+    *locations = *it;
+    return true;
+}
+
+void QQmlImportSnapshot::addQmldirLocations(const QString &uri, QTypeRevision version,
+                                            const QList<QmldirLocation> &locations)
+{
+    QMutexLocker locker(&m_mutex);
+    for (const QmldirLocation &location : locations)
+        record(location.filePath);
+    m_qmldirLocations.insert(moduleKey(uri, version), locations);
+}
+
+bool QQmlImportSnapshot::qmldirContent(const QString &filePath, QString *content)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_qmldirContents.constFind(filePath);
+    if (it == m_qmldirContents.constEnd() || !isUpToDate(filePath))
+        return false;
+
+    *content = *it;
+    return true;
+}
+
+void QQmlImportSnapshot::addQmldirContent(const QString &filePath, const QString &content)
+{
+    QMutexLocker locker(&m_mutex);
+    record(filePath);
+    m_qmldirContents.insert(filePath, content);
+}
+
+QString QQmlImportSnapshot::pluginFilePath(const QString &qmldirPath, const QString &pluginPath,
+                                           const QString &baseName)
+{
+    QMutexLocker locker(&m_mutex);
+    const QString filePath = m_pluginFilePaths.value(pluginKey(qmldirPath, pluginPath, baseName));
+    return (filePath.isEmpty() || !isUpToDate(filePath)) ? QString() : filePath;
+}
+
+void QQmlImportSnapshot::addPluginFilePath(const QString &qmldirPath, const QString &pluginPath,
+                                           const QString &baseName, const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+    record(filePath);
+    m_pluginFilePaths.insert(pluginKey(qmldirPath, pluginPath, baseName), filePath);
+}
+
+QT_END_NAMESPACE
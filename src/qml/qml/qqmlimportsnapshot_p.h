@@ -0,0 +1,129 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLIMPORTSNAPSHOT_P_H
+#define QQMLIMPORTSNAPSHOT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qversionnumber.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Remembers across application runs where the modules imported by QML documents were found,
+// what their qmldir files contain and which plugin files they load, so that an engine doesn't
+// have to search the import and plugin paths for them again. The snapshot is stored in the
+// disk cache directory, one per application and set of import and plugin paths. Each entry
+// is only used as long as the files it refers to have the same size and modification time
+// as when it was recorded. A module that is installed later into an import path searched
+// before the one it was found in is only noticed once the application binary changes, or the
+// snapshot is removed.
+class Q_AUTOTEST_EXPORT QQmlImportSnapshot
+{
+    Q_DISABLE_COPY_MOVE(QQmlImportSnapshot)
+public:
+    struct QmldirLocation
+    {
+        QString filePath;
+        QString pathUrl;
+
+        friend QDataStream &operator<<(QDataStream &stream, const QmldirLocation &location)
+        {
+            return stream << location.filePath << location.pathUrl;
+        }
+
+        friend QDataStream &operator>>(QDataStream &stream, QmldirLocation &location)
+        {
+            return stream >> location.filePath >> location.pathUrl;
+        }
+    };
+
+    ~QQmlImportSnapshot();
+
+    static bool isEnabled();
+    static std::unique_ptr<QQmlImportSnapshot> create(
+            const QStringList &importPaths, const QStringList &pluginPaths);
+
+    bool matches(const QStringList &importPaths, const QStringList &pluginPaths) const
+    {
+        return importPaths == m_importPaths && pluginPaths == m_pluginPaths;
+    }
+
+    QString filePath() const { return m_filePath; }
+
+    bool qmldirLocations(const QString &uri, QTypeRevision version,
+                         QList<QmldirLocation> *locations);
+    void addQmldirLocations(const QString &uri, QTypeRevision version,
+                            const QList<QmldirLocation> &locations);
+
+    bool qmldirContent(const QString &filePath, QString *content);
+    void addQmldirContent(const QString &filePath, const QString &content);
+
+    QString pluginFilePath(const QString &qmldirPath, const QString &pluginPath,
+                           const QString &baseName);
+    void addPluginFilePath(const QString &qmldirPath, const QString &pluginPath,
+                           const QString &baseName, const QString &filePath);
+
+    void save();
+
+private:
+    struct FileStamp
+    {
+        qint64 size = -1;
+        qint64 lastModified = 0;
+
+        bool operator==(const FileStamp &other) const
+        {
+            return size == other.size && lastModified == other.lastModified;
+        }
+    };
+
+    QQmlImportSnapshot(const QStringList &importPaths, const QStringList &pluginPaths,
+                       const QString &filePath);
+
+    static FileStamp stamp(const QString &filePath);
+    static QString moduleKey(const QString &uri, QTypeRevision version);
+    static QString pluginKey(const QString &qmldirPath, const QString &pluginPath,
+                             const QString &baseName);
+
+    QByteArray header() const;
+    void load();
+    bool isUpToDate(const QString &filePath);
+    void record(const QString &filePath);
+
+    QMutex m_mutex;
+    QStringList m_importPaths;
+    QStringList m_pluginPaths;
+    QString m_filePath;
+
+    // The stamps of all files any of the entries depend on, as recorded.
+    QHash<QString, FileStamp> m_files;
+    // Whether the files still have the recorded stamps, checked once per file.
+    QHash<QString, bool> m_checkedFiles;
+
+    QHash<QString, QList<QmldirLocation>> m_qmldirLocations;
+    QHash<QString, QString> m_qmldirContents;
+    QHash<QString, QString> m_pluginFilePaths;
+    bool m_dirty = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLIMPORTSNAPSHOT_P_H
@@ -277,7 +277,10 @@ void QQmlIncubatorPrivate::incubate(QQmlInstantiationInterrupt &i)
     if (progress == QQmlIncubatorPrivate::Execute) {
         enginePriv->referenceScarceResources();
         QObject *tresult = nullptr;
-        tresult = creator->create(subComponentToCreate, /*parent*/nullptr, &i);
+        {
+            QQmlIncubationPhaseTimer phaseTimer(this, QQmlIncubationPhase::CreatingObjects);
+            tresult = creator->create(subComponentToCreate, /*parent*/nullptr, &i);
+        }
         if (!tresult)
             errors = creator->errors;
         else {
@@ -407,8 +410,19 @@ void QQmlIncubatorPrivate::incubateCppBasedComponent(QQmlComponent *component, Q
 
 }
 
+std::atomic<QQmlIncubatorPrivate::PhaseHook> QQmlIncubatorPrivate::s_phaseHook = nullptr;
+
+void QQmlIncubatorPrivate::setPhaseHook(PhaseHook hook)
+{
+    s_phaseHook.store(hook, std::memory_order_relaxed);
+}
+
 /*!
 Incubate objects for \a msecs, or until there are no more objects to incubate.
+
+The objects of a component are created in one step. Evaluating their bindings, calling
+QQmlParserStatus::componentComplete() on them and emitting their Component.completed
+signals is interrupted once \a msecs have passed, and continued by the next call.
 */
 void QQmlIncubationController::incubateFor(int msecs)
 {
@@ -28,6 +28,16 @@ QT_BEGIN_NAMESPACE
 class RequiredProperties;
 
 class QQmlIncubator;
+
+enum class QQmlIncubationPhase : quint8 {
+    CreatingObjects,
+    EvaluatingBindings,
+    InstallingPropertyBindings,
+    CompletingComponents,
+    RunningFinalizers,
+    EmittingCompleted
+};
+
 class Q_QML_PRIVATE_EXPORT QQmlIncubatorPrivate : public QQmlEnginePrivate::Incubator, public QSharedData
 {
 public:
@@ -81,6 +91,52 @@ public:
     void incubateCppBasedComponent(QQmlComponent *component, QQmlContext *context);
     RequiredProperties *requiredProperties();
     bool hadTopLevelRequiredProperties() const;
+
+    // Called with the time an incubator spent in a phase of its creation, every time it
+    // worked on it. A phase interrupted by the incubation controller is reported again when
+    // the incubator resumes it.
+    using PhaseHook = void (*)(QQmlIncubator *incubator, QQmlIncubationPhase phase, qint64 nsecs);
+    static void setPhaseHook(PhaseHook hook);
+    static PhaseHook phaseHook() { return s_phaseHook.load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<PhaseHook> s_phaseHook;
+};
+
+class QQmlIncubationPhaseTimer
+{
+    Q_DISABLE_COPY_MOVE(QQmlIncubationPhaseTimer)
+public:
+    QQmlIncubationPhaseTimer(QQmlIncubatorPrivate *incubator, QQmlIncubationPhase phase)
+        : hook(incubator ? QQmlIncubatorPrivate::phaseHook() : nullptr)
+        , incubator(incubator)
+        , phase(phase)
+    {
+        if (hook)
+            timer.start();
+    }
+
+    ~QQmlIncubationPhaseTimer() { report(); }
+
+    void switchTo(QQmlIncubationPhase next)
+    {
+        report();
+        phase = next;
+        if (hook)
+            timer.start();
+    }
+
+private:
+    void report()
+    {
+        if (hook && incubator->q)
+            hook(incubator->q, phase, timer.nsecsElapsed());
+    }
+
+    QQmlIncubatorPrivate::PhaseHook hook;
+    QQmlIncubatorPrivate *incubator;
+    QQmlIncubationPhase phase;
+    QElapsedTimer timer;
 };
 
 QT_END_NAMESPACE
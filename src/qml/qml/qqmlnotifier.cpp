@@ -3,6 +3,7 @@
 
 #include "qqmlnotifier_p.h"
 #include "qqmlproperty_p.h"
+#include "qqmlbindingbatch_p.h"
 #include <QtCore/qdebug.h>
 #include <private/qthread_p.h>
 
@@ -45,6 +46,8 @@ void QQmlNotifier::notify(QQmlData *ddata, int notifierIndex)
 
 void QQmlNotifier::emitNotify(QQmlNotifierEndpoint *endpoint, void **a)
 {
+    QQmlBindingBatch::NotifyScope batchScope;
+
     QVarLengthArray<NotifyListTraversalData> stack;
     while (endpoint) {
         stack.append(NotifyListTraversalData(endpoint));
@@ -13,6 +13,7 @@
 #include <private/qqmlboundsignal_p.h>
 #include <private/qqmlcomponentattached_p.h>
 #include <private/qqmlcomponent_p.h>
+#include <private/qqmlincubator_p.h>
 #include <private/qqmlcustomparser_p.h>
 #include <private/qqmlscriptstring_p.h>
 #include <private/qqmlpropertyvalueinterceptor_p.h>
@@ -942,7 +943,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
                     Q_ASSERT(data && data->propertyCache);
                     bindingProperty = data->propertyCache->property(aliasTargetIndex.coreIndex());
                 }
-                auto &observer = QQmlData::get(_scopeObject)->propertyObservers.emplace_back(expr);
+                auto &observer = QQmlData::get(_scopeObject)->addPropertyObserver(expr);
                 QUntypedBindable bindable;
                 void *argv[] = { &bindable };
                 target->qt_metacall(QMetaObject::BindableProperty, bindingProperty->coreIndex(), argv);
@@ -1175,29 +1176,6 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
     return true;
 }
 
-void QQmlObjectCreator::setupFunctions()
-{
-    QV4::Scope scope(v4);
-    QV4::ScopedValue function(scope);
-    QV4::ScopedContext qmlContext(scope, currentQmlContext());
-
-    const quint32_le *functionIdx = _compiledObject->functionOffsetTable();
-    for (quint32 i = 0; i < _compiledObject->nFunctions; ++i, ++functionIdx) {
-        QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[*functionIdx];
-        const QString name = runtimeFunction->name()->toQString();
-
-        const QQmlPropertyData *property = _propertyCache->property(name, _qobject, context);
-        if (!property->isVMEFunction())
-            continue;
-
-        if (runtimeFunction->isGenerator())
-            function = QV4::GeneratorFunction::create(qmlContext, runtimeFunction);
-        else
-            function = QV4::FunctionObject::createScriptFunction(qmlContext, runtimeFunction);
-        _vmeMetaObject->setVmeMethod(property->coreIndex(), function);
-    }
-}
-
 void QQmlObjectCreator::recordError(const QV4::CompiledData::Location &location, const QString &description)
 {
     QQmlError error;
@@ -1214,6 +1192,20 @@ void QQmlObjectCreator::registerObjectWithContextById(const QV4::CompiledData::O
         context->setIdValue(object->objectId(), instance);
 }
 
+static bool isKeptAliveDuringCreation(const QObject *object)
+{
+    // Like the garbage collector, check the object and its top level parent.
+    if (QQmlData::keepAliveDuringGarbageCollection(object))
+        return true;
+
+    const QObject *parent = object->parent();
+    if (!parent)
+        return false;
+    while (parent->parent())
+        parent = parent->parent();
+    return QQmlData::keepAliveDuringGarbageCollection(parent);
+}
+
 QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isContextObject)
 {
     const QV4::CompiledData::Object *obj = compilationUnit->objectAt(index);
@@ -1374,8 +1366,12 @@ QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isCo
     QObject *scopeObject = instance;
     qSwap(_scopeObject, scopeObject);
 
+    // Most objects are never accessed from JavaScript and get their wrapper on first access. The
+    // garbage collector keeps the wrappers of objects below an indestructible object or the root
+    // object in creation alive anyway. Only the other objects need a referenced wrapper now.
     Q_ASSERT(sharedState->allJavaScriptObjects);
-    *sharedState->allJavaScriptObjects = QV4::QObjectWrapper::wrap(v4, instance);
+    if (!isKeptAliveDuringCreation(instance))
+        *sharedState->allJavaScriptObjects = QV4::QObjectWrapper::wrap(v4, instance);
     ++sharedState->allJavaScriptObjects;
 
     QV4::Scope valueScope(v4);
@@ -1433,6 +1429,7 @@ bool QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interrupt)
        way for it to change its value afterwards from that point on.
     */
 
+    QQmlIncubationPhaseTimer phaseTimer(incubator, QQmlIncubationPhase::EvaluatingBindings);
     while (!sharedState->allCreatedBindings.isEmpty()) {
         QQmlAbstractBinding::Ptr b = sharedState->allCreatedBindings.pop();
         Q_ASSERT(b);
@@ -1456,6 +1453,7 @@ bool QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interrupt)
             return false;
     }
 
+    phaseTimer.switchTo(QQmlIncubationPhase::InstallingPropertyBindings);
     while (!sharedState->allQPropertyBindings.isEmpty()) {
         auto& [target, index, qmlBinding] = sharedState->allQPropertyBindings.first();
         QUntypedBindable bindable;
@@ -1484,6 +1482,7 @@ bool QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interrupt)
             return false;
     }
 
+    phaseTimer.switchTo(QQmlIncubationPhase::CompletingComponents);
     if (QQmlVME::componentCompleteEnabled()) { // the qml designer does the component complete later
         while (!sharedState->allParserStatusCallbacks.isEmpty()) {
             QQmlObjectCompletionProfiler profiler(&sharedState->profiler);
@@ -1499,13 +1498,17 @@ bool QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interrupt)
         }
     }
 
-    for (QQmlFinalizerHook *hook: sharedState->finalizeHooks) {
+    phaseTimer.switchTo(QQmlIncubationPhase::RunningFinalizers);
+    // Take each hook off the list before running it, so that it doesn't run again when the
+    // incubation is interrupted and resumed.
+    while (!sharedState->finalizeHooks.isEmpty()) {
+        QQmlFinalizerHook *hook = sharedState->finalizeHooks.takeFirst();
         hook->componentFinalized();
-        if (watcher.hasRecursed())
+        if (watcher.hasRecursed() || interrupt.shouldInterrupt())
             return false;
     }
-    sharedState->finalizeHooks.clear();
 
+    phaseTimer.switchTo(QQmlIncubationPhase::EmittingCompleted);
     while (sharedState->componentAttached) {
         QQmlComponentAttached *a = sharedState->componentAttached;
         a->removeFromList();
@@ -1703,8 +1706,6 @@ bool QQmlObjectCreator::populateInstance(int index, QObject *instance, QObject *
     if (!postHocRequired.isEmpty() && hadInheritedRequiredProperties)
         recordError({}, QLatin1String("Property %1 was marked as required but does not exist").arg(*postHocRequired.begin()));
 
-    if (_compiledObject->nFunctions > 0)
-        setupFunctions();
     setupBindings((binding && binding->hasFlag(QV4::CompiledData::Binding::IsDeferredBinding))
                   ? BindingMode::ApplyAll
                   : BindingMode::ApplyImmediate);
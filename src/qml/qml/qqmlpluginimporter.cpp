@@ -390,6 +390,20 @@ QString QQmlPluginImporter::resolvePlugin(const QString &qmldirPluginPath, const
     };
 #endif
 
+    QQmlImportSnapshot *importSnapshot = database->snapshot();
+    if (importSnapshot) {
+        const QString filePath = importSnapshot->pluginFilePath(
+                qmldirPath, qmldirPluginPath, baseName);
+        if (!filePath.isEmpty())
+            return filePath;
+    }
+
+    const auto found = [&](const QString &absolutePath) {
+        if (importSnapshot)
+            importSnapshot->addPluginFilePath(qmldirPath, qmldirPluginPath, baseName, absolutePath);
+        return absolutePath;
+    };
+
     QStringList searchPaths = database->filePluginPath;
     bool qmldirPluginPathIsRelative = QDir::isRelativePath(qmldirPluginPath);
     if (!qmldirPluginPathIsRelative)
@@ -422,7 +436,7 @@ QString QQmlPluginImporter::resolvePlugin(const QString &qmldirPluginPath, const
         for (const QString &suffix : suffixes) {
             QString absolutePath = typeLoader->absoluteFilePath(resolvedPath + suffix);
             if (!absolutePath.isEmpty())
-                return absolutePath;
+                return found(absolutePath);
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
@@ -12,6 +12,8 @@
 
 #include <QtCore/qloggingcategory.h>
 
+#include <utility>
+
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
 
@@ -34,9 +36,15 @@ QQmlRefPointer<QQmlScriptData> QQmlScriptBlob::scriptData() const
 
 void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
 {
+    QQmlRefPointer<QV4::ExecutableCompilationUnit> unit = QV4::ExecutableCompilationUnit::create();
+
+    // Another engine in this process may have compiled the same script already.
+    if (!isDebugging() && unit->loadFromSharedCache(url(), data.sourceTimeStamp())) {
+        initializeFromCompilationUnit(unit);
+        return;
+    }
+
     if (diskCacheEnabled()) {
-        QQmlRefPointer<QV4::ExecutableCompilationUnit> unit
-                = QV4::ExecutableCompilationUnit::create();
         QString error;
         if (unit->loadFromDisk(url(), data.sourceTimeStamp(), &error)) {
             initializeFromCompilationUnit(unit);
@@ -54,55 +62,69 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         return;
     }
 
+    // Compiling the script doesn't need anything but the source code. Let a worker thread do
+    // it while the loader continues with other files.
+    m_sourceCode = data;
+    m_sourceTimeStamp = data.sourceTimeStamp();
+    m_isDebugging = isDebugging();
+    compileInBackground();
+}
+
+void QQmlScriptBlob::backgroundCompile()
+{
+    const SourceCodeData data = std::exchange(m_sourceCode, SourceCodeData());
+
     QString error;
     QString source = data.readAll(&error);
     if (!error.isEmpty()) {
-        setError(error);
+        QQmlError e;
+        e.setUrl(url());
+        e.setDescription(error);
+        m_compileErrors.append(e);
         return;
     }
 
-    QV4::CompiledData::CompilationUnit unit;
-
     if (m_isModule) {
         QList<QQmlJS::DiagnosticMessage> diagnostics;
-        unit = QV4::Compiler::Codegen::compileModule(isDebugging(), urlString(), source,
-                                                     data.sourceTimeStamp(), &diagnostics);
-        QList<QQmlError> errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString(), diagnostics);
-        if (!errors.isEmpty()) {
-            setError(errors);
-            return;
-        }
+        m_compiledUnit = QV4::Compiler::Codegen::compileModule(
+                m_isDebugging, urlString(), source, m_sourceTimeStamp, &diagnostics);
+        m_compileErrors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString(), diagnostics);
     } else {
-        QmlIR::Document irUnit(isDebugging());
+        QmlIR::Document irUnit(m_isDebugging);
 
-        irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
+        irUnit.jsModule.sourceTimeStamp = m_sourceTimeStamp;
 
         QmlIR::ScriptDirectivesCollector collector(&irUnit);
         irUnit.jsParserEngine.setDirectives(&collector);
 
-        QList<QQmlError> errors;
         irUnit.javaScriptCompilationUnit = QV4::Script::precompile(
                      &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, urlString(), finalUrlString(),
-                     source, &errors, QV4::Compiler::ContextType::ScriptImportedByQML);
+                     source, &m_compileErrors, QV4::Compiler::ContextType::ScriptImportedByQML);
 
         source.clear();
-        if (!errors.isEmpty()) {
-            setError(errors);
+        if (!m_compileErrors.isEmpty())
             return;
-        }
 
         QmlIR::QmlUnitGenerator qmlGenerator;
         qmlGenerator.generate(irUnit);
-        unit = std::move(irUnit.javaScriptCompilationUnit);
+        m_compiledUnit = std::move(irUnit.javaScriptCompilationUnit);
+    }
+}
+
+void QQmlScriptBlob::backgroundCompileDone()
+{
+    if (!m_compileErrors.isEmpty()) {
+        setError(std::exchange(m_compileErrors, {}));
+        return;
     }
 
-    auto executableUnit = QV4::ExecutableCompilationUnit::create(std::move(unit));
+    auto executableUnit = QV4::ExecutableCompilationUnit::create(std::move(m_compiledUnit));
 
     if (diskCacheEnabled()) {
         QString errorString;
         if (executableUnit->saveToDisk(url(), &errorString)) {
             QString error;
-            if (!executableUnit->loadFromDisk(url(), data.sourceTimeStamp(), &error)) {
+            if (!executableUnit->loadFromDisk(url(), m_sourceTimeStamp, &error)) {
                 // ignore error, keep using the in-memory compilation unit.
             }
         } else {
@@ -111,6 +133,8 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         }
     }
 
+    if (!m_isDebugging)
+        executableUnit->shareUnitData(url());
     initializeFromCompilationUnit(executableUnit);
 }
 
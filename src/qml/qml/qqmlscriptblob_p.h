@@ -44,6 +44,8 @@ protected:
     void dataReceived(const SourceCodeData &) override;
     void initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *unit) override;
     void done() override;
+    void backgroundCompile() override;
+    void backgroundCompileDone() override;
 
     QString stringAt(int index) const override;
 
@@ -55,6 +57,13 @@ private:
     QList<ScriptReference> m_scripts;
     QQmlRefPointer<QQmlScriptData> m_scriptData;
     const bool m_isModule;
+
+    // Input and output of backgroundCompile()
+    SourceCodeData m_sourceCode;
+    QDateTime m_sourceTimeStamp;
+    bool m_isDebugging = false;
+    QV4::CompiledData::CompilationUnit m_compiledUnit;
+    QList<QQmlError> m_compileErrors;
 };
 
 QT_END_NAMESPACE
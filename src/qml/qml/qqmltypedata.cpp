@@ -17,6 +17,7 @@
 #include <QtCore/qcryptographichash.h>
 
 #include <memory>
+#include <utility>
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(lcCycle, "qt.qml.typeresolution.cycle")
@@ -83,15 +84,17 @@ CompositeMetaTypeIds QQmlTypeData::typeIds(int objectId) const
 
 bool QQmlTypeData::tryLoadFromDiskCache()
 {
-    if (!diskCacheEnabled())
-        return false;
-
     QV4::ExecutionEngine *v4 = typeLoader()->engine()->handle();
     if (!v4)
         return false;
 
     QQmlRefPointer<QV4::ExecutableCompilationUnit> unit = QV4::ExecutableCompilationUnit::create();
-    {
+
+    // Another engine in this process may have compiled the same document already.
+    if (isDebugging() || !unit->loadFromSharedCache(url(), m_backupSourceCode.sourceTimeStamp())) {
+        if (!diskCacheEnabled())
+            return false;
+
         QString error;
         if (!unit->loadFromDisk(url(), m_backupSourceCode.sourceTimeStamp(), &error)) {
             qCDebug(DBG_DISK_CACHE) << "Error loading" << urlString() << "from disk cache:" << error;
@@ -656,8 +659,23 @@ void QQmlTypeData::dataReceived(const SourceCodeData &data)
         return;
     }
 
-    if (!loadFromSource())
+    // Parsing doesn't need anything but the source code. Let a worker thread do it while the
+    // loader continues with other files.
+    createDocument();
+    compileInBackground();
+}
+
+void QQmlTypeData::backgroundCompile()
+{
+    parseSource(&m_sourceErrors);
+}
+
+void QQmlTypeData::backgroundCompileDone()
+{
+    if (!m_sourceErrors.isEmpty()) {
+        setError(std::exchange(m_sourceErrors, {}));
         return;
+    }
 
     continueLoadFromIR();
 }
@@ -674,31 +692,49 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 }
 
 bool QQmlTypeData::loadFromSource()
+{
+    createDocument();
+
+    QList<QQmlError> errors;
+    if (!parseSource(&errors)) {
+        setError(errors);
+        return false;
+    }
+    return true;
+}
+
+void QQmlTypeData::createDocument()
 {
     m_document.reset(new QmlIR::Document(isDebugging()));
     m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+}
+
+// May run in a worker thread, see backgroundCompile().
+bool QQmlTypeData::parseSource(QList<QQmlError> *errors)
+{
     QQmlEngine *qmlEngine = typeLoader()->engine();
     QmlIR::IRBuilder compiler(qmlEngine->handle()->illegalNames());
 
     QString sourceError;
     const QString source = m_backupSourceCode.readAll(&sourceError);
     if (!sourceError.isEmpty()) {
-        setError(sourceError);
+        QQmlError e;
+        e.setUrl(url());
+        e.setDescription(sourceError);
+        errors->append(e);
         return false;
     }
 
     if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
-        QList<QQmlError> errors;
-        errors.reserve(compiler.errors.size());
+        errors->reserve(compiler.errors.size());
         for (const QQmlJS::DiagnosticMessage &msg : std::as_const(compiler.errors)) {
             QQmlError e;
             e.setUrl(url());
             e.setLine(qmlConvertSourceCoordinate<quint32, int>(msg.loc.startLine));
             e.setColumn(qmlConvertSourceCoordinate<quint32, int>(msg.loc.startColumn));
             e.setDescription(msg.message);
-            errors << e;
+            errors->append(e);
         }
-        setError(errors);
         return false;
     }
     return true;
@@ -857,6 +893,9 @@ void QQmlTypeData::compile(const QQmlRefPointer<QQmlTypeNameCache> &typeNameCach
             qCDebug(DBG_DISK_CACHE) << "Error saving cached version of" << m_compiledData->fileName() << "to disk:" << errorString;
         }
     }
+
+    if (!typeRecompilation && !isDebugging())
+        m_compiledData->shareUnitData(url());
 }
 
 void QQmlTypeData::resolveTypes()
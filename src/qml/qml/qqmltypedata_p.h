@@ -79,12 +79,16 @@ protected:
     void initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *unit) override;
     void allDependenciesDone() override;
     void downloadProgressChanged(qreal) override;
+    void backgroundCompile() override;
+    void backgroundCompileDone() override;
 
     QString stringAt(int index) const override;
 
 private:
     bool tryLoadFromDiskCache();
     bool loadFromSource();
+    void createDocument();
+    bool parseSource(QList<QQmlError> *errors);
     void restoreIR(QV4::CompiledData::CompilationUnit &&unit);
     void continueLoadFromIR();
     void resolveTypes();
@@ -109,6 +113,7 @@ private:
 
     SourceCodeData m_backupSourceCode; // used when cache verification fails.
     QScopedPointer<QmlIR::Document> m_document;
+    QList<QQmlError> m_sourceErrors; // from backgroundCompile()
     QV4::CompiledData::TypeReferenceMap m_typeReferences;
 
     QList<ScriptReference> m_scripts;
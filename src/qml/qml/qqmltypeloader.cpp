@@ -22,7 +22,12 @@
 #include <QtCore/qdiriterator.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qthread.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#endif
 
+#include <algorithm>
 #include <functional>
 
 // #define DATABLOB_DEBUG
@@ -77,6 +82,15 @@ one of these three preconditions are met.
 \endlist
 
 Thus QQmlDataBlob::done() will always eventually be called, even if the blob has an error set.
+
+A blob can hand the part of processing its data that doesn't depend on other blobs, such as
+parsing, to a pool of worker threads by calling QQmlDataBlob::compileInBackground() from
+dataReceived(). The load thread meanwhile continues with other blobs, for example the
+siblings of the blob among the dependencies of its parent. Before the load thread returns to
+its event loop, it waits for all of those and continues processing them as usual, so that the
+blobs reach the same states as if the work had been done in the load thread. The number of
+worker threads can be set with the QML_TYPELOADER_THREADS environment variable, 0 disables
+them.
 */
 
 void QQmlTypeLoader::invalidate()
@@ -404,15 +418,13 @@ void QQmlTypeLoader::setData(const QQmlDataBlob::Ptr &blob, const QQmlDataBlob::
 
     blob->dataReceived(d);
 
-    if (!blob->isError() && !blob->isWaiting())
-        blob->allDependenciesDone();
-
-    if (blob->status() != QQmlDataBlob::Error)
-        blob->m_data.setStatus(QQmlDataBlob::WaitingForDependencies);
-
-    blob->m_inCallback = false;
+    if (blob->m_isCompilingInBackground) {
+        // Continued in finishBackgroundCompiles()
+        blob->m_inCallback = false;
+        return;
+    }
 
-    blob->tryDone();
+    dataProcessed(blob);
 }
 
 void QQmlTypeLoader::setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPrivate::CachedQmlUnit *unit)
@@ -424,6 +436,11 @@ void QQmlTypeLoader::setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPriv
 
     blob->initializeFromCachedUnit(unit);
 
+    dataProcessed(blob);
+}
+
+void QQmlTypeLoader::dataProcessed(const QQmlDataBlob::Ptr &blob)
+{
     if (!blob->isError() && !blob->isWaiting())
         blob->allDependenciesDone();
 
@@ -435,6 +452,116 @@ void QQmlTypeLoader::setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPriv
     blob->tryDone();
 }
 
+#if QT_CONFIG(thread)
+struct QQmlTypeLoader::CompilePool
+{
+    QThreadPool threadPool;
+
+    QMutex mutex;
+    QWaitCondition blobFinished;
+    QList<QQmlDataBlob *> finishedBlobs; // Protected by mutex
+
+    // The blobs handed to the pool, only accessed in the load thread.
+    QList<QQmlDataBlob::Ptr> compilingBlobs;
+};
+
+static int compilePoolThreadCount()
+{
+    static const int threadCount = []() {
+        bool ok = false;
+        const int threads = qEnvironmentVariableIntValue("QML_TYPELOADER_THREADS", &ok);
+        if (ok)
+            return qMax(threads, 0);
+        const int idealThreadCount = QThread::idealThreadCount();
+        return idealThreadCount > 1 ? idealThreadCount : 0;
+    }();
+    return threadCount;
+}
+#endif
+
+/*!
+Runs QQmlDataBlob::backgroundCompile() for \a blob on a worker thread.
+
+Returns false if there are no worker threads, in which case the caller has to do the work
+itself. Otherwise the blob stays in the Loading state until finishBackgroundCompiles() has
+handed it back to the load thread.
+*/
+bool QQmlTypeLoader::startBackgroundCompile(QQmlDataBlob *blob)
+{
+#if QT_CONFIG(thread)
+    const int threadCount = compilePoolThreadCount();
+    if (threadCount == 0 || !m_thread->isThisThread())
+        return false;
+
+    if (!m_compilePool) {
+        m_compilePool = std::make_unique<CompilePool>();
+        m_compilePool->threadPool.setMaxThreadCount(threadCount);
+    }
+
+    CompilePool *pool = m_compilePool.get();
+    pool->compilingBlobs.append(blob);
+    blob->m_isCompilingInBackground = true;
+    pool->threadPool.start([pool, blob]() {
+        blob->backgroundCompile();
+
+        QMutexLocker locker(&pool->mutex);
+        pool->finishedBlobs.append(blob);
+        pool->blobFinished.wakeOne();
+    });
+    return true;
+#else
+    Q_UNUSED(blob);
+    return false;
+#endif
+}
+
+/*!
+Waits for all blobs handed to the worker threads and continues processing them in the
+load thread, in the order they finish. This in turn can start more background compiles for
+the dependencies of those blobs, which are waited for as well.
+
+Must be called before returning control to the event loop of the load thread, so that
+anyone waiting for a blob to be complete sees the same states as if everything had been
+done in the load thread.
+*/
+void QQmlTypeLoader::finishBackgroundCompiles()
+{
+#if QT_CONFIG(thread)
+    ASSERT_LOADTHREAD();
+
+    if (!m_compilePool)
+        return;
+
+    CompilePool *pool = m_compilePool.get();
+    while (!pool->compilingBlobs.isEmpty()) {
+        QQmlDataBlob *finished = nullptr;
+        {
+            QMutexLocker locker(&pool->mutex);
+            while (pool->finishedBlobs.isEmpty())
+                pool->blobFinished.wait(&pool->mutex);
+            finished = pool->finishedBlobs.takeFirst();
+        }
+
+        const auto it = std::find_if(
+                pool->compilingBlobs.begin(), pool->compilingBlobs.end(),
+                [finished](const QQmlDataBlob::Ptr &blob) { return blob.data() == finished; });
+        Q_ASSERT(it != pool->compilingBlobs.end());
+        const QQmlDataBlob::Ptr blob = std::move(*it);
+        pool->compilingBlobs.erase(it);
+
+        Q_TRACE_SCOPE(QQmlCompiling, blob->url());
+        QQmlCompilingProfiler prof(profiler(), blob.data());
+
+        blob->m_isCompilingInBackground = false;
+        blob->m_inCallback = true;
+
+        blob->backgroundCompileDone();
+
+        dataProcessed(blob);
+    }
+#endif
+}
+
 void QQmlTypeLoader::shutdownThread()
 {
     if (m_thread && !m_thread->isShutdown())
@@ -1241,12 +1368,19 @@ const QQmlTypeLoaderQmldirContent QQmlTypeLoader::qmldirContent(const QString &f
 #define NOT_READABLE_ERROR QString(QLatin1String("module \"$$URI$$\" definition \"%1\" not readable"))
 #define CASE_MISMATCH_ERROR QString(QLatin1String("cannot load module \"$$URI$$\": File name case mismatch for \"%1\""))
 
+    QQmlImportSnapshot *snapshot = importDatabase()->snapshot();
+    QString content;
+
     QFile file(filePath);
     if (!QQml_isFileCaseCorrect(filePath)) {
         ERROR(CASE_MISMATCH_ERROR.arg(filePath));
+    } else if (snapshot && snapshot->qmldirContent(filePath, &content)) {
+        qmldir->setContent(filePath, content);
     } else if (file.open(QFile::ReadOnly)) {
-        QByteArray data = file.readAll();
-        qmldir->setContent(filePath, QString::fromUtf8(data));
+        content = QString::fromUtf8(file.readAll());
+        if (snapshot)
+            snapshot->addQmldirContent(filePath, content);
+        qmldir->setContent(filePath, content);
     } else {
         ERROR(NOT_READABLE_ERROR.arg(filePath));
     }
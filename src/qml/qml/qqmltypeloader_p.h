@@ -189,6 +189,10 @@ private:
     void setData(const QQmlDataBlob::Ptr &, const QString &fileName);
     void setData(const QQmlDataBlob::Ptr &, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPrivate::CachedQmlUnit *unit);
+    void dataProcessed(const QQmlDataBlob::Ptr &blob);
+
+    bool startBackgroundCompile(QQmlDataBlob *blob);
+    void finishBackgroundCompiles();
 
     typedef QHash<QUrl, QQmlTypeData *> TypeCache;
     typedef QHash<QUrl, QQmlScriptBlob *> ScriptCache;
@@ -215,6 +219,11 @@ private:
     ImportQmlDirCache m_importQmlDirCache;
     ChecksumCache m_checksumCache;
 
+#if QT_CONFIG(thread)
+    struct CompilePool;
+    std::unique_ptr<CompilePool> m_compilePool;
+#endif
+
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
     void updateTypeCacheTrimThreshold();
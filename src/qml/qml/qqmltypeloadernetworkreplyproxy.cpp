@@ -17,6 +17,7 @@ void QQmlTypeLoaderNetworkReplyProxy::finished()
     Q_ASSERT(qobject_cast<QNetworkReply *>(sender()));
     QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
     l->networkReplyFinished(reply);
+    l->finishBackgroundCompiles();
 }
 
 void QQmlTypeLoaderNetworkReplyProxy::downloadProgress(qint64 bytesReceived, qint64 bytesTotal)
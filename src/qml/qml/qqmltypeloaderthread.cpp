@@ -105,16 +105,19 @@ void QQmlTypeLoaderThread::initializeEngine(QQmlEngineExtensionInterface *iface,
 void QQmlTypeLoaderThread::loadThread(const QQmlDataBlob::Ptr &b)
 {
     m_loader->loadThread(b);
+    m_loader->finishBackgroundCompiles();
 }
 
 void QQmlTypeLoaderThread::loadWithStaticDataThread(const QQmlDataBlob::Ptr &b, const QByteArray &d)
 {
     m_loader->loadWithStaticDataThread(b, d);
+    m_loader->finishBackgroundCompiles();
 }
 
 void QQmlTypeLoaderThread::loadWithCachedUnitThread(const QQmlDataBlob::Ptr &b, const QQmlPrivate::CachedQmlUnit *unit)
 {
     m_loader->loadWithCachedUnitThread(b, unit);
+    m_loader->finishBackgroundCompiles();
 }
 
 void QQmlTypeLoaderThread::callCompletedMain(const QQmlDataBlob::Ptr &b)
@@ -13,9 +13,11 @@
 #include <private/qv4object_p.h>
 #include <private/qv4variantobject_p.h>
 #include <private/qv4functionobject_p.h>
+#include <private/qv4generatorobject_p.h>
 #include <private/qv4scopedvalue_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4qmlcontext_p.h>
 #include <private/qv4sequenceobject_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
 #include <private/qqmlpropertycachemethodarguments_p.h>
@@ -388,21 +390,10 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QV4::ExecutionEngine *engine,
     Q_ASSERT(engine);
     QQmlData::get(obj)->hasVMEMetaObject = true;
 
-    if (compilationUnit && qmlObjectId >= 0) {
+    // The storage for the properties and methods is allocated on first access, see
+    // propertyAndMethodStorageAsMemberData().
+    if (compilationUnit && qmlObjectId >= 0)
         compiledObject = compilationUnit->objectAt(qmlObjectId);
-
-        if (compiledObject->nProperties || compiledObject->nFunctions) {
-            uint size = compiledObject->nProperties + compiledObject->nFunctions;
-            if (size) {
-                QV4::Heap::MemberData *data = QV4::MemberData::allocate(engine, size);
-                propertyAndMethodStorage.set(engine, data);
-                std::fill(data->values.values, data->values.values + data->values.size, QV4::Encode::undefined());
-            }
-
-            // Need JS wrapper to ensure properties/methods are marked.
-            ensureQObjectWrapper();
-        }
-    }
 }
 
 QQmlVMEMetaObject::~QQmlVMEMetaObject()
@@ -422,6 +413,21 @@ QV4::MemberData *QQmlVMEMetaObject::propertyAndMethodStorageAsMemberData() const
             // QObject ptr will not yet have been deleted (eg, waiting on deleteLater).
             // In this situation, return 0.
             return nullptr;
+
+        // Many objects never touch the properties and methods they declare. Only allocate the
+        // storage, and the JS wrapper that marks it, once they do.
+        if (!compiledObject || !(compiledObject->nProperties || compiledObject->nFunctions))
+            return nullptr;
+
+        const uint size = compiledObject->nProperties + compiledObject->nFunctions;
+        QV4::Scope scope(engine);
+        QV4::Scoped<QV4::MemberData> data(scope, QV4::MemberData::allocate(engine, size));
+        std::fill(data->d()->values.values, data->d()->values.values + data->d()->values.size,
+                  QV4::Encode::undefined());
+        propertyAndMethodStorage.set(engine, data->d());
+
+        // Need JS wrapper to ensure properties/methods are marked.
+        ensureQObjectWrapper();
     }
 
     return static_cast<QV4::MemberData*>(propertyAndMethodStorage.asManaged());
@@ -1108,7 +1114,23 @@ QV4::ReturnedValue QQmlVMEMetaObject::method(int index) const
     if (!md)
         return QV4::Encode::undefined();
 
-    return (md->data() + index + compiledObject->nProperties)->asReturnedValue();
+    const uint slot = index + compiledObject->nProperties;
+    if ((md->data() + slot)->isUndefined()) {
+        // Function objects are only created once they are used.
+        QV4::Function *runtimeFunction
+                = compilationUnit->runtimeFunctions[compiledObject->functionOffsetTable()[index]];
+        QV4::Scope scope(engine);
+        QV4::ScopedContext qmlContext(
+                scope, QV4::QmlContext::create(engine->rootContext(), ctxt.contextData(), object));
+        QV4::ScopedValue function(scope);
+        if (runtimeFunction->isGenerator())
+            function = QV4::GeneratorFunction::create(qmlContext, runtimeFunction);
+        else
+            function = QV4::FunctionObject::createScriptFunction(qmlContext, runtimeFunction);
+        md->set(engine, slot, function);
+    }
+
+    return (md->data() + slot)->asReturnedValue();
 }
 
 QV4::ReturnedValue QQmlVMEMetaObject::readVarProperty(int id) const
@@ -1300,7 +1322,7 @@ void QQmlVMEMetaObject::setVMEProperty(int index, const QV4::Value &v)
     return writeVarProperty(index - propOffset(), v);
 }
 
-void QQmlVMEMetaObject::ensureQObjectWrapper()
+void QQmlVMEMetaObject::ensureQObjectWrapper() const
 {
     Q_ASSERT(cache);
     QV4::QObjectWrapper::wrap(engine, object);
@@ -163,7 +163,7 @@ public:
 
     QQmlVMEMetaObjectEndpoint *aliasEndpoints;
 
-    QV4::WeakValue propertyAndMethodStorage;
+    mutable QV4::WeakValue propertyAndMethodStorage;
     QV4::MemberData *propertyAndMethodStorageAsMemberData() const;
 
     int readPropertyAsInt(int id) const;
@@ -199,7 +199,7 @@ public:
 
     void writeProperty(int id, QObject *v);
 
-    void ensureQObjectWrapper();
+    void ensureQObjectWrapper() const;
 
     void mark(QV4::MarkStack *markStack);
 
@@ -1355,6 +1355,43 @@ bool QQmlJSCodeGenerator::inlineStringMethod(const QString &name, int base, int
     return true;
 }
 
+bool QQmlJSCodeGenerator::inlineArrayMethod(const QString &name, int base, int argc, int argv)
+{
+    if (argc != 1 || m_state.accumulatorOut().variant() != QQmlJSRegisterContent::MethodReturnValue)
+        return false;
+
+    const QQmlJSScope::ConstPtr stored = registerType(base).storedType();
+    if (stored->isListProperty())
+        return false;
+
+    const QString list = registerVariable(base);
+    const QString element = conversion(
+                registerType(argv).storedType(), stored->valueType(), registerVariable(argv));
+
+    QString expression;
+    QQmlJSScope::ConstPtr result;
+    if (name == u"indexOf"_s) {
+        expression = u"int("_s + list + u".indexOf("_s + element + u"))"_s;
+        result = m_typeResolver->intType();
+    } else if (name == u"lastIndexOf"_s) {
+        expression = u"int("_s + list + u".lastIndexOf("_s + element + u"))"_s;
+        result = m_typeResolver->intType();
+    } else if (name == u"includes"_s) {
+        expression = list + u".contains("_s + element + u')';
+        result = m_typeResolver->boolType();
+    } else {
+        return false;
+    }
+
+    // Searching a list has no side effects. If the result is not stored, there is nothing to do.
+    if (m_state.changedRegisterIndex() != Accumulator)
+        return true;
+
+    m_body += m_state.accumulatorVariableOut + u" = "_s
+            + conversion(result, m_state.accumulatorOut().storedType(), expression) + u";\n"_s;
+    return true;
+}
+
 bool QQmlJSCodeGenerator::inlineTranslateMethod(const QString &name, int argc, int argv)
 {
     addInclude(u"qcoreapplication.h"_s);
@@ -1670,6 +1707,11 @@ void QQmlJSCodeGenerator::generate_CallPropertyLookup(int index, int base, int a
                 return;
         }
 
+        if (baseType.storedType()->accessSemantics() == QQmlJSScope::AccessSemantics::Sequence) {
+            if (inlineArrayMethod(name, base, argc, argv))
+                return;
+        }
+
         // This is possible, once we establish the right kind of lookup for it
         reject(u"call to property '%1' of %2"_s.arg(name, baseType.descriptiveName()));
     }
@@ -1988,10 +2030,50 @@ void QQmlJSCodeGenerator::generate_DefineArray(int argc, int args)
 
 void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int argc, int args)
 {
-    Q_UNUSED(internalClassId)
-    Q_UNUSED(argc)
-    Q_UNUSED(args)
-    reject(u"DefineObjectLiteral"_s);
+    INJECT_TRACE_INFO(generate_DefineObjectLiteral);
+
+    // The type propagator has rejected anything but plain members.
+    Q_ASSERT(argc <= m_jsUnitGenerator->jsClassSize(internalClassId));
+
+    const QQmlJSScope::ConstPtr stored = m_state.accumulatorOut().storedType();
+    const QQmlJSScope::ConstPtr variantMap = m_typeResolver->variantMapType();
+
+    if (m_typeResolver->equals(stored, variantMap)) {
+        // Only used for property lookups. The order of the keys doesn't matter then.
+        const QQmlJSScope::ConstPtr var = m_typeResolver->varType();
+        QStringList initializer;
+        for (int i = 0; i < argc; ++i) {
+            initializer += u"{ "_s
+                    + QQmlJSUtils::toLiteral(m_jsUnitGenerator->jsClassMember(internalClassId, i))
+                    + u", "_s
+                    + conversion(registerType(args + i).storedType(), var,
+                                 registerVariable(args + i))
+                    + u" }"_s;
+        }
+
+        m_body += m_state.accumulatorVariableOut + u" = QVariantMap { "_s;
+        m_body += initializer.join(u", "_s);
+        m_body += u" };\n"_s;
+        return;
+    }
+
+    // QVariantMap sorts its keys. A JavaScript object keeps them in the order they were
+    // defined in, which can be observed once the object escapes to JavaScript. Therefore,
+    // build a JavaScript object in that case.
+    const QQmlJSScope::ConstPtr jsValue = m_typeResolver->jsValueType();
+    m_body += u"{\n"_s;
+    m_body += u"QJSValue object = aotContext->engine->newObject();\n"_s;
+    for (int i = 0; i < argc; ++i) {
+        m_body += u"object.setProperty("_s
+                + QQmlJSUtils::toLiteral(m_jsUnitGenerator->jsClassMember(internalClassId, i))
+                + u", "_s
+                + conversion(registerType(args + i).storedType(), jsValue,
+                             registerVariable(args + i))
+                + u");\n"_s;
+    }
+    m_body += m_state.accumulatorVariableOut + u" = "_s;
+    m_body += conversion(jsValue, stored, u"std::move(object)"_s);
+    m_body += u";\n}\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_CreateClass(int classIndex, int heritage, int computedNames)
@@ -3021,6 +3103,13 @@ QString QQmlJSCodeGenerator::conversion(const QQmlJSScope::ConstPtr &from,
             return u"static_cast<"_s + to->internalName() + u" *>(nullptr)"_s;
     }
 
+    if (m_typeResolver->equals(from, m_typeResolver->variantMapType())
+            && !m_typeResolver->equals(to, varType) && !isJsValue(to)) {
+        // Anything but QVariant and QJSValue is created from the equivalent JavaScript object.
+        return conversion(jsValueType, to,
+                          u"aotContext->engine->toScriptValue("_s + variable + u')');
+    }
+
     if (isJsValue(from)) {
         if (m_typeResolver->equals(to, jsPrimitiveType))
             return variable + u".toPrimitive()"_s;
@@ -263,6 +263,23 @@ bool qCompileQmlFile(QmlIR::Document &irDocument, const QString &inputFileName,
                 functionsToCompile << *foe;
             }
 
+            const auto record = [&](QQmlJSAotCompilationRecord::Kind kind, const QString &name,
+                                    const QV4::CompiledData::Location &location,
+                                    const std::variant<QQmlJSAotFunction,
+                                                       QQmlJS::DiagnosticMessage> &result) {
+                QList<QQmlJSAotCompilationRecord> *records = aotCompiler->compilationRecords();
+                if (!records)
+                    return;
+                QQmlJSAotCompilationRecord entry;
+                entry.kind = kind;
+                entry.name = name;
+                entry.line = location.line();
+                entry.column = location.column();
+                if (const auto *error = std::get_if<QQmlJS::DiagnosticMessage>(&result))
+                    entry.failureReason = error->message;
+                records->append(std::move(entry));
+            };
+
             // AOT-compile bindings and functions in the same order as above so that the runtime
             // class indices match
             auto contextMap = v4CodeGen.module()->contextMap;
@@ -320,11 +337,21 @@ bool qCompileQmlFile(QmlIR::Document &irDocument, const QString &inputFileName,
                             qCDebug(lcAotCompiler) << "Generated code:" << func->code;
                             aotFunctionsByIndex[innerContext->functionIndex] = *func;
                         }
+                        record(QQmlJSAotCompilationRecord::SignalHandler,
+                               irDocument.stringAt(binding->propertyNameIndex),
+                               binding->valueLocation, innerResult);
                     }
 
                     qCDebug(lcAotCompiler) << "Compiling binding for property"
                                            << irDocument.stringAt(binding->propertyNameIndex);
                     result = aotCompiler->compileBinding(context, *binding, node);
+
+                    // The closure wrapping a signal handler is reported as the handler itself.
+                    if (!context->returnsClosure) {
+                        record(QQmlJSAotCompilationRecord::Binding,
+                               irDocument.stringAt(binding->propertyNameIndex),
+                               binding->valueLocation, result);
+                    }
                 } else if (const auto *function = bindingOrFunction.function()) {
                     Q_ASSERT(quint32(functionsToCompile.size()) > function->index);
                     auto *node = functionsToCompile[function->index].node;
@@ -336,6 +363,8 @@ bool qCompileQmlFile(QmlIR::Document &irDocument, const QString &inputFileName,
                     const QString functionName = irDocument.stringAt(function->nameIndex);
                     qCDebug(lcAotCompiler) << "Compiling function" << functionName;
                     result = aotCompiler->compileFunction(context, functionName, node);
+                    record(QQmlJSAotCompilationRecord::Function, functionName,
+                           function->location, result);
                 } else {
                     Q_UNREACHABLE();
                 }
@@ -483,37 +512,16 @@ Q_UNUSED(aotContext)
 Q_UNUSED(argumentsPtr)
 )";
 
-bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFileName, const QV4::CompiledData::SaveableUnitPointer &unit, const QQmlJSAotFunctionMap &aotFunctions, QString *errorString)
+QByteArray qQmlJSUnitAsCpp(const QString &inputFileName,
+                           const QV4::CompiledData::SaveableUnitPointer &unit,
+                           const QQmlJSAotFunctionMap &aotFunctions)
 {
-#if QT_CONFIG(temporaryfile)
-    QSaveFile f(outputFileName);
-#else
-    QFile f(outputFileName);
-#endif
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        *errorString = f.errorString();
-        return false;
-    }
+    QByteArray code;
 
-    auto writeStr = [&f, errorString](const QByteArray &data) {
-        if (f.write(data) != data.size()) {
-            *errorString = f.errorString();
-            return false;
-        }
-        return true;
-    };
-
-    if (!writeStr("// "))
-        return false;
-
-    if (!writeStr(inputFileName.toUtf8()))
-        return false;
-
-    if (!writeStr("\n"))
-        return false;
-
-    if (!writeStr("#include <QtQml/qqmlprivate.h>\n"))
-        return false;
+    code += "// ";
+    code += inputFileName.toUtf8();
+    code += "\n";
+    code += "#include <QtQml/qqmlprivate.h>\n";
 
     if (!aotFunctions.isEmpty()) {
         QStringList includes;
@@ -523,23 +531,16 @@ bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFile
 
         std::sort(includes.begin(), includes.end());
         const auto end = std::unique(includes.begin(), includes.end());
-        for (auto it = includes.begin(); it != end; ++it) {
-            if (!writeStr(QStringLiteral("#include <%1>\n").arg(*it).toUtf8()))
-                return false;
-        }
+        for (auto it = includes.begin(); it != end; ++it)
+            code += QStringLiteral("#include <%1>\n").arg(*it).toUtf8();
     }
 
-    if (!writeStr(QByteArrayLiteral("namespace QmlCacheGeneratedCode {\nnamespace ")))
-        return false;
-
-    if (!writeStr(qQmlJSSymbolNamespaceForPath(inputFileName).toUtf8()))
-        return false;
+    code += QByteArrayLiteral("namespace QmlCacheGeneratedCode {\nnamespace ");
+    code += qQmlJSSymbolNamespaceForPath(inputFileName).toUtf8();
+    code += QByteArrayLiteral(" {\nextern const unsigned char qmlData alignas(16) [];\n"
+                              "extern const unsigned char qmlData alignas(16) [] = {\n");
 
-    if (!writeStr(QByteArrayLiteral(" {\nextern const unsigned char qmlData alignas(16) [];\n"
-                                    "extern const unsigned char qmlData alignas(16) [] = {\n")))
-        return false;
-
-    unit.saveToDisk<uchar>([&writeStr](const uchar *begin, quint32 size) {
+    unit.saveToDisk<uchar>([&code](const uchar *begin, quint32 size) {
         QByteArray hexifiedData;
         {
             QTextStream stream(&hexifiedData);
@@ -557,31 +558,28 @@ bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFile
             }
             stream << '\n';
         }
-        return writeStr(hexifiedData);
+        code += hexifiedData;
+        return true;
     });
 
-
-
-    if (!writeStr("};\n"))
-        return false;
+    code += "};\n";
 
     // Suppress the following warning generated by MSVC 2019:
     //     "the usage of 'QJSNumberCoercion::toInteger' requires the compiler to capture 'this'
     //      but the current default capture mode does not allow it"
     // You clearly don't have to capture 'this' in order to call 'QJSNumberCoercion::toInteger'.
     // TODO: Remove when we don't have to support MSVC 2019 anymore. Mind the QT_WARNING_POP below.
-    if (!writeStr("QT_WARNING_PUSH\nQT_WARNING_DISABLE_MSVC(4573)\n"))
-        return false;
+    code += "QT_WARNING_PUSH\nQT_WARNING_DISABLE_MSVC(4573)\n";
 
-    writeStr(aotFunctions[FileScopeCodeIndex].code.toUtf8().constData());
+    code += aotFunctions[FileScopeCodeIndex].code.toUtf8();
     if (aotFunctions.size() <= 1) {
         // FileScopeCodeIndex is always there, but it may be the only one.
-        writeStr("extern const QQmlPrivate::TypedFunction aotBuiltFunctions[];\n"
-                 "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[] = { { 0, QMetaType::fromType<void>(), {}, nullptr } };");
+        code += "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[];\n"
+                "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[] = { { 0, QMetaType::fromType<void>(), {}, nullptr } };";
     } else {
-        writeStr(wrapCallCode);
-        writeStr("extern const QQmlPrivate::TypedFunction aotBuiltFunctions[];\n"
-                 "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[] = {\n");
+        code += wrapCallCode;
+        code += "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[];\n"
+                "extern const QQmlPrivate::TypedFunction aotBuiltFunctions[] = {\n";
 
         QString footer = QStringLiteral("});}\n");
 
@@ -601,24 +599,42 @@ bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFile
                         + argumentTypes + QStringLiteral(">()");
             }
 
-            writeStr(QStringLiteral("{ %1, QMetaType::fromType<%2>(), { %3 }, %4 },")
-                     .arg(func.key())
-                     .arg(func.value().returnType)
-                     .arg(argumentTypes)
-                     .arg(function)
-                     .toUtf8().constData());
+            code += QStringLiteral("{ %1, QMetaType::fromType<%2>(), { %3 }, %4 },")
+                    .arg(func.key())
+                    .arg(func.value().returnType)
+                    .arg(argumentTypes)
+                    .arg(function)
+                    .toUtf8();
         }
 
         // Conclude the list with a nullptr
-        writeStr("{ 0, QMetaType::fromType<void>(), {}, nullptr }");
-        writeStr("};\n");
+        code += "{ 0, QMetaType::fromType<void>(), {}, nullptr }";
+        code += "};\n";
     }
 
-    if (!writeStr("QT_WARNING_POP\n"))
+    code += "QT_WARNING_POP\n";
+    code += "}\n}\n";
+
+    return code;
+}
+
+bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFileName, const QV4::CompiledData::SaveableUnitPointer &unit, const QQmlJSAotFunctionMap &aotFunctions, QString *errorString)
+{
+#if QT_CONFIG(temporaryfile)
+    QSaveFile f(outputFileName);
+#else
+    QFile f(outputFileName);
+#endif
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = f.errorString();
         return false;
+    }
 
-    if (!writeStr("}\n}\n"))
+    const QByteArray code = qQmlJSUnitAsCpp(inputFileName, unit, aotFunctions);
+    if (f.write(code) != code.size()) {
+        *errorString = f.errorString();
         return false;
+    }
 
 #if QT_CONFIG(temporaryfile)
     if (!f.commit()) {
@@ -678,9 +694,14 @@ QQmlJS::DiagnosticMessage QQmlJSAotCompiler::diagnose(
     if (isStrict(m_document)
             && (type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg)
             && m_logger->isCategoryFatal(qmlCompiler)) {
-        qFatal("%s:%d: (strict mode) %s",
-               qPrintable(QFileInfo(m_resourcePath).fileName()),
-               location.startLine, qPrintable(message));
+        if (!m_strictModeViolations) {
+            qFatal("%s:%d: (strict mode) %s",
+                   qPrintable(QFileInfo(m_resourcePath).fileName()),
+                   location.startLine, qPrintable(message));
+        }
+        m_strictModeViolations->append(QQmlJS::DiagnosticMessage {
+            u"(strict mode) "_s + message, QtCriticalMsg, location
+        });
     }
 
     // TODO: this is a special place that explicitly sets the severity through
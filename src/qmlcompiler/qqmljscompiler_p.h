@@ -53,6 +53,21 @@ struct Q_QMLCOMPILER_PRIVATE_EXPORT QQmlJSAotFunction
     QString returnType;
 };
 
+// The outcome of compiling one binding or function to C++. If it was rejected, the generated
+// code falls back to the byte code at run time.
+struct QQmlJSAotCompilationRecord
+{
+    enum Kind { Binding, SignalHandler, Function };
+
+    QString name;
+    QString failureReason; // Empty if the code was compiled
+    int line = 0;
+    int column = 0;
+    Kind kind = Binding;
+
+    bool isCompiled() const { return failureReason.isEmpty(); }
+};
+
 class Q_QMLCOMPILER_PRIVATE_EXPORT QQmlJSAotCompiler
 {
 public:
@@ -71,6 +86,22 @@ public:
 
     virtual QQmlJSAotFunction globalCode() const;
 
+    QList<QQmlJSAotCompilationRecord> *compilationRecords() const { return m_records; }
+    void setCompilationRecords(QList<QQmlJSAotCompilationRecord> *records)
+    {
+        m_records = records;
+    }
+
+    // If set, violations of "pragma Strict" are collected here instead of triggering qFatal().
+    QList<QQmlJS::DiagnosticMessage> *strictModeViolations() const
+    {
+        return m_strictModeViolations;
+    }
+    void setStrictModeViolations(QList<QQmlJS::DiagnosticMessage> *violations)
+    {
+        m_strictModeViolations = violations;
+    }
+
 protected:
     virtual QQmlJS::DiagnosticMessage diagnose(
             const QString &message, QtMsgType type, const QQmlJS::SourceLocation &location) const;
@@ -87,6 +118,8 @@ protected:
 
     QQmlJSImporter *m_importer = nullptr;
     QQmlJSLogger *m_logger = nullptr;
+    QList<QQmlJSAotCompilationRecord> *m_records = nullptr;
+    QList<QQmlJS::DiagnosticMessage> *m_strictModeViolations = nullptr;
 
 private:
     QQmlJSAotFunction doCompile(
@@ -118,6 +151,9 @@ bool Q_QMLCOMPILER_PRIVATE_EXPORT qCompileJSFile(const QString &inputFileName, c
                                          QQmlJSSaveFunction saveFunction,
                                          QQmlJSCompileError *error);
 
+QByteArray Q_QMLCOMPILER_PRIVATE_EXPORT qQmlJSUnitAsCpp(const QString &inputFileName,
+                                                   const QV4::CompiledData::SaveableUnitPointer &unit,
+                                                   const QQmlJSAotFunctionMap &aotFunctions);
 bool Q_QMLCOMPILER_PRIVATE_EXPORT qSaveQmlJSUnitAsCpp(const QString &inputFileName,
                                               const QString &outputFileName,
                                               const QV4::CompiledData::SaveableUnitPointer &unit,
@@ -1053,6 +1053,9 @@ void QQmlJSTypePropagator::generate_CallProperty(int nameIndex, int base, int ar
         return;
     }
 
+    if (callBase.isList() && propagateArrayMethod(propertyName, base, argc, argv))
+        return;
+
     const auto member = m_typeResolver->memberType(callBase, propertyName);
     if (!member.isMethod()) {
         setError(u"Type %1 does not have a property %2 for calling"_s
@@ -1383,6 +1386,44 @@ bool QQmlJSTypePropagator::propagateTranslationMethod(
     return false;
 }
 
+bool QQmlJSTypePropagator::propagateArrayMethod(
+        const QString &name, int base, int argc, int argv)
+{
+    if (argc != 1)
+        return false;
+
+    const QQmlJSRegisterContent callBase = m_state.registers[base].content;
+    const QQmlJSScope::ConstPtr valueType
+            = m_typeResolver->containedType(m_typeResolver->valueType(callBase));
+    if (valueType.isNull()
+            || !m_typeResolver->equals(
+                valueType, m_typeResolver->containedType(m_state.registers[argv].content))) {
+        return false;
+    }
+
+    const bool isReal = m_typeResolver->equals(valueType, m_typeResolver->realType());
+    const bool isStrictlyComparable = m_typeResolver->equals(valueType, m_typeResolver->intType())
+            || m_typeResolver->equals(valueType, m_typeResolver->boolType())
+            || m_typeResolver->equals(valueType, m_typeResolver->stringType());
+
+    // For these types QList's operator== matches JavaScript's strict equality. includes() uses
+    // SameValueZero, though, which considers NaN equal to itself.
+    QQmlJSScope::ConstPtr result;
+    if ((name == u"indexOf"_s || name == u"lastIndexOf"_s) && (isReal || isStrictlyComparable))
+        result = m_typeResolver->intType();
+    else if (name == u"includes"_s && isStrictlyComparable)
+        result = m_typeResolver->boolType();
+    else
+        return false;
+
+    addReadRegister(base, callBase);
+    addReadRegister(argv, m_typeResolver->globalType(valueType));
+    setAccumulator(m_typeResolver->returnType(
+                       result, QQmlJSRegisterContent::MethodReturnValue,
+                       m_typeResolver->containedType(callBase)));
+    return true;
+}
+
 void QQmlJSTypePropagator::propagateStringArgCall(int argv)
 {
     setAccumulator(m_typeResolver->returnType(
@@ -1676,12 +1717,23 @@ void QQmlJSTypePropagator::generate_DefineArray(int argc, int args)
 
 void QQmlJSTypePropagator::generate_DefineObjectLiteral(int internalClassId, int argc, int args)
 {
-    // TODO: computed property names, getters, and setters are unsupported. How do we catch them?
+    // Computed property names, getters, setters, and methods are passed as additional arguments
+    // after the plain members of the internal class.
+    const int classSize = m_jsUnitGenerator->jsClassSize(internalClassId);
+    if (argc > classSize) {
+        setError(u"object literals with computed property names, getters, setters, or methods "
+                 "are not supported"_s);
+        setAccumulator(m_typeResolver->globalType(m_typeResolver->jsValueType()));
+        return;
+    }
 
-    Q_UNUSED(internalClassId)
-    Q_UNUSED(argc)
-    Q_UNUSED(args)
-    setAccumulator(m_typeResolver->globalType(m_typeResolver->jsValueType()));
+    setAccumulator(m_typeResolver->globalType(m_typeResolver->variantMapType()));
+
+    // Track all members as QVariant. They end up in a QVariantMap, or are converted to
+    // QJSValue for the JavaScript object the literal escapes as.
+    const QQmlJSRegisterContent memberType = m_typeResolver->globalType(m_typeResolver->varType());
+    for (int i = 0; i < argc; ++i)
+        addReadRegister(args + i, memberType);
 }
 
 void QQmlJSTypePropagator::generate_CreateClass(int classIndex, int heritage, int computedNames)
@@ -214,6 +214,7 @@ private:
             const QQmlJSScope::ConstPtr &scope);
     bool propagateTranslationMethod(const QList<QQmlJSMetaMethod> &methods, int argc, int argv);
     void propagateStringArgCall(int argv);
+    bool propagateArrayMethod(const QString &name, int base, int argc, int argv);
     void propagatePropertyLookup(const QString &name);
     void propagateScopeLookupCall(const QString &functionName, int argc, int argv);
     void saveRegisterStateForJump(int offset);
@@ -941,6 +941,11 @@ bool QQmlJSTypeResolver::canPrimitivelyConvertFromTo(
         return true;
     if (equals(from, m_jsValueType) || equals(to, m_jsValueType))
         return true;
+
+    // Object literals are QVariantMaps. They convert like the equivalent JavaScript objects.
+    if (equals(from, m_variantMapType))
+        return true;
+
     if (isNumeric(from) && isNumeric(to))
         return true;
     if (isNumeric(from) && equals(to, m_boolType))
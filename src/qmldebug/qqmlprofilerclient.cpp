@@ -96,8 +96,15 @@ void QQmlProfilerClientPrivate::processCurrentEvent()
         break;
     }
     case RangeData:
-        if (!rangesInProgress.isEmpty())
-            rangesInProgress.top().type.setData(currentEvent.type.data());
+        if (!rangesInProgress.isEmpty()) {
+            QQmlProfilerTypedEvent &range = rangesInProgress.top();
+            range.type.setData(currentEvent.type.data());
+
+            // Execution counts follow the stage and the execution mode in the range numbers.
+            const auto counts = currentEvent.event.numbers<QVarLengthArray<qint64>, qint64>();
+            for (int i = 1; i < counts.size(); ++i)
+                range.event.setNumber<qint64>(i + 1, counts[i]);
+        }
         break;
     case RangeLocation:
         if (!rangesInProgress.isEmpty())
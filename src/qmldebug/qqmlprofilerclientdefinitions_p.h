@@ -56,6 +56,15 @@ enum RangeType {
     MaximumRangeType
 };
 
+// Sent with the start of Javascript ranges.
+enum JavaScriptExecutionMode {
+    JavaScriptInterpreted,
+    JavaScriptJitCompiled,
+    JavaScriptAotCompiled,
+
+    MaximumJavaScriptExecutionMode
+};
+
 enum PixmapEventType {
     PixmapSizeKnown,
     PixmapReferenceCountChanged,
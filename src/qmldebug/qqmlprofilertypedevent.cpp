@@ -139,6 +139,16 @@ QDataStream &operator>>(QDataStream &stream, QQmlProfilerTypedEvent &event)
 
         event.type = QQmlProfilerEventType(MaximumMessage, rangeType, -1);
         event.event.setRangeStage(RangeStart);
+
+        // Javascript ranges may additionally carry the way the function was executed.
+        if (rangeType == Javascript && !stream.atEnd()) {
+            qint32 executionMode;
+            stream >> executionMode;
+            if (stream.status() == QDataStream::Ok && executionMode >= 0
+                    && executionMode < MaximumJavaScriptExecutionMode) {
+                event.event.setNumbers<qint8>({ qint8(RangeStart), qint8(executionMode) });
+            }
+        }
         break;
     }
     case RangeData: {
@@ -150,6 +160,16 @@ QDataStream &operator>>(QDataStream &stream, QQmlProfilerTypedEvent &event)
         event.event.setRangeStage(RangeData);
         if (!stream.atEnd())
             stream >> event.serverTypeId;
+
+        // Javascript ranges may additionally carry the execution counts of the function.
+        if (rangeType == Javascript && !stream.atEnd()) {
+            quint32 interpreted, jitCompiled, aotCompiled;
+            stream >> interpreted >> jitCompiled >> aotCompiled;
+            if (stream.status() == QDataStream::Ok) {
+                event.event.setNumbers<qint64>({ qint64(RangeData), qint64(interpreted),
+                                                 qint64(jitCompiled), qint64(aotCompiled) });
+            }
+        }
         break;
     }
     case RangeLocation: {
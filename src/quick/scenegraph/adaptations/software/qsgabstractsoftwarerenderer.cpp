@@ -9,13 +9,29 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVarLengthArray>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
+#include <atomic>
+#include <memory>
+
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+// Tiles are horizontal bands of the update region. There are a few more of
+// them than threads so that threads finishing early can pick up more work.
+static const int MIN_TILE_HEIGHT = 32;
+static const int TILES_PER_THREAD = 4;
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_tileThreadPool)
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
@@ -107,6 +123,113 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+bool QSGAbstractSoftwareRenderer::canRenderNodesInTiles(QPaintDevice *device, const QRegion &updateRegion) const
+{
+    // Each tile gets its own QImage on the same pixels, so the target must be
+    // an image, and tile edges must fall on whole device pixels.
+    if (device->devType() != QInternal::Image)
+        return false;
+    const qreal dpr = device->devicePixelRatio();
+    if (!qFuzzyCompare(dpr, qreal(qRound(dpr))))
+        return false;
+    if (updateRegion.boundingRect().height() < 2 * MIN_TILE_HEIGHT)
+        return false;
+
+    // QSGRenderNode implementations paint through the render context's
+    // active painter, and may do anything in there.
+    for (auto node : m_renderableNodes) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode && node->isDirty())
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Paints the render list like renderNodes(), but splits the update region
+ * into tiles that are painted in parallel by threadCount additional threads
+ * and the calling one. Requires canRenderNodesInTiles() to be true.
+ */
+QRegion QSGAbstractSoftwareRenderer::renderNodesInTiles(QImage *image, const QRegion &updateRegion, int threadCount)
+{
+    QRegion dirtyRegion;
+    if (m_renderableNodes.isEmpty())
+        return dirtyRegion;
+
+    const qreal dpr = image->devicePixelRatio();
+    const QRect bounds = updateRegion.boundingRect();
+    const int tileCount = qBound(1, bounds.height() / MIN_TILE_HEIGHT, (threadCount + 1) * TILES_PER_THREAD);
+    QVarLengthArray<QRect, 64> tiles;
+    for (int i = 0; i < tileCount; ++i) {
+        const int top = bounds.top() + bounds.height() * i / tileCount;
+        const int bottom = bounds.top() + bounds.height() * (i + 1) / tileCount;
+        tiles.append(QRect(bounds.left(), top, bounds.width(), bottom - top));
+    }
+
+    QVarLengthArray<QSGSoftwareRenderableNode *, 256> nodes;
+    for (auto node : std::as_const(m_renderableNodes)) {
+        if (node->needsPainting()) {
+            node->prepareTilePainting(dpr);
+            nodes.append(node);
+        }
+    }
+
+    // The glyph caches of the font engines are shared between all threads.
+    QMutex glyphMutex;
+    auto backgroundNode = m_renderableNodes.constFirst();
+    uchar *bits = image->bits();
+    const auto renderTile = [&](int tile) {
+        QImage tileImage(bits, image->width(), image->height(), image->bytesPerLine(), image->format());
+        tileImage.setDevicePixelRatio(dpr);
+        QPainter painter(&tileImage);
+        painter.setRenderHint(QPainter::Antialiasing);
+        for (auto node : std::as_const(nodes)) {
+            const bool forceOpaquePainting = node == backgroundNode;
+            if (node->type() == QSGSoftwareRenderableNode::Glyph) {
+                QMutexLocker locker(&glyphMutex);
+                node->paintTile(&painter, tiles.at(tile), forceOpaquePainting);
+            } else {
+                node->paintTile(&painter, tiles.at(tile), forceOpaquePainting);
+            }
+        }
+    };
+
+    threadCount = qMin(threadCount, tileCount - 1);
+    if (nodes.isEmpty()) {
+        // Nothing to paint, only the dirty state needs resetting below.
+    } else if (threadCount <= 0) {
+        for (int tile = 0; tile < tileCount; ++tile)
+            renderTile(tile);
+    } else {
+        // Tasks that only start once all tiles are done may outlive this
+        // function. They must not touch anything but the shared state then.
+        struct SharedState {
+            std::atomic<int> nextTile { 0 };
+            QSemaphore finishedTiles;
+        };
+        const auto state = std::make_shared<SharedState>();
+        const auto work = [state, tileCount, &renderTile]() {
+            int rendered = 0;
+            for (int tile = state->nextTile++; tile < tileCount; tile = state->nextTile++) {
+                renderTile(tile);
+                ++rendered;
+            }
+            return rendered;
+        };
+
+        QThreadPool *pool = qsg_tileThreadPool();
+        for (int i = 0; i < threadCount; ++i)
+            pool->start([state, work]() { state->finishedTiles.release(work()); });
+
+        state->finishedTiles.acquire(tileCount - work());
+    }
+
+    for (auto node : std::as_const(m_renderableNodes))
+        dirtyRegion += node->finishPainting();
+
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
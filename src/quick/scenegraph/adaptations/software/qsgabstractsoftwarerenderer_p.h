@@ -21,6 +21,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QImage;
+class QPaintDevice;
 class QSGSimpleRectNode;
 
 class QSGSoftwareRenderableNode;
@@ -42,6 +44,8 @@ public:
 
 protected:
     QRegion renderNodes(QPainter *painter);
+    bool canRenderNodesInTiles(QPaintDevice *device, const QRegion &updateRegion) const;
+    QRegion renderNodesInTiles(QImage *image, const QRegion &updateRegion, int threadCount);
     void buildRenderList();
     QRegion optimizeRenderList();
 
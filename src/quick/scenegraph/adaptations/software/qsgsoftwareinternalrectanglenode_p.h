@@ -41,6 +41,7 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    void updateDevicePixelRatio(qreal devicePixelRatio);
 
     bool isOpaque() const;
     QRectF rect() const;
@@ -60,8 +60,7 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
 
 void QSGSoftwareImageNode::paint(QPainter *painter)
 {
-    if (m_cachedMirroredPixmapIsDirty)
-        updateCachedMirroredPixmap();
+    updateCachedPixmap();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
     // Disable antialiased clipping. It causes transformed tiles to have gaps.
@@ -81,6 +80,12 @@ void QSGSoftwareImageNode::paint(QPainter *painter)
     }
 }
 
+void QSGSoftwareImageNode::updateCachedPixmap()
+{
+    if (m_cachedMirroredPixmapIsDirty)
+        updateCachedMirroredPixmap();
+}
+
 void QSGSoftwareImageNode::updateCachedMirroredPixmap()
 {
     if (m_transformMode == NoTransform) {
@@ -213,11 +213,8 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
+        if (!needsPainting())
+            return finishPainting();
     } else {
         if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
             m_isDirty = false;
@@ -250,12 +247,61 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         }
     }
 
+    paint(painter, m_dirtyRegion, forceOpaquePainting);
+    return finishPainting();
+}
+
+void QSGSoftwareRenderableNode::prepareTilePainting(qreal devicePixelRatio)
+{
+    // Update the caches that paint() would otherwise update lazily, so that
+    // painting the tiles only reads from the nodes.
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->updateDevicePixelRatio(devicePixelRatio);
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->updateCachedPixmap();
+        break;
+    default:
+        break;
+    }
+}
+
+void QSGSoftwareRenderableNode::paintTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting) const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
+    const QRegion region = m_dirtyRegion.intersected(tile);
+    if (!region.isEmpty())
+        paint(painter, region, forceOpaquePainting);
+}
+
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
+    QRegion areaToBeFlushed;
+    if (needsPainting()) {
+        areaToBeFlushed = m_dirtyRegion;
+        m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    }
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+
+    return areaToBeFlushed;
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &region, bool forceOpaquePainting) const
+{
     painter->save();
     painter->setOpacity(m_opacity);
 
-    // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
+    // Set clipRegion to the dirty region (in world coordinates, so must be done before the setTransform below)
     // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    painter->setClipRegion(region, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
@@ -310,13 +356,6 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     }
 
     painter->restore();
-
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
-    m_isDirty = false;
-    m_dirtyRegion = QRegion();
-
-    return areaToBeFlushed;
 }
 
 bool QSGSoftwareRenderableNode::isDirtyRegionEmpty() const
@@ -62,6 +62,13 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+    // Painting a frame in several parts, possibly on several threads:
+    // prepareTilePainting() once, then paintTile() for each tile, then
+    // finishPainting() to get the region to flush.
+    void prepareTilePainting(qreal devicePixelRatio);
+    void paintTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting = false) const;
+    QRegion finishPainting();
+    bool needsPainting() const;
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -87,6 +94,8 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    void paint(QPainter *painter, const QRegion &region, bool forceOpaquePainting) const;
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
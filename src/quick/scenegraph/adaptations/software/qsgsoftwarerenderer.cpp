@@ -10,7 +10,9 @@
 
 #include <QtGui/QPaintDevice>
 #include <QtGui/QBackingStore>
+#include <QtGui/QImage>
 #include <QElapsedTimer>
+#include <QThread>
 
 Q_LOGGING_CATEGORY(lcRenderer, "qt.scenegraph.softwarecontext.renderer")
 
@@ -21,6 +23,11 @@ QSGSoftwareRenderer::QSGSoftwareRenderer(QSGRenderContext *context)
     , m_paintDevice(nullptr)
     , m_backingStore(nullptr)
 {
+    // The render thread paints tiles, too.
+    bool ok = false;
+    m_tileThreadCount = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDERER_THREADS", &ok);
+    if (!ok)
+        m_tileThreadCount = qBound(0, QThread::idealThreadCount() - 1, 3);
 }
 
 QSGSoftwareRenderer::~QSGSoftwareRenderer()
@@ -109,22 +116,31 @@ void QSGSoftwareRenderer::render()
         paintDevice = backingStore->paintDevice();
     }
 
-    QPainter painter(paintDevice);
-    painter.setRenderHint(QPainter::Antialiasing);
-    auto rc = static_cast<QSGSoftwareRenderContext *>(context());
-    QPainter *prevPainter = rc->m_activePainter;
-    rc->m_activePainter = &painter;
-
     // Render the contents Renderlist
-    m_flushRegion = renderNodes(&painter);
+    // Large updates of image backed paint devices are split into tiles
+    // that are painted on several threads.
+    const bool renderInTiles = m_tileThreadCount > 0 && canRenderNodesInTiles(paintDevice, updateRegion);
+    if (renderInTiles) {
+        m_flushRegion = renderNodesInTiles(static_cast<QImage *>(paintDevice), updateRegion, m_tileThreadCount);
+    } else {
+        QPainter painter(paintDevice);
+        painter.setRenderHint(QPainter::Antialiasing);
+        auto rc = static_cast<QSGSoftwareRenderContext *>(context());
+        QPainter *prevPainter = rc->m_activePainter;
+        rc->m_activePainter = &painter;
+
+        m_flushRegion = renderNodes(&painter);
+
+        painter.end();
+        rc->m_activePainter = prevPainter;
+    }
     qint64 renderTime = renderTimer.elapsed();
 
-    painter.end();
     if (backingStore != nullptr)
         backingStore->endPaint();
 
-    rc->m_activePainter = prevPainter;
-    qCDebug(lcRenderer) << "render" << m_flushRegion << buildRenderListTime << optimizeRenderListTime << renderTime;
+    qCDebug(lcRenderer) << "render" << m_flushRegion << buildRenderListTime << optimizeRenderListTime << renderTime
+                        << (renderInTiles ? "tiled" : "serial");
 }
 
 QT_END_NAMESPACE
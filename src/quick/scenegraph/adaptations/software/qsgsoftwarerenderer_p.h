@@ -41,6 +41,7 @@ private:
     QPaintDevice* m_paintDevice;
     QBackingStore* m_backingStore;
     QRegion m_flushRegion;
+    int m_tileThreadCount;
 };
 
 QT_END_NAMESPACE
@@ -8,6 +8,9 @@
 #include <qmath.h>
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtNumeric>
 
 #include <QtGui/QGuiApplication>
@@ -17,7 +20,13 @@
 
 #include "qsgrhivisualizer_p.h"
 
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+#include <QtQuick/qsgvertexcolormaterial.h>
+
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -44,6 +53,11 @@ DECLARE_DEBUG_VAR(noopaque)
 DECLARE_DEBUG_VAR(noclip)
 #undef DECLARE_DEBUG_VAR
 
+// The number of vertices filled in by one task when uploading batches in parallel.
+static const int UPLOAD_CHUNK_VERTICES = 4096;
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_uploadThreadPool)
+
 #define QSGNODE_TRAVERSE(NODE) for (QSGNode *child = NODE->firstChild(); child; child = child->nextSibling())
 #define SHADOWNODE_TRAVERSE(NODE) for (Node *child = NODE->firstChild(); child; child = child->sibling())
 
@@ -849,6 +863,9 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     , m_currentShader(nullptr)
     , m_vertexUploadPool(256)
     , m_indexUploadPool(64)
+    , m_batchUploads(16)
+    , m_elementUploads(64)
+    , m_elementUploadChunks(16)
 {
     m_rhi = m_context->rhi();
     Q_ASSERT(m_rhi); // no more direct OpenGL code path in Qt 6
@@ -877,10 +894,16 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
+    // The render thread fills in vertex and index data, too.
+    m_uploadThreadCount = qt_sg_envInt("QSG_RENDERER_UPLOAD_THREADS",
+                                       qBound(0, QThread::idealThreadCount() - 1, 3));
+    m_occlusionCulling = qt_sg_envInt("QSG_RENDERER_OCCLUSION_CULLING", 1) != 0
+            && m_renderMode != QSGRendererInterface::RenderMode3D;
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
-        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d",
-               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold);
+        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d upload threads: %d occlusion culling: %d",
+               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold,
+               m_uploadThreadCount, m_occlusionCulling);
     }
 }
 
@@ -975,15 +998,23 @@ void Renderer::invalidateAndRecycleBatch(Batch *b)
     m_batchPool.add(b);
 }
 
+// Keeps the ranges of the upload pools suitably aligned for any vertex attribute.
+static inline quint32 qsg_alignUploadSize(quint32 byteSize)
+{
+    return (byteSize + 15) & ~quint32(15);
+}
+
 void Renderer::map(Buffer *buffer, quint32 byteSize, bool isIndexBuf)
 {
     if (m_visualizer->mode() == Visualizer::VisualizeNothing) {
         // Common case, use a shared memory pool for uploading vertex data to avoid
-        // excessive reevaluation
+        // excessive reevaluation. Each batch uploaded in a frame gets its own range of the
+        // pool, so that the batches can be filled in parallel.
         QDataBuffer<char> &pool = isIndexBuf ? m_indexUploadPool : m_vertexUploadPool;
-        if (byteSize > quint32(pool.size()))
-            pool.resize(byteSize);
-        buffer->data = pool.data();
+        quint32 &offset = isIndexBuf ? m_indexUploadOffset : m_vertexUploadOffset;
+        Q_ASSERT(offset + byteSize <= quint32(pool.size()));
+        buffer->data = pool.data() + offset;
+        offset += qsg_alignUploadSize(byteSize);
     } else if (buffer->size != byteSize) {
         free(buffer->data);
         buffer->data = (char *) malloc(byteSize);
@@ -1287,6 +1318,14 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
             debug << node;
     }
 #endif
+    // Anything that moves, reshapes or recolors an element can change what
+    // it occludes or is occluded by.
+    if (state & (QSGNode::DirtyGeometry | QSGNode::DirtyMaterial | QSGNode::DirtyMatrix
+                 | QSGNode::DirtyOpacity | QSGNode::DirtyNodeAdded | QSGNode::DirtyNodeRemoved
+                 | QSGNode::DirtySubtreeBlocked)) {
+        m_occlusionDirty = true;
+    }
+
     // As this function calls nodeChanged recursively, we do it at the top
     // to avoid that any of the others are processed twice.
     if (state & QSGNode::DirtySubtreeBlocked) {
@@ -1645,11 +1684,232 @@ void Renderer::cleanupBatches(QDataBuffer<Batch *> *batches) {
     }
 }
 
+/*
+ * Returns true when the geometry of \a e, transformed by \a matrix, exactly
+ * covers an axis-aligned rectangle, which is then stored in \a rect. Only
+ * four vertex triangle strips whose vertices are the corners of the
+ * rectangle, with the two triangles sharing a diagonal, qualify.
+ */
+static bool qsg_coveredRect(Element *e, const QMatrix4x4 &matrix, Rect *rect)
+{
+    QSGGeometry *g = e->node->geometry();
+    if (g->drawingMode() != QSGGeometry::DrawTriangleStrip)
+        return false;
+    const int offset = qsg_positionAttribute(g);
+    if (offset == -1)
+        return false;
+
+    int indices[4] = { 0, 1, 2, 3 };
+    if (g->indexCount() == 4) {
+        for (int i = 0; i < 4; ++i) {
+            indices[i] = g->indexType() == QSGGeometry::UnsignedIntType ? int(g->indexDataAsUInt()[i])
+                                                                        : int(g->indexDataAsUShort()[i]);
+            if (indices[i] >= g->vertexCount())
+                return false;
+        }
+    } else if (g->indexCount() != 0 || g->vertexCount() != 4) {
+        return false;
+    }
+
+    // Only 2D affine transforms keep the rectangle a flat rectangle on screen.
+    const float *m = matrix.constData();
+    if (m[3] != 0 || m[7] != 0 || m[11] != 0 || m[15] != 1)
+        return false;
+
+    Pt p[4];
+    const char *vd = static_cast<const char *>(g->vertexData()) + offset;
+    for (int i = 0; i < 4; ++i) {
+        p[i] = *reinterpret_cast<const Pt *>(vd + indices[i] * g->sizeOfVertex());
+        p[i].map(matrix);
+    }
+
+    rect->set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i = 0; i < 4; ++i)
+        *rect |= p[i];
+    if (!(rect->tl.x < rect->br.x && rect->tl.y < rect->br.y) || rect->isOutsideFloatRange())
+        return false;
+
+    const auto isCorner = [rect](const Pt &pt) {
+        return (pt.x == rect->tl.x || pt.x == rect->br.x) && (pt.y == rect->tl.y || pt.y == rect->br.y);
+    };
+    const auto isOpposite = [](const Pt &a, const Pt &b) {
+        return a.x != b.x && a.y != b.y;
+    };
+    for (int i = 0; i < 4; ++i) {
+        if (!isCorner(p[i]))
+            return false;
+    }
+    return isOpposite(p[0], p[3]) && isOpposite(p[1], p[2])
+            && !(p[1].x == p[0].x && p[1].y == p[0].y) && !(p[1].x == p[3].x && p[1].y == p[3].y);
+}
+
+/*
+ * Returns true when every vertex of \a g has a fully opaque color.
+ */
+static bool qsg_hasOpaqueVertexColors(QSGGeometry *g)
+{
+    int offset = 0;
+    for (int a = 0; a < g->attributeCount(); ++a) {
+        const QSGGeometry::Attribute &attr = g->attributes()[a];
+        if (attr.attributeType == QSGGeometry::ColorAttribute) {
+            if (attr.tupleSize != 4 || attr.type != QSGGeometry::UnsignedByteType)
+                return false;
+            const uchar *vd = static_cast<const uchar *>(g->vertexData()) + offset;
+            for (int i = 0; i < g->vertexCount(); ++i) {
+                if (vd[i * g->sizeOfVertex() + 3] != 255)
+                    return false;
+            }
+            return true;
+        }
+        offset += attr.tupleSize * size_of_type(attr.type);
+    }
+    return false;
+}
+
+/*
+ * Returns true when \a e fills every fragment of its geometry with opaque
+ * color. Only materials known to do so qualify; custom materials might
+ * discard fragments, so they never occlude anything.
+ */
+static bool qsg_isOpaqueFill(Element *e)
+{
+    QSGMaterial *material = e->node->activeMaterial();
+    // QSGVertexColorMaterial is created with blending enabled, and only
+    // Rectangle nodes turn it off for opaque colors, so look at the colors.
+    if (dynamic_cast<QSGVertexColorMaterial *>(material))
+        return qsg_hasOpaqueVertexColors(e->node->geometry());
+    return !e->isMaterialBlended
+            && (dynamic_cast<QSGFlatColorMaterial *>(material)
+                || dynamic_cast<QSGOpaqueTextureMaterial *>(material));
+}
+
+/*
+ * Conservative CPU occlusion culling. The largest unclipped opaque elements
+ * whose geometry is an axis-aligned rectangle act as occluders. Any element
+ * drawn before an occluder and lying entirely within it is flagged as
+ * occluded, and is left out of the batches until that changes.
+ *
+ * Only called when the render lists were rebuilt or a node's geometry,
+ * material, matrix or opacity changed since the last time.
+ */
+void Renderer::updateOcclusion()
+{
+    struct Occluder {
+        Rect rect;
+        float area;
+        int order;
+    };
+    // Testing every element against every occluder is quadratic, so only the
+    // largest ones are used. In practice these are the backgrounds of pages,
+    // popups and the like.
+    static const int MAX_OCCLUDERS = 16;
+    QVarLengthArray<Occluder, MAX_OCCLUDERS + 1> occluders;
+
+    const auto worldBounds = [](Element *e, Node **lastRoot, QMatrix4x4 *rootMatrix) {
+        if (e->root != *lastRoot) {
+            *lastRoot = e->root;
+            *rootMatrix = e->root ? qsg_matrixForRoot(e->root) : QMatrix4x4();
+        }
+        e->ensureBoundsValid();
+        Rect bounds = e->bounds;
+        const float *m = rootMatrix->constData();
+        if (m[3] != 0 || m[7] != 0 || m[11] != 0 || m[15] != 1)
+            bounds.set(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX);
+        else if (e->root && !bounds.isOutsideFloatRange())
+            bounds.map(*rootMatrix);
+        return bounds;
+    };
+
+    Node *lastRoot = nullptr;
+    QMatrix4x4 rootMatrix;
+    for (const QDataBuffer<Element *> *list : { &m_opaqueRenderList, &m_alphaRenderList }) {
+        for (int i = 0; i < list->size(); ++i) {
+            Element *e = list->at(i);
+            if (!e || e->removed || e->isRenderNode)
+                continue;
+            QSGGeometryNode *gn = e->node;
+            if (gn->clipList() || gn->inheritedOpacity() <= OPAQUE_LIMIT || !qsg_isOpaqueFill(e))
+                continue;
+            if (e->root != lastRoot) {
+                lastRoot = e->root;
+                rootMatrix = e->root ? qsg_matrixForRoot(e->root) : QMatrix4x4();
+            }
+            Occluder o;
+            if (!qsg_coveredRect(e, rootMatrix * *gn->matrix(), &o.rect))
+                continue;
+            o.area = (o.rect.br.x - o.rect.tl.x) * (o.rect.br.y - o.rect.tl.y);
+            o.order = e->order;
+            int pos = occluders.size();
+            while (pos > 0 && occluders.at(pos - 1).area < o.area)
+                --pos;
+            if (pos < MAX_OCCLUDERS) {
+                occluders.insert(pos, o);
+                if (occluders.size() > MAX_OCCLUDERS)
+                    occluders.removeLast();
+            }
+        }
+    }
+
+    // Nothing occludes anything, and nothing was occluded before either.
+    if (occluders.isEmpty() && m_occludedElementCount == 0)
+        return;
+
+    m_occludedElementCount = 0;
+    lastRoot = nullptr;
+    rootMatrix.setToIdentity();
+    for (const QDataBuffer<Element *> *list : { &m_opaqueRenderList, &m_alphaRenderList }) {
+        const bool isAlphaList = list == &m_alphaRenderList;
+        for (int i = 0; i < list->size(); ++i) {
+            Element *e = list->at(i);
+            if (!e || e->removed || e->isRenderNode)
+                continue;
+
+            bool occluded = false;
+            if (!occluders.isEmpty()) {
+                const Rect bounds = worldBounds(e, &lastRoot, &rootMatrix);
+                if (!bounds.isOutsideFloatRange()) {
+                    for (const Occluder &o : std::as_const(occluders)) {
+                        if (o.order > e->order
+                                && o.rect.tl.x <= bounds.tl.x && o.rect.tl.y <= bounds.tl.y
+                                && o.rect.br.x >= bounds.br.x && o.rect.br.y >= bounds.br.y) {
+                            occluded = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (occluded)
+                ++m_occludedElementCount;
+
+            if (e->occluded == occluded)
+                continue;
+            e->occluded = occluded;
+
+            if (occluded) {
+                if (e->batch)
+                    invalidateBatchAndOverlappingRenderOrders(e->batch);
+            } else if (isAlphaList) {
+                // The element needs a batch again, which must be drawn
+                // between the alpha batches before and after it.
+                for (int j = 0; j < m_alphaBatches.size(); ++j) {
+                    Batch *b = m_alphaBatches.at(j);
+                    if (b->first && b->first->order < e->order && b->lastOrderInBatch > e->order)
+                        b->invalidate();
+                }
+            }
+            m_rebuild |= BuildBatches;
+        }
+    }
+
+    if (Q_UNLIKELY(debug_build()))
+        qDebug() << "Occlusion culling:" << occluders.size() << "occluders," << m_occludedElementCount << "occluded elements";
+}
+
 void Renderer::prepareOpaqueBatches()
 {
     for (int i=m_opaqueRenderList.size() - 1; i >= 0; --i) {
         Element *ei = m_opaqueRenderList.at(i);
-        if (!ei || ei->batch || ei->node->geometry()->vertexCount() == 0)
+        if (!ei || ei->batch || ei->occluded || ei->node->geometry()->vertexCount() == 0)
             continue;
         Batch *batch = newBatch();
         batch->first = ei;
@@ -1671,7 +1931,7 @@ void Renderer::prepareOpaqueBatches()
                 continue;
             if (ej->root != ei->root)
                 break;
-            if (ej->batch || ej->node->geometry()->vertexCount() == 0)
+            if (ej->batch || ej->occluded || ej->node->geometry()->vertexCount() == 0)
                 continue;
 
             QSGGeometryNode *gnj = ej->node;
@@ -1747,7 +2007,7 @@ void Renderer::prepareAlphaBatches()
             continue;
         }
 
-        if (ei->node->geometry()->vertexCount() == 0)
+        if (ei->occluded || ei->node->geometry()->vertexCount() == 0)
             continue;
 
         Batch *batch = newBatch();
@@ -1780,7 +2040,7 @@ void Renderer::prepareAlphaBatches()
             }
 
             QSGGeometryNode *gnj = ej->node;
-            if (gnj->geometry()->vertexCount() == 0)
+            if (ej->occluded || gnj->geometry()->vertexCount() == 0)
                 continue;
 
             if (gni->clipList() == gnj->clipList()
@@ -1968,22 +2228,22 @@ QMatrix4x4 qsg_matrixForRoot(Node *node)
     return *c->matrix();
 }
 
-void Renderer::uploadBatch(Batch *b)
+bool Renderer::prepareBatchUpload(Batch *b, BatchUpload *upload)
 {
     // Early out if nothing has changed in this batch..
     if (!b->needsUpload) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
-        return;
+        return false;
     }
 
     if (!b->first) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
-        return;
+        return false;
     }
 
     if (b->isRenderNode) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
-        return;
+        return false;
     }
 
     // Figure out if we can merge or not, if not, then just render the batch as is..
@@ -2028,7 +2288,7 @@ void Renderer::uploadBatch(Batch *b)
     // Abort if there are no vertices in this batch.. We abort this late as
     // this is a broken usecase which we do not care to optimize for...
     if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-        return;
+        return false;
 
     /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
@@ -2052,8 +2312,23 @@ void Renderer::uploadBatch(Batch *b)
         ibufferSize = unmergedIndexSize;
     }
 
-    map(&b->ibo, ibufferSize, true);
-    map(&b->vbo, bufferSize);
+    upload->batch = b;
+    upload->vertexBytes = bufferSize;
+    upload->indexBytes = ibufferSize;
+    return true;
+}
+
+/* Maps the buffers of a batch and decides where the data of each of its
+ * elements goes, without touching the data itself. The elements are filled in
+ * by uploadElements() afterwards.
+ */
+void Renderer::layoutBatchUpload(const BatchUpload &upload)
+{
+    Batch *b = upload.batch;
+    QSGGeometry *g = b->first->node->geometry();
+
+    map(&b->ibo, upload.indexBytes, true);
+    map(&b->vbo, upload.vertexBytes);
 
     if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
                                              << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
@@ -2064,9 +2339,8 @@ void Renderer::uploadBatch(Batch *b)
         char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
         char *indexData = b->ibo.data;
 
-        quint16 iOffset16 = 0;
-        quint32 iOffset32 = 0;
-        e = b->first;
+        quint32 iOffset = 0;
+        Element *e = b->first;
         uint verticesInSet = 0;
         // Start a new set already after 65534 vertices because 0xFFFF may be
         // used for an always-on primitive restart with some apis (adapt for
@@ -2078,7 +2352,9 @@ void Renderer::uploadBatch(Batch *b)
         const char *indexBase = b->ibo.data;
         b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
         while (e) {
-            verticesInSet += e->node->geometry()->vertexCount();
+            QSGGeometry *eg = e->node->geometry();
+            const int vCount = eg->vertexCount();
+            verticesInSet += vCount;
             if (verticesInSet > verticesInSetLimit) {
                 b->drawSets.last().indexCount = indicesInSet;
                 if (g->drawingMode() == QSGGeometry::DrawTriangleStrip) {
@@ -2089,15 +2365,21 @@ void Renderer::uploadBatch(Batch *b)
                 b->drawSets << DrawSet(vertexData - b->vbo.data,
                                        zData - b->vbo.data,
                                        drawSetIndices);
-                iOffset16 = 0;
-                iOffset32 = 0;
-                verticesInSet = e->node->geometry()->vertexCount();
+                iOffset = 0;
+                verticesInSet = vCount;
                 indicesInSet = 0;
             }
-            void *iBasePtr = &iOffset16;
-            if (m_uint32IndexForRhi)
-                iBasePtr = &iOffset32;
-            uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, iBasePtr, &indicesInSet);
+            addElementUpload({ b, e, vertexData, zData, indexData, iOffset }, vCount);
+
+            // Advance by as much as uploadMergedElement() will write for this element.
+            const int iCount = qsg_fixIndexCount(eg->indexCount() ? eg->indexCount() : vCount,
+                                                 eg->drawingMode());
+            vertexData += vCount * eg->sizeOfVertex();
+            if (useDepthBuffer())
+                zData += vCount * sizeof(float);
+            indexData += iCount * mergedIndexElemSize();
+            indicesInSet += iCount;
+            iOffset += vCount;
             e = e->nextInBatch;
         }
         b->drawSets.last().indexCount = indicesInSet;
@@ -2113,32 +2395,118 @@ void Renderer::uploadBatch(Batch *b)
         Element *e = b->first;
         while (e) {
             QSGGeometry *g = e->node->geometry();
-            int vbs = g->vertexCount() * g->sizeOfVertex();
-            memcpy(vboData, g->vertexData(), vbs);
-            vboData = vboData + vbs;
-            const int indexCount = g->indexCount();
-            if (indexCount) {
-                const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
-                const int ibs = indexCount * effectiveIndexSize;
-                if (g->sizeOfIndex() == effectiveIndexSize) {
-                    memcpy(iboData, g->indexData(), ibs);
-                } else {
-                    if (g->sizeOfIndex() == sizeof(quint16) && effectiveIndexSize == sizeof(quint32)) {
-                        quint16 *src = g->indexDataAsUShort();
-                        quint32 *dst = (quint32 *) iboData;
-                        for (int i = 0; i < indexCount; ++i)
-                            dst[i] = src[i];
-                    } else {
-                        Q_ASSERT_X(false, "uploadBatch (unmerged)", "uint index with ushort effective index - cannot happen");
-                    }
-                }
-                iboData += ibs;
-            }
+            addElementUpload({ b, e, vboData, nullptr, iboData, 0 }, g->vertexCount());
+            vboData += g->vertexCount() * g->sizeOfVertex();
+            const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
+            iboData += g->indexCount() * effectiveIndexSize;
             e = e->nextInBatch;
         }
     }
+}
+
+void Renderer::addElementUpload(const ElementUpload &upload, int vertexCount)
+{
+    if (m_elementUploadChunks.isEmpty() || m_verticesInUploadChunk >= UPLOAD_CHUNK_VERTICES) {
+        m_elementUploadChunks.add(m_elementUploads.size());
+        m_verticesInUploadChunk = 0;
+    }
+    m_elementUploads.add(upload);
+    m_verticesInUploadChunk += vertexCount;
+}
+
+/* Fills in the vertex and index data of all elements laid out by
+ * layoutBatchUpload(). Each element writes to its own range of the upload
+ * buffers, so the result does not depend on how the work is distributed.
+ * Large uploads are therefore split into chunks that are handed to a thread
+ * pool, with the render thread taking its share, too.
+ */
+void Renderer::uploadElements()
+{
+    const int chunkCount = m_elementUploadChunks.size();
+    const auto uploadChunk = [this, chunkCount](int chunk) {
+        const int end = chunk + 1 < chunkCount ? m_elementUploadChunks.at(chunk + 1)
+                                               : m_elementUploads.size();
+        for (int i = m_elementUploadChunks.at(chunk); i < end; ++i)
+            uploadElement(m_elementUploads.at(i));
+    };
+
+    // Keep the debug output in order.
+    const int threadCount = Q_UNLIKELY(debug_upload()) ? 0 : qMin(m_uploadThreadCount, chunkCount - 1);
+    if (threadCount <= 0) {
+        for (int chunk = 0; chunk < chunkCount; ++chunk)
+            uploadChunk(chunk);
+        return;
+    }
+
+    // Tasks that only start once all chunks are done may outlive this function. They must not
+    // touch anything but the shared state then.
+    struct SharedState {
+        std::atomic<int> nextChunk { 0 };
+        QSemaphore finishedChunks;
+    };
+    const auto state = std::make_shared<SharedState>();
+    const auto work = [state, chunkCount, uploadChunk]() {
+        int uploaded = 0;
+        for (int chunk = state->nextChunk++; chunk < chunkCount; chunk = state->nextChunk++) {
+            uploadChunk(chunk);
+            ++uploaded;
+        }
+        return uploaded;
+    };
+
+    QThreadPool *pool = qsg_uploadThreadPool();
+    for (int i = 0; i < threadCount; ++i)
+        pool->start([state, work]() { state->finishedChunks.release(work()); });
+
+    state->finishedChunks.acquire(chunkCount - work());
+}
+
+void Renderer::uploadElement(const ElementUpload &upload)
+{
+    Element *e = upload.element;
+
+    if (upload.batch->merged) {
+        char *vertexData = upload.vertexData;
+        char *zData = upload.zData;
+        char *indexData = upload.indexData;
+        int indexCount = 0;
+        if (m_uint32IndexForRhi) {
+            quint32 iBase = upload.indexBase;
+            uploadMergedElement(e, upload.batch->positionAttribute, &vertexData, &zData,
+                                &indexData, &iBase, &indexCount);
+        } else {
+            quint16 iBase = quint16(upload.indexBase);
+            uploadMergedElement(e, upload.batch->positionAttribute, &vertexData, &zData,
+                                &indexData, &iBase, &indexCount);
+        }
+        return;
+    }
+
+    QSGGeometry *g = e->node->geometry();
+    memcpy(upload.vertexData, g->vertexData(), g->vertexCount() * g->sizeOfVertex());
+    const int indexCount = g->indexCount();
+    if (indexCount) {
+        const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
+        if (g->sizeOfIndex() == effectiveIndexSize) {
+            memcpy(upload.indexData, g->indexData(), indexCount * effectiveIndexSize);
+        } else {
+            if (g->sizeOfIndex() == sizeof(quint16) && effectiveIndexSize == sizeof(quint32)) {
+                quint16 *src = g->indexDataAsUShort();
+                quint32 *dst = (quint32 *) upload.indexData;
+                for (int i = 0; i < indexCount; ++i)
+                    dst[i] = src[i];
+            } else {
+                Q_ASSERT_X(false, "uploadElement (unmerged)", "uint index with ushort effective index - cannot happen");
+            }
+        }
+    }
+}
+
+void Renderer::finishBatchUpload(Batch *b)
+{
 #ifndef QT_NO_DEBUG_OUTPUT
     if (Q_UNLIKELY(debug_upload())) {
+        const QSGGeometry *g = b->first->node->geometry();
         const char *vd = b->vbo.data;
         qDebug() << "  -- Vertex Data, count:" << b->vertexCount << " - " << g->sizeOfVertex() << "bytes/vertex";
         for (int i=0; i<b->vertexCount; ++i) {
@@ -3562,8 +3930,7 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     ctx->timePrepareOpaque = 0;
     ctx->timePrepareAlpha = 0;
     ctx->timeSorting = 0;
-    ctx->timeUploadOpaque = 0;
-    ctx->timeUploadAlpha = 0;
+    ctx->timeUpload = 0;
 
     if (Q_UNLIKELY(debug_render() || debug_build())) {
         QByteArray type("rebuild:");
@@ -3607,6 +3974,11 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
             }
         }
     }
+    if (m_occlusionCulling && (m_occlusionDirty || (m_rebuild & (BuildRenderLists | BuildRenderListsForTaggedRoots)))) {
+        updateOcclusion();
+        m_occlusionDirty = false;
+    }
+
     if (Q_UNLIKELY(debug_render())) ctx->timeRenderLists = ctx->timer.restart();
 
     for (int i=0; i<m_opaqueBatches.size(); ++i)
@@ -3666,24 +4038,48 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
 
     if (Q_UNLIKELY(debug_render())) ctx->timeSorting = ctx->timer.restart();
 
-    // Set size to 0, nothing is deallocated, they will "grow" again
-    // as part of uploadBatch.
-    m_vertexUploadPool.reset();
-    m_indexUploadPool.reset();
-
+    // Figure out which batches need to be uploaded and how much memory they need.
+    m_batchUploads.reset();
+    BatchUpload upload;
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
     for (int i=0; i<m_opaqueBatches.size(); ++i) {
-        Batch *b = m_opaqueBatches.at(i);
-        uploadBatch(b);
+        if (prepareBatchUpload(m_opaqueBatches.at(i), &upload))
+            m_batchUploads.add(upload);
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
-
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
     for (int i=0; i<m_alphaBatches.size(); ++i) {
-        Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
+        if (prepareBatchUpload(m_alphaBatches.at(i), &upload))
+            m_batchUploads.add(upload);
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
+
+    // Set size to 0, nothing is deallocated, they will "grow" again
+    // to hold the data of all batches uploaded in this frame.
+    m_vertexUploadPool.reset();
+    m_indexUploadPool.reset();
+    if (m_visualizer->mode() == Visualizer::VisualizeNothing) {
+        quint32 vertexBytes = 0;
+        quint32 indexBytes = 0;
+        for (int i = 0; i < m_batchUploads.size(); ++i) {
+            vertexBytes += qsg_alignUploadSize(m_batchUploads.at(i).vertexBytes);
+            indexBytes += qsg_alignUploadSize(m_batchUploads.at(i).indexBytes);
+        }
+        m_vertexUploadPool.resize(vertexBytes);
+        m_indexUploadPool.resize(indexBytes);
+    }
+    m_vertexUploadOffset = 0;
+    m_indexUploadOffset = 0;
+
+    m_elementUploads.reset();
+    m_elementUploadChunks.reset();
+    for (int i = 0; i < m_batchUploads.size(); ++i)
+        layoutBatchUpload(m_batchUploads.at(i));
+
+    uploadElements();
+
+    // Hand the data to the rhi in the order of the batches.
+    for (int i = 0; i < m_batchUploads.size(); ++i)
+        finishBatchUpload(m_batchUploads.at(i).batch);
+    if (Q_UNLIKELY(debug_render())) ctx->timeUpload = ctx->timer.restart();
 
     if (Q_UNLIKELY(debug_render())) {
         qDebug().nospace() << "Rendering:" << Qt::endl
@@ -3856,12 +4252,13 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
     cb->debugMarkEnd();
 
     if (Q_UNLIKELY(debug_render())) {
-        qDebug(" -> times: build: %d, prepare(opaque/alpha): %d/%d, sorting: %d, upload(opaque/alpha): %d/%d, record rendering: %d",
+        qDebug(" -> times: build: %d, prepare(opaque/alpha): %d/%d, sorting: %d, upload: %d, record rendering: %d, occluded elements: %d",
                (int) ctx->timeRenderLists,
                (int) ctx->timePrepareOpaque, (int) ctx->timePrepareAlpha,
                (int) ctx->timeSorting,
-               (int) ctx->timeUploadOpaque, (int) ctx->timeUploadAlpha,
-               (int) ctx->timer.elapsed());
+               (int) ctx->timeUpload,
+               (int) ctx->timer.elapsed(),
+               m_occludedElementCount);
     }
 }
 
@@ -4014,6 +4411,8 @@ void Renderer::setVisualizationMode(const QByteArray &mode)
         m_visualizer->setMode(Visualizer::VisualizeBatches);
     else if (mode == "changes")
         m_visualizer->setMode(Visualizer::VisualizeChanges);
+    else if (mode == "occlusion")
+        m_visualizer->setMode(Visualizer::VisualizeOcclusion);
 }
 
 bool Renderer::hasVisualizationModeWithContinuousUpdate() const
@@ -267,6 +267,24 @@ struct Buffer {
     uint nonDynamicChangeCount;
 };
 
+// Where the data of one element goes when uploading its batch. The elements of all batches
+// uploaded in a frame are laid out first, then their data is filled in, possibly in parallel.
+struct ElementUpload {
+    Batch *batch;
+    Element *element;
+    char *vertexData;
+    char *zData;
+    char *indexData;
+    quint32 indexBase;
+};
+
+// The size of the vertex and index data of a batch that needs to be uploaded.
+struct BatchUpload {
+    Batch *batch;
+    quint32 vertexBytes;
+    quint32 indexBytes;
+};
+
 struct Element {
     Element()
         : boundsComputed(false)
@@ -276,6 +294,7 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , occluded(false)
     {
     }
 
@@ -309,6 +328,7 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint occluded : 1; // hidden behind an opaque rectangle, not in any batch
 };
 
 struct RenderNodeElement : public Element {
@@ -702,7 +722,8 @@ public:
         VisualizeBatches,
         VisualizeClipping,
         VisualizeChanges,
-        VisualizeOverdraw
+        VisualizeOverdraw,
+        VisualizeOcclusion
     };
 
     Visualizer(Renderer *renderer);
@@ -750,8 +771,7 @@ protected:
         quint64 timePrepareOpaque;
         quint64 timePrepareAlpha;
         quint64 timeSorting;
-        quint64 timeUploadOpaque;
-        quint64 timeUploadAlpha;
+        quint64 timeUpload;
     };
 
     // update batches and queue and commit rhi resource updates
@@ -787,12 +807,18 @@ private:
 
     void deleteRemovedElements();
     void cleanupBatches(QDataBuffer<Batch *> *batches);
+    void updateOcclusion();
     void prepareOpaqueBatches();
     bool checkOverlap(int first, int last, const Rect &bounds);
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
-    void uploadBatch(Batch *b);
+    bool prepareBatchUpload(Batch *b, BatchUpload *upload);
+    void layoutBatchUpload(const BatchUpload &upload);
+    void addElementUpload(const ElementUpload &upload, int vertexCount);
+    void uploadElements();
+    void uploadElement(const ElementUpload &upload);
+    void finishBatchUpload(Batch *b);
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
@@ -879,6 +905,17 @@ private:
 
     QDataBuffer<char> m_vertexUploadPool;
     QDataBuffer<char> m_indexUploadPool;
+    quint32 m_vertexUploadOffset = 0;
+    quint32 m_indexUploadOffset = 0;
+
+    QDataBuffer<BatchUpload> m_batchUploads;
+    QDataBuffer<ElementUpload> m_elementUploads;
+    QDataBuffer<int> m_elementUploadChunks;
+    int m_verticesInUploadChunk = 0;
+    int m_uploadThreadCount;
+    bool m_occlusionCulling;
+    bool m_occlusionDirty = true;
+    int m_occludedElementCount = 0;
 
     Allocator<Node, 256> m_nodeAllocator;
     Allocator<Element, 64> m_elementAllocator;
@@ -222,13 +222,15 @@ void QSGRenderer::preprocess()
     QSGRootNode *root = rootNode();
     Q_ASSERT(root);
 
+    // Glyph caches may hand out glyphs that were rendered in the background here, which
+    // marks the nodes using them for preprocessing, so this comes first.
+    m_context->preprocess();
+
     // We need to take a copy here, in case any of the preprocess calls deletes a node that
     // is in the preprocess list and thus, changes the m_nodes_to_preprocess behind our backs
     // For the default case, when this does not happen, the cost is negligible.
     QSet<QSGNode *> items = m_nodes_to_preprocess;
 
-    m_context->preprocess();
-
     for (QSet<QSGNode *>::const_iterator it = items.constBegin();
          it != items.constEnd(); ++it) {
         QSGNode *n = *it;
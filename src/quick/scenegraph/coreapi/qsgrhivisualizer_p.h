@@ -185,6 +185,24 @@ private:
         } box;
     } m_overdrawVis;
 
+    class OcclusionVis {
+    public:
+        void prepare(const QDataBuffer<Element *> &opaqueRenderList,
+                     const QDataBuffer<Element *> &alphaRenderList,
+                     RhiVisualizer *visualizer,
+                     QRhi *rhi, QRhiResourceUpdateBatch *u);
+        void releaseResources();
+        void render(QRhiCommandBuffer *cb);
+    private:
+        void gather(Element *e);
+        RhiVisualizer *visualizer;
+        QVector<DrawCall> drawCalls;
+        QRhiBuffer *vbuf = nullptr;
+        QRhiBuffer *ibuf = nullptr;
+        QRhiBuffer *ubuf = nullptr;
+        QRhiShaderResourceBindings *srb = nullptr;
+    } m_occlusionVis;
+
     QRandomGenerator m_randomGenerator;
 
     friend class Fade;
@@ -192,6 +210,7 @@ private:
     friend class ChangeVis;
     friend class ClipVis;
     friend class OverdrawVis;
+    friend class OcclusionVis;
 };
 
 } // namespace QSGBatchRenderer
@@ -13,6 +13,9 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
 
 #include <qtquick_tracepoints_p.h>
 
@@ -27,6 +30,35 @@ Q_TRACE_POINT(qtquick, QSGDistanceFieldGlyphCache_glyphStore_exit)
 
 static QElapsedTimer qsg_render_timer;
 
+// With QSG_DISTANCEFIELD_GLYPH_THREADS set, up to this many new glyphs are
+// rendered while preparing the frame that needs them. The rest are rendered on
+// worker threads and show up in a later frame.
+#if !defined(QSG_DISTANCEFIELD_SYNCHRONOUS_GLYPH_COUNT)
+#  define QSG_DISTANCEFIELD_SYNCHRONOUS_GLYPH_COUNT 64
+#endif
+
+// Number of glyphs rendered by a single task on a worker thread
+#if !defined(QSG_DISTANCEFIELD_GLYPHS_PER_TASK)
+#  define QSG_DISTANCEFIELD_GLYPHS_PER_TASK 16
+#endif
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_glyphThreadPool)
+
+// Off by default, as text then takes more than one frame to show completely,
+// which affects grabWindow() and QQuickRenderControl users.
+static int qsg_glyphThreadCount()
+{
+    return qMax(0, qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_GLYPH_THREADS"));
+}
+
+// Shared between a glyph cache and the tasks rendering its glyphs, which may
+// outlive the cache.
+struct QSGDistanceFieldGlyphCache::GeneratedGlyphs
+{
+    QMutex mutex;
+    QList<QDistanceField> glyphs;
+};
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality)
@@ -150,7 +182,8 @@ void QSGDistanceFieldGlyphCache::update()
 {
     m_populatingGlyphs.clear();
 
-    if (m_pendingGlyphs.isEmpty())
+    QList<QDistanceField> distanceFields = takeGeneratedGlyphs();
+    if (m_pendingGlyphs.isEmpty() && distanceFields.isEmpty())
         return;
 
     Q_TRACE_SCOPE(QSGDistanceFieldGlyphCache_update, m_pendingGlyphs.size());
@@ -161,19 +194,38 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
+    // Only hand glyphs to worker threads when there is someone to tell once
+    // they are done, otherwise they would not show until something else
+    // triggers a new frame.
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    int synchronousCount = pendingGlyphsSize;
+    if (pendingGlyphsSize > QSG_DISTANCEFIELD_SYNCHRONOUS_GLYPH_COUNT
+            && !m_ownerElements.isEmpty() && qsg_glyphThreadCount() > 0) {
+        synchronousCount = QSG_DISTANCEFIELD_SYNCHRONOUS_GLYPH_COUNT;
+    }
+
+    QList<QPair<glyph_t, QPainterPath>> asynchronousGlyphs;
+    asynchronousGlyphs.reserve(pendingGlyphsSize - synchronousCount);
+    distanceFields.reserve(distanceFields.size() + synchronousCount);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
-        GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        const glyph_t glyphIndex = m_pendingGlyphs.at(i);
+        GlyphData &gd = glyphData(glyphIndex);
+        if (i < synchronousCount) {
+            distanceFields.append(QDistanceField(gd.path,
+                                                 glyphIndex,
+                                                 m_doubleGlyphResolution));
+        } else {
+            asynchronousGlyphs.append(qMakePair(glyphIndex, gd.path));
+            m_generatingGlyphs.insert(glyphIndex);
+        }
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
+    if (!asynchronousGlyphs.isEmpty())
+        generateGlyphs(std::move(asynchronousGlyphs));
+
     qint64 renderTime = 0;
-    int count = m_pendingGlyphs.size();
+    int count = distanceFields.size();
     if (profileFrames)
         renderTime = qsg_render_timer.nsecsElapsed();
 
@@ -184,7 +236,8 @@ void QSGDistanceFieldGlyphCache::update()
 
     m_pendingGlyphs.reset();
 
-    storeGlyphs(distanceFields);
+    if (!distanceFields.isEmpty())
+        storeGlyphs(distanceFields);
 
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     for (Texture texture : std::as_const(m_textures))
@@ -194,11 +247,12 @@ void QSGDistanceFieldGlyphCache::update()
     if (QSG_LOG_TIME_GLYPH().isDebugEnabled()) {
         quint64 now = qsg_render_timer.elapsed();
         qCDebug(QSG_LOG_TIME_GLYPH,
-                "distancefield: %d glyphs prepared in %dms, rendering=%d, upload=%d",
+                "distancefield: %d glyphs prepared in %dms, rendering=%d, upload=%d, in background=%d",
                 count,
                 (int) now,
                 int(renderTime / 1000000),
-                int((now - (renderTime / 1000000))));
+                int((now - (renderTime / 1000000))),
+                int(m_generatingGlyphs.size()));
     }
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphStore_exit);
     Q_QUICK_SG_PROFILE_END_WITH_PAYLOAD(QQuickProfiler::SceneGraphAdaptationLayerFrame,
@@ -206,6 +260,86 @@ void QSGDistanceFieldGlyphCache::update()
                                         (qint64)count);
 }
 
+QList<QDistanceField> QSGDistanceFieldGlyphCache::takeGeneratedGlyphs()
+{
+    QList<QDistanceField> distanceFields;
+    if (m_generatingGlyphs.isEmpty())
+        return distanceFields;
+
+    QList<QDistanceField> generated;
+    {
+        QMutexLocker locker(&m_generatedGlyphs->mutex);
+        generated.swap(m_generatedGlyphs->glyphs);
+    }
+
+    // Glyphs that were evicted from the cache while being rendered no longer
+    // have a place in the texture.
+    QVector<quint32> arrivedGlyphs;
+    distanceFields.reserve(generated.size());
+    arrivedGlyphs.reserve(generated.size());
+    for (const QDistanceField &glyph : std::as_const(generated)) {
+        if (m_generatingGlyphs.remove(glyph.glyph())) {
+            distanceFields.append(glyph);
+            arrivedGlyphs.append(glyph.glyph());
+        }
+    }
+
+    // The nodes have been showing these glyphs as blank so far
+    if (!arrivedGlyphs.isEmpty()) {
+        for (QSGDistanceFieldGlyphConsumerList::iterator iter = m_registeredNodes.begin(); iter != m_registeredNodes.end(); ++iter)
+            iter->invalidateGlyphs(arrivedGlyphs);
+    }
+    return distanceFields;
+}
+
+void QSGDistanceFieldGlyphCache::generateGlyphs(QList<QPair<glyph_t, QPainterPath>> glyphs)
+{
+    if (!m_generatedGlyphs)
+        m_generatedGlyphs = std::make_shared<GeneratedGlyphs>();
+
+    // The items are only ever looked at on the gui thread, where they are
+    // also deleted.
+    QList<QPointer<QQuickItem>> owners;
+    owners.reserve(m_ownerElements.size());
+    for (const OwnerElement &owner : std::as_const(m_ownerElements))
+        owners.append(owner.item);
+
+    QThreadPool *pool = qsg_glyphThreadPool();
+    pool->setMaxThreadCount(qsg_glyphThreadCount());
+
+    const auto state = m_generatedGlyphs;
+    const bool doubleGlyphResolution = m_doubleGlyphResolution;
+    for (qsizetype i = 0; i < glyphs.size(); i += QSG_DISTANCEFIELD_GLYPHS_PER_TASK) {
+        QList<QPair<glyph_t, QPainterPath>> task = glyphs.mid(i, QSG_DISTANCEFIELD_GLYPHS_PER_TASK);
+        pool->start([state, owners, doubleGlyphResolution, task = std::move(task)]() {
+            QList<QDistanceField> distanceFields;
+            distanceFields.reserve(task.size());
+            for (const auto &glyph : task)
+                distanceFields.append(QDistanceField(glyph.second, glyph.first, doubleGlyphResolution));
+
+            {
+                QMutexLocker locker(&state->mutex);
+                state->glyphs.append(distanceFields);
+            }
+
+            // Ask for a new frame, which picks up the glyphs in update()
+            QCoreApplication *app = QCoreApplication::instance();
+            if (!app)
+                return;
+            QMetaObject::invokeMethod(app, [owners]() {
+                for (const QPointer<QQuickItem> &owner : owners) {
+                    if (!owner)
+                        continue;
+                    if (owner->metaObject()->indexOfSlot("triggerPreprocess()") >= 0)
+                        QMetaObject::invokeMethod(owner, "triggerPreprocess");
+                    else
+                        owner->update();
+                }
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
 void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &glyphs)
 {
     QVector<quint32> invalidatedGlyphs;
@@ -235,12 +369,16 @@ void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &g
 
 void QSGDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    OwnerElement &owner = m_ownerElements[ownerElement];
+    if (owner.ref++ == 0)
+        owner.item = ownerElement;
 }
 
 void QSGDistanceFieldGlyphCache::unregisterOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    auto it = m_ownerElements.find(ownerElement);
+    if (it != m_ownerElements.end() && --it->ref == 0)
+        m_ownerElements.erase(it);
 }
 
 void QSGDistanceFieldGlyphCache::processPendingGlyphs()
@@ -24,6 +24,7 @@
 #include <QtGui/qcolor.h>
 #include <QtGui/qpainterpath.h>
 #include <QtCore/qsharedpointer.h>
+#include <QtCore/qpointer.h>
 #include <QtGui/qglyphrun.h>
 #include <QtGui/qpainterpath.h>
 #include <QtCore/qurl.h>
@@ -33,6 +34,8 @@
 #include <private/qintrusivelist_p.h>
 #include <QtGui/private/qshader_p.h>
 
+#include <memory>
+
 // ### remove
 #include <QtQuick/private/qquicktext_p.h>
 
@@ -522,12 +525,25 @@ protected:
     QRawFont m_referenceFont;
 
 private:
+    struct GeneratedGlyphs;
+    struct OwnerElement {
+        QPointer<QQuickItem> item;
+        int ref = 0;
+    };
+
+    QList<QDistanceField> takeGeneratedGlyphs();
+    void generateGlyphs(QList<QPair<glyph_t, QPainterPath>> glyphs);
+
     int m_glyphCount;
     QList<Texture> m_textures;
     QHash<glyph_t, GlyphData> m_glyphsData;
     QDataBuffer<glyph_t> m_pendingGlyphs;
     QSet<glyph_t> m_populatingGlyphs;
     QSGDistanceFieldGlyphConsumerList m_registeredNodes;
+    QHash<QQuickItem *, OwnerElement> m_ownerElements;
+    // Glyphs being rendered on worker threads and where they deliver them
+    QSet<glyph_t> m_generatingGlyphs;
+    std::shared_ptr<GeneratedGlyphs> m_generatedGlyphs;
 
     static Texture s_emptyTexture;
 };
@@ -547,6 +563,7 @@ inline void QSGDistanceFieldGlyphCache::removeGlyph(glyph_t glyph)
     GlyphData &gd = glyphData(glyph);
     gd.texCoord = TexCoord();
     gd.texture = &s_emptyTexture;
+    m_generatingGlyphs.remove(glyph);
 }
 
 inline bool QSGDistanceFieldGlyphCache::containsGlyph(glyph_t glyph)
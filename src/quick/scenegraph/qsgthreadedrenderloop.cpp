@@ -101,6 +101,17 @@ extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_
 // RL: Render Loop
 // RT: Render Thread
 
+// Timestamps comparable between the gui and render threads, used for the
+// pipeline overlap statistics with QSG_LOG_TIME_RENDERLOOP.
+static qint64 qsg_frameTimestamp()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return clock.nsecsElapsed();
+}
 
 QSGThreadedRenderLoop::Window *QSGThreadedRenderLoop::windowFor(QQuickWindow *window)
 {
@@ -300,6 +311,10 @@ public:
     QWaitCondition waitCondition;
 
     QElapsedTimer m_threadTimeBetweenRenders;
+    // Written by the render thread, read by the gui thread while it holds
+    // the mutex after a sync. Only maintained with QSG_LOG_TIME_RENDERLOOP.
+    qint64 frameEndTimestamp = 0;
+    qint64 syncedFrameEndTimestamp = 0;
 
     QQuickWindow *window; // Will be 0 when window is not exposed
     QSize windowSize;
@@ -568,6 +583,10 @@ void QSGRenderThread::sync(bool inExpose)
     // the frame is rendered (submitted), so in that case waking happens later
     // in syncAndRender(). Otherwise, wake now and let the main thread go on
     // while we render.
+    // Hand the end of the previous frame to the gui thread for the overlap
+    // statistics printed in polishAndSync().
+    syncedFrameEndTimestamp = frameEndTimestamp;
+
     if (!inExpose) {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- sync complete, waking Gui");
         waitCondition.wakeOne();
@@ -625,6 +644,19 @@ void QSGRenderThread::syncAndRender()
     // Also relevant for applications that connect to the before/afterSynchronizing
     // signals and want to do graphics stuff already there.
     const bool hasValidSwapChain = (cd->swapchain && windowSize.width() > 0 && windowSize.height() > 0);
+
+    // With QSG_PIPELINED_SYNC the non-expose sync happens before beginFrame().
+    // beginFrame() may block for a long time waiting for a swapchain image
+    // or for the frame slot of an earlier frame to become available, and
+    // the gui thread would otherwise be waiting for all of that too. The
+    // price is that there is no active frame and command buffer while
+    // updatePaintNode() and beforeSynchronizing() run.
+    const bool syncBeforeBeginFrame = syncRequested && !exposeRequested && wm->m_syncBeforeBeginFrame;
+    if (syncBeforeBeginFrame) {
+        qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- updatePending, doing sync before beginFrame");
+        sync(false);
+    }
+
     if (hasValidSwapChain) {
         cd->swapchain->setProxyData(scProxyData);
         // always prefer what the surface tells us, not the QWindow
@@ -670,7 +702,7 @@ void QSGRenderThread::syncAndRender()
                 QCoreApplication::postEvent(window, new QEvent(QEvent::Type(QQuickWindowPrivate::FullUpdateRequest)));
             // Before returning we need to ensure the same wake up logic that
             // would have happened if beginFrame() had suceeded.
-            if (syncRequested) {
+            if (syncRequested && !syncBeforeBeginFrame) {
                 // Lock like sync() would do. Note that exposeRequested always includes syncRequested.
                 qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- bailing out due to failed beginFrame, wake Gui");
                 mutex.lock();
@@ -683,7 +715,7 @@ void QSGRenderThread::syncAndRender()
         }
     }
 
-    if (syncRequested) {
+    if (syncRequested && !syncBeforeBeginFrame) {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- updatePending, doing sync");
         sync(exposeRequested);
     }
@@ -783,6 +815,7 @@ void QSGRenderThread::syncAndRender()
     }
 
     if (profileFrames) {
+        frameEndTimestamp = qsg_frameTimestamp();
         // Beware that there is no guarantee the graphics stack always
         // blocks for a full vsync in beginFrame() or endFrame(). (because
         // e.g. there is no guarantee that OpenGL blocks in swapBuffers(),
@@ -971,6 +1004,7 @@ void QSGRenderThread::run()
 QSGThreadedRenderLoop::QSGThreadedRenderLoop()
     : sg(QSGContext::createDefaultContext())
     , m_animation_timer(0)
+    , m_syncBeforeBeginFrame(qEnvironmentVariableIntValue("QSG_PIPELINED_SYNC"))
 {
     m_animation_driver = sg->createAnimationDriver(this);
 
@@ -1240,6 +1274,7 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         win.timeBetweenPolishAndSyncs.start();
         win.psTimeAccumulator = 0.0f;
         win.psTimeSampleCount = 0;
+        win.syncEndTimestamp = 0;
         m_windows << win;
         w = &m_windows.last();
     } else {
@@ -1605,13 +1640,34 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
                               QQuickProfiler::SceneGraphPolishAndSyncWait);
     Q_TRACE(QSG_sync_entry);
 
+    const qint64 lockTimestamp = profileFrames ? qsg_frameTimestamp() : 0;
     w->thread->waitCondition.wait(&w->thread->mutex);
     m_lockedForSync = false;
+    const qint64 renderEndTimestamp = w->thread->syncedFrameEndTimestamp;
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP, "- unlock after sync");
 
-    if (profileFrames)
+    if (profileFrames) {
         syncTime = timer.nsecsElapsed();
+
+        // The render thread renders the previous frame while the gui thread
+        // goes on after the previous sync. Report how long it kept going,
+        // how much of that ran in parallel with the gui thread, and how long
+        // the gui thread had to wait for it before this sync could start.
+        const qint64 syncEndTimestamp = qsg_frameTimestamp();
+        if (w->syncEndTimestamp > 0 && renderEndTimestamp > w->syncEndTimestamp) {
+            const qint64 renderBusy = renderEndTimestamp - w->syncEndTimestamp;
+            const qint64 overlap = qMin(renderEndTimestamp, lockTimestamp) - w->syncEndTimestamp;
+            const qint64 stall = qMax(renderEndTimestamp - lockTimestamp, qint64(0));
+            qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] previous frame: gui=%d ms, render=%d ms, overlap=%d ms, stall=%d ms",
+                    window,
+                    int((lockTimestamp - w->syncEndTimestamp) / 1000000),
+                    int(renderBusy / 1000000),
+                    int(overlap / 1000000),
+                    int(stall / 1000000));
+        }
+        w->syncEndTimestamp = syncEndTimestamp;
+    }
     Q_TRACE(QSG_sync_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncSync);
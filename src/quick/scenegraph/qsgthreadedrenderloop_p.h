@@ -72,6 +72,7 @@ private:
         uint updateDuringSync : 1;
         uint forceRenderPass : 1;
         uint badVSync : 1;
+        qint64 syncEndTimestamp;
     };
 
     friend class QSGRenderThread;
@@ -107,6 +108,7 @@ private:
 
     bool m_lockedForSync;
     bool m_inPolish = false;
+    bool m_syncBeforeBeginFrame;
 };
 
 QT_END_NAMESPACE
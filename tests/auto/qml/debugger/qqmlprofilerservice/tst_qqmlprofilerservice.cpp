@@ -219,6 +219,10 @@ private:
     // Don't use ({...}) here as MSVC will interpret that as the "QVector(int size)" ctor.
     const QVector<qint64> m_rangeStart = (QVector<qint64>() << RangeStart);
     const QVector<qint64> m_rangeEnd = (QVector<qint64>() << RangeEnd);
+
+    // Functions called only a few times are not JIT-compiled, yet.
+    const QVector<qint64> m_interpretedRangeStart
+            = (QVector<qint64>() << RangeStart << JavaScriptInterpreted);
 };
 
 #define VERIFY(type, position, expected, checks, numbers) \
@@ -654,22 +658,43 @@ void tst_QQmlProfilerService::javascript()
     checkTraceReceived();
     checkJsHeap();
 
+    // The first call of something() also carries its execution counts. They are checked below.
     VERIFY(MessageListJavaScript, 2, QQmlProfilerEventType(MaximumMessage, Javascript),
-           CheckMessageType | CheckDetailType | CheckNumbers, m_rangeStart);
+           CheckMessageType | CheckDetailType, m_interpretedRangeStart);
 
     VERIFY(MessageListJavaScript, 3,
            QQmlProfilerEventType(
                MaximumMessage, Javascript, -1,
                QQmlProfilerEventLocation(QLatin1String("javascript.qml"), 4, 5)),
-           CheckType | CheckNumbers, m_rangeStart);
+           CheckType | CheckNumbers, m_interpretedRangeStart);
 
     VERIFY(MessageListJavaScript, 4, QQmlProfilerEventType(
                MaximumMessage, Javascript, -1,
                QQmlProfilerEventLocation(), QLatin1String("something")),
-           CheckMessageType | CheckDetailType | CheckDataEndsWith | CheckNumbers, m_rangeStart);
+           CheckMessageType | CheckDetailType | CheckDataEndsWith | CheckNumbers,
+           m_interpretedRangeStart);
 
     VERIFY(MessageListJavaScript, 10, QQmlProfilerEventType(MaximumMessage, Javascript),
            CheckMessageType | CheckDetailType | CheckNumbers, m_rangeEnd);
+
+    // Everything was reported at once. So the counts are sent with the first call of each
+    // function. something() was called four times, none of them AOT-compiled.
+    int countedRanges = 0;
+    for (const QQmlProfilerEvent &event : std::as_const(m_client->javascriptMessages)) {
+        const QQmlProfilerEventType &type = m_client->types.at(event.typeIndex());
+        if (!type.data().endsWith(QLatin1String("something")))
+            continue;
+        const QVector<qint64> numbers = event.numbers<QVector<qint64>>();
+        if (numbers.size() <= m_interpretedRangeStart.size())
+            continue;
+        ++countedRanges;
+        QCOMPARE(numbers.size(), 5);
+        QCOMPARE(numbers.mid(0, 2), m_interpretedRangeStart);
+        QCOMPARE(numbers[2] + numbers[3], qint64(4));
+        QVERIFY(numbers[2] > 0);
+        QCOMPARE(numbers[4], qint64(0));
+    }
+    QCOMPARE(countedRanges, 1);
 }
 
 void tst_QQmlProfilerService::flushInterval()
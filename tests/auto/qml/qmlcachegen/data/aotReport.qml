@@ -0,0 +1,8 @@
+import QtQml
+
+QtObject {
+    property int a: 1
+    property int b: a + 1
+
+    function untyped(x) { return x }
+}
@@ -10,6 +10,9 @@
 #include <QStandardPaths>
 #include <QSysInfo>
 #include <QLoggingCategory>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qv4compileddata_p.h>
@@ -58,6 +61,9 @@ private slots:
 
     void reproducibleCache_data();
     void reproducibleCache();
+    void batchCompilation();
+    void batchCompilationToCpp();
+    void aotReport();
 
     void parameterAdjustment();
     void inlineComponent();
@@ -89,7 +95,7 @@ public:
     }
 };
 
-static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+static bool runQmlCacheGen(const QStringList &arguments, QByteArray *capturedStderr = nullptr)
 {
 #if defined(QTEST_CROSS_COMPILED)
     QTest::qFail("You cannot call qmlcachegen on the target.", __FILE__, __LINE__);
@@ -100,7 +106,7 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
         proc.setProcessChannelMode(QProcess::ForwardedChannels);
     proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
                     + QLatin1String("/qmlcachegen"));
-    proc.setArguments(QStringList() << qmlFileName);
+    proc.setArguments(arguments);
     proc.start();
     if (!proc.waitForFinished())
         return false;
@@ -113,6 +119,11 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
     return proc.exitCode() == 0;
 }
 
+static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+{
+    return runQmlCacheGen(QStringList() << qmlFileName, capturedStderr);
+}
+
 tst_qmlcachegen::tst_qmlcachegen()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -739,6 +750,175 @@ void tst_qmlcachegen::reproducibleCache()
     QCOMPARE(contents1, contents2);
 }
 
+void tst_qmlcachegen::batchCompilation()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QStringList inputs = {
+        testFile("jsimport.qml"), testFile("library.js"), testFile("script.mjs"),
+        testFile("Enums.qml")
+    };
+
+    QByteArray batch;
+    QStringList outputs;
+    for (qsizetype i = 0; i < inputs.size(); ++i) {
+        outputs.append(tempDir.filePath(QString::number(i) + u".qmlc"_s));
+        batch += inputs[i].toUtf8() + '\t' + outputs[i].toUtf8() + '\n';
+    }
+
+    const QString batchFile = tempDir.filePath(u"batch.txt"_s);
+    {
+        QFile f(batchFile);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write(batch);
+    }
+
+    const QStringList arguments = { u"--batch-file"_s, batchFile, u"--jobs"_s, u"2"_s };
+    QVERIFY(runQmlCacheGen(arguments));
+
+    const QDateTime past(QDate(2020, 1, 1), QTime(12, 0));
+    for (qsizetype i = 0; i < inputs.size(); ++i) {
+        // The units match the ones generated for the files one by one.
+        QVERIFY(generateCache(inputs[i]));
+        QFile single(inputs[i] + u'c');
+        QVERIFY(single.open(QIODevice::ReadOnly));
+        const QByteArray expected = single.readAll();
+        single.remove();
+
+        QFile batched(outputs[i]);
+        QVERIFY(batched.open(QIODevice::ReadWrite));
+        QCOMPARE(batched.readAll(), expected);
+        QVERIFY(batched.setFileTime(past, QFileDevice::FileModificationTime));
+    }
+
+    // Unchanged outputs are not rewritten.
+    QVERIFY(runQmlCacheGen(arguments));
+    for (const QString &output : std::as_const(outputs))
+        QCOMPARE(QFileInfo(output).lastModified(), past);
+}
+
+void tst_qmlcachegen::batchCompilationToCpp()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QStringList inputs = {
+        testFile("aotReport.qml"), testFile("Enums.qml"), testFile("library.js"),
+        testFile("parameterAdjustment.qml")
+    };
+
+    const auto resourcePath = [](const QString &input) {
+        return u"/qt/qml/"_s + QFileInfo(input).fileName();
+    };
+
+    const auto writeBatch = [&](const QStringList &inputs, const QString &outputDir) {
+        QByteArray batch;
+        for (const QString &input : inputs) {
+            batch += input.toUtf8() + '\t'
+                    + QDir(outputDir).filePath(QFileInfo(input).fileName() + u".cpp"_s).toUtf8()
+                    + '\t' + resourcePath(input).toUtf8() + '\n';
+        }
+        const QString batchFile = QDir(outputDir).filePath(u"batch.txt"_s);
+        QFile f(batchFile);
+        if (!f.open(QIODevice::WriteOnly) || f.write(batch) != batch.size())
+            return QString();
+        return batchFile;
+    };
+
+    // With one job, a single importer is used for all files. With two, each worker keeps its
+    // own importer for the files it compiles.
+    for (const QString &jobs : { u"1"_s, u"2"_s }) {
+        const QString outputDir = tempDir.filePath(u"jobs"_s + jobs);
+        QVERIFY(QDir().mkpath(outputDir));
+        const QString batchFile = writeBatch(inputs, outputDir);
+        QVERIFY(!batchFile.isEmpty());
+        QVERIFY(runQmlCacheGen({ u"--batch-file"_s, batchFile, u"--jobs"_s, jobs }));
+
+        for (const QString &input : inputs) {
+            // The code matches the one generated for the files one by one.
+            const QString single = tempDir.filePath(u"single.cpp"_s);
+            QVERIFY(runQmlCacheGen({ u"--resource-path"_s, resourcePath(input),
+                                     u"-o"_s, single, input }));
+            QFile expected(single);
+            QVERIFY(expected.open(QIODevice::ReadOnly));
+            QFile batched(QDir(outputDir).filePath(QFileInfo(input).fileName() + u".cpp"_s));
+            QVERIFY(batched.open(QIODevice::ReadOnly));
+            QCOMPARE(batched.readAll(), expected.readAll());
+        }
+    }
+
+    // A "pragma Strict" violation fails its own file, but the others are still compiled.
+    const QString outputDir = tempDir.filePath(u"strict"_s);
+    QVERIFY(QDir().mkpath(outputDir));
+    const QString batchFile = writeBatch(QStringList { testFile("strictViolation.qml") } + inputs,
+                                         outputDir);
+    QVERIFY(!batchFile.isEmpty());
+    QByteArray errors;
+    QVERIFY(!runQmlCacheGen({ u"--batch-file"_s, batchFile, u"--jobs"_s, u"1"_s }, &errors));
+    QVERIFY2(errors.contains("Error compiling qml file: "), errors.constData());
+    QVERIFY2(errors.contains("strictViolation.qml"), errors.constData());
+    QVERIFY2(errors.contains("(strict mode)"), errors.constData());
+    QVERIFY(!QFile::exists(QDir(outputDir).filePath(u"strictViolation.qml.cpp"_s)));
+    for (const QString &input : inputs)
+        QVERIFY(QFile::exists(QDir(outputDir).filePath(QFileInfo(input).fileName() + u".cpp"_s)));
+}
+
+void tst_qmlcachegen::aotReport()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString reportFile = tempDir.filePath(u"report.json"_s);
+    QVERIFY(runQmlCacheGen({
+        u"--resource-path"_s, u"/qt/qml/aotReport.qml"_s,
+        u"--aot-report"_s, reportFile,
+        u"-o"_s, tempDir.filePath(u"aotReport.cpp"_s),
+        testFile("aotReport.qml")
+    }));
+
+    QFile f(reportFile);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    const QJsonObject report = QJsonDocument::fromJson(f.readAll()).object();
+    const QJsonArray files = report[u"files"].toArray();
+    QCOMPARE(files.size(), 1);
+
+    bool sawBinding = false;
+    bool sawFunction = false;
+    const QJsonArray entries = files[0].toObject()[u"entries"].toArray();
+    for (const QJsonValue &value : entries) {
+        const QJsonObject entry = value.toObject();
+        const QString name = entry[u"name"].toString();
+        if (name == u"b") {
+            QCOMPARE(entry[u"kind"].toString(), u"binding"_s);
+            QCOMPARE(entry[u"line"].toInt(), 5);
+            QVERIFY(entry[u"compiled"].toBool());
+            sawBinding = true;
+        } else if (name == u"untyped") {
+            QCOMPARE(entry[u"kind"].toString(), u"function"_s);
+            QVERIFY(!entry[u"compiled"].toBool());
+            QVERIFY(!entry[u"reason"].toString().isEmpty());
+            sawFunction = true;
+        }
+    }
+    QVERIFY(sawBinding);
+    QVERIFY(sawFunction);
+    QCOMPARE(report[u"rejected"].toInt(), files[0].toObject()[u"rejected"].toInt());
+    QVERIFY(report[u"rejected"].toInt() >= 1);
+}
+
 void tst_qmlcachegen::parameterAdjustment()
 {
     QQmlEngine engine;
@@ -0,0 +1,19 @@
+pragma Strict
+import QtQml
+
+QtObject {
+    property list<int> numbers: [4, 8, 15, 16, 23, 42]
+    property list<string> names: ["a", "b", "c", "b"]
+
+    property var map: ({ answer: 42, question: "unknown", flag: true })
+    property int answer: ({ answer: numbers[5], question: "unknown" }).answer
+    property var ordered: ({ zeta: 1, alpha: 2, mid: 3 })
+    property rect r: ({x: 1, y: 2})
+    property rect fullRect: ({ height: 4, width: 3, y: 2, x: 1 })
+
+    property int indexOfSixteen: numbers.indexOf(16)
+    property int indexOfMissing: numbers.indexOf(7)
+    property int lastIndexOfB: names.lastIndexOf("b")
+    property bool hasC: names.includes("c")
+    property bool hasD: names.includes("d")
+}
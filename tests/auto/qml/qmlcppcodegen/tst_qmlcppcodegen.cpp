@@ -176,6 +176,7 @@ private slots:
     void equalityTestsWithNullOrUndefined();
     void basicBlocksWithBackJump();
     void listOfInvisible();
+    void objectAndArrayLiterals();
 };
 
 void tst_QmlCppCodegen::initTestCase()
@@ -3442,6 +3443,36 @@ void tst_QmlCppCodegen::basicBlocksWithBackJump()
     QVERIFY(!expectingMessage);
 }
 
+void tst_QmlCppCodegen::objectAndArrayLiterals()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/objectAndArrayLiterals.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    const QVariantMap map = o->property("map").toMap();
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.value(u"answer"_s).toInt(), 42);
+    QCOMPARE(map.value(u"question"_s).toString(), u"unknown"_s);
+    QCOMPARE(map.value(u"flag"_s).toBool(), true);
+    QCOMPARE(o->property("answer").toInt(), 42);
+
+    // Object literals that escape to JavaScript keep their keys in definition order.
+    QQmlExpression keys(engine.contextForObject(o.data()), o.data(),
+                        u"Object.keys(ordered).join(',') + ';' + Object.keys(map).join(',')"_s);
+    QCOMPARE(keys.evaluate().toString(), u"zeta,alpha,mid;answer,question,flag"_s);
+
+    QCOMPARE(o->property("r").value<QRectF>(), QRectF(1, 2, 0, 0));
+    QCOMPARE(o->property("fullRect").value<QRectF>(), QRectF(1, 2, 3, 4));
+
+    QCOMPARE(o->property("indexOfSixteen").toInt(), 3);
+    QCOMPARE(o->property("indexOfMissing").toInt(), -1);
+    QCOMPARE(o->property("lastIndexOfB").toInt(), 3);
+    QCOMPARE(o->property("hasC").toBool(), true);
+    QCOMPARE(o->property("hasD").toBool(), false);
+}
+
 QTEST_MAIN(tst_QmlCppCodegen)
 
 #include "tst_qmlcppcodegen.moc"
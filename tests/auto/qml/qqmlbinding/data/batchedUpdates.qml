@@ -0,0 +1,11 @@
+import QtQml
+
+QtObject {
+    property int source: 1
+    property int left: source + 1
+    property int right: source * 2
+    property int sum: left + right + source
+
+    property int sumChanges: 0
+    onSumChanged: ++sumChanges
+}
@@ -5,6 +5,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtQml/private/qqmlbind_p.h>
 #include <QtQml/private/qqmlcomponentattached_p.h>
+#include <QtQml/private/qqmlengine_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include "WithBindableProperties.h"
@@ -40,6 +41,7 @@ private slots:
     void localSignalHandler();
     void whenEvaluatedEarlyEnough();
     void propertiesAttachedToBindingItself();
+    void batchedUpdates();
 
 private:
     QQmlEngine engine;
@@ -629,6 +631,28 @@ void tst_qqmlbinding::propertiesAttachedToBindingItself()
     QTRY_COMPARE(root->property("check").toInt(), 3);
 }
 
+void tst_qqmlbinding::batchedUpdates()
+{
+    QQmlEngine e;
+    QQmlEnginePrivate::get(&e)->batchBindingUpdates = true;
+    QQmlComponent c(&e, testFileUrl("batchedUpdates.qml"));
+    std::unique_ptr<QObject> root { c.create() };
+    QVERIFY2(root, qPrintable(c.errorString()));
+    QCOMPARE(root->property("sum").toInt(), 5);
+
+    // The first update finds out that "sum" depends on "left" and "right".
+    root->setProperty("source", 2);
+    QCOMPARE(root->property("sum").toInt(), 9);
+
+    // Afterwards "sum" is only evaluated once, with the updated values of both.
+    root->setProperty("sumChanges", 0);
+    root->setProperty("source", 3);
+    QCOMPARE(root->property("left").toInt(), 4);
+    QCOMPARE(root->property("right").toInt(), 6);
+    QCOMPARE(root->property("sum").toInt(), 13);
+    QCOMPARE(root->property("sumChanges").toInt(), 1);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
@@ -0,0 +1,22 @@
+import QtQuick
+
+Item {
+    id: root
+    property int base: 10
+
+    Item {
+        objectName: "untouched"
+        property int value
+        function twice(x) { return 2 * x }
+    }
+
+    Item {
+        id: used
+        property int value: 4
+        function add(x) { return value + x + root.base }
+        function *numbers() { yield value; yield root.base }
+    }
+
+    property int sum: used.add(1)
+    function collect() { return Array.from(used.numbers()) }
+}
@@ -421,6 +421,7 @@ private slots:
     void doNotCrashOnReadOnlyBindable();
 
     void resetGadet();
+    void lazyPropertyAndMethodStorage();
 
 private:
 //    static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -10478,6 +10479,35 @@ void tst_qqmlecmascript::resetGadet()
     QCOMPARE(resettableGadgetHolder->g().value(), 42);
 }
 
+void tst_qqmlecmascript::lazyPropertyAndMethodStorage()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("lazyPropertyAndMethodStorage.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(o);
+
+    // Functions are created on first use, in the scope of their object.
+    QCOMPARE(o->property("sum").toInt(), 15);
+    QVariant collected;
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "collect", Q_RETURN_ARG(QVariant, collected)));
+    QCOMPARE(collected.toList(), QVariantList({ 4, 10 }));
+
+    // An object whose properties and methods are never touched does not get a JS wrapper.
+    QObject *untouched = o->findChild<QObject *>("untouched");
+    QVERIFY(untouched);
+    QVERIFY(QQmlData::get(untouched)->jsWrapper.isNullOrUndefined());
+
+    QCOMPARE(untouched->property("value").toInt(), 0);
+    QVERIFY(untouched->setProperty("value", 7));
+    QCOMPARE(untouched->property("value").toInt(), 7);
+    QVariant twice;
+    QVERIFY(QMetaObject::invokeMethod(untouched, "twice", Q_RETURN_ARG(QVariant, twice),
+                                      Q_ARG(QVariant, 21)));
+    QCOMPARE(twice.toInt(), 42);
+    QVERIFY(!QQmlData::get(untouched)->jsWrapper.isNullOrUndefined());
+}
+
 QTEST_MAIN(tst_qqmlecmascript)
 
 #include "tst_qqmlecmascript.moc"
@@ -40,6 +40,7 @@ private slots:
     void implicitWithDependencies();
     void qualifiedScriptImport();
     void invalidImportUrl();
+    void importSnapshot();
 };
 
 void tst_QQmlImport::cleanup()
@@ -514,6 +515,66 @@ void tst_QQmlImport::importDependenciesPrecedence()
 }
 
 
+void tst_QQmlImport::importSnapshot()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(QDir(dir.path()).mkdir("Module"));
+
+    const QString qmldirPath = dir.filePath("Module/qmldir");
+    const QString qmldirUrl = QUrl::fromLocalFile(dir.filePath("Module/")).toString();
+    const QString content = QStringLiteral("module Module\nFoo 1.0 Foo.qml\n");
+    auto writeQmldir = [&](const QString &content) {
+        QFile file(qmldirPath);
+        return file.open(QIODevice::WriteOnly) && file.write(content.toUtf8()) > 0;
+    };
+    QVERIFY(writeQmldir(content));
+
+    const QStringList importPaths = { dir.path() };
+    const QStringList pluginPaths = { QStringLiteral(".") };
+    const QTypeRevision version = QTypeRevision::fromMajorVersion(1);
+    QList<QQmlImportSnapshot::QmldirLocation> locations;
+    QString snapshotContent;
+
+    QString snapshotPath;
+    {
+        auto snapshot = QQmlImportSnapshot::create(importPaths, pluginPaths);
+        snapshotPath = snapshot->filePath();
+        QVERIFY(!snapshot->qmldirLocations("Module", version, &locations));
+        snapshot->addQmldirLocations("Module", version, { { qmldirPath, qmldirUrl } });
+        snapshot->addQmldirContent(qmldirPath, content);
+    }
+    auto removeSnapshot = qScopeGuard([&]() { QFile::remove(snapshotPath); });
+    QVERIFY(QFile::exists(snapshotPath));
+
+    {
+        auto snapshot = QQmlImportSnapshot::create(importPaths, pluginPaths);
+        QVERIFY(snapshot->qmldirLocations("Module", version, &locations));
+        QCOMPARE(locations.size(), 1);
+        QCOMPARE(locations.first().filePath, qmldirPath);
+        QCOMPARE(locations.first().pathUrl, qmldirUrl);
+        QVERIFY(!snapshot->qmldirLocations("Module", QTypeRevision::fromMajorVersion(2),
+                                           &locations));
+        QVERIFY(snapshot->qmldirContent(qmldirPath, &snapshotContent));
+        QCOMPARE(snapshotContent, content);
+    }
+
+    {
+        // Other import paths may find other modules.
+        auto snapshot = QQmlImportSnapshot::create(importPaths + pluginPaths, pluginPaths);
+        QVERIFY(snapshot->filePath() != snapshotPath);
+        QVERIFY(!snapshot->qmldirLocations("Module", version, &locations));
+    }
+
+    // Entries are dropped once the files they depend on change.
+    QVERIFY(writeQmldir(content + QStringLiteral("Bar 1.0 Bar.qml\n")));
+    {
+        auto snapshot = QQmlImportSnapshot::create(importPaths, pluginPaths);
+        QVERIFY(!snapshot->qmldirLocations("Module", version, &locations));
+        QVERIFY(!snapshot->qmldirContent(qmldirPath, &snapshotContent));
+    }
+}
+
 QTEST_MAIN(tst_QQmlImport)
 
 #include "tst_qqmlimport.moc"
@@ -0,0 +1,22 @@
+import QtQml
+
+QtObject {
+    id: root
+    property int completed: 0
+    property int sum: first.value + second.value + third.value
+
+    property QtObject first: QtObject {
+        property int value: root.completed + 1
+        Component.onCompleted: ++root.completed
+    }
+    property QtObject second: QtObject {
+        property int value: root.completed + 2
+        Component.onCompleted: ++root.completed
+    }
+    property QtObject third: QtObject {
+        property int value: root.completed + 3
+        Component.onCompleted: ++root.completed
+    }
+
+    Component.onCompleted: ++root.completed
+}
@@ -13,6 +13,7 @@
 #include <QQmlProperty>
 #include <QQmlComponent>
 #include <QQmlIncubator>
+#include <QScopeGuard>
 #include <private/qjsvalue_p.h>
 #include <private/qqmlincubator_p.h>
 #include <private/qqmlobjectcreator_p.h>
@@ -47,6 +48,7 @@ private slots:
     void garbageCollection();
     void requiredProperties();
     void deleteInSetInitialState();
+    void interruptedCompletion();
 
 private:
     QQmlIncubationController controller;
@@ -1240,6 +1242,53 @@ void tst_qqmlincubator::deleteInSetInitialState()
     QCOMPARE(incubator.object(), nullptr); // object was deleted
 }
 
+static QList<QQmlIncubationPhase> incubationPhases;
+
+void tst_qqmlincubator::interruptedCompletion()
+{
+    QQmlComponent component(&engine, testFileUrl("interruptedCompletion.qml"));
+    QVERIFY(component.isReady());
+
+    struct MyIncubator : public QQmlIncubator
+    {
+        void setInitialState(QObject *o) override { object = o; }
+        QPointer<QObject> object;
+    };
+
+    incubationPhases.clear();
+    QQmlIncubatorPrivate::setPhaseHook([](QQmlIncubator *, QQmlIncubationPhase phase, qint64) {
+        incubationPhases.append(phase);
+    });
+    auto resetHook = qScopeGuard([]() { QQmlIncubatorPrivate::setPhaseHook(nullptr); });
+
+    MyIncubator incubator;
+    component.create(incubator);
+    QVERIFY(incubator.isLoading());
+
+    // Without any time left, each call does one step of the incubation only.
+    QList<int> completed;
+    for (int i = 0; i < 100 && incubator.isLoading(); ++i) {
+        controller.incubateFor(0);
+        if (incubator.object)
+            completed.append(incubator.object->property("completed").toInt());
+    }
+    QVERIFY(incubator.isReady());
+    QVERIFY(incubator.object);
+    QVERIFY(completed.contains(1));
+    QVERIFY(completed.contains(2));
+    QVERIFY(completed.contains(3));
+    QCOMPARE(completed.last(), 4);
+    QCOMPARE(incubator.object->property("sum").toInt(), 18);
+
+    QCOMPARE(incubationPhases.first(), QQmlIncubationPhase::CreatingObjects);
+    QVERIFY(incubationPhases.contains(QQmlIncubationPhase::EvaluatingBindings));
+    QVERIFY(incubationPhases.contains(QQmlIncubationPhase::CompletingComponents));
+    QVERIFY(incubationPhases.count(QQmlIncubationPhase::EmittingCompleted) >= 4);
+    QCOMPARE(incubationPhases.last(), QQmlIncubationPhase::EmittingCompleted);
+
+    delete incubator.object;
+}
+
 QTEST_MAIN(tst_qqmlincubator)
 
 #include "tst_qqmlincubator.moc"
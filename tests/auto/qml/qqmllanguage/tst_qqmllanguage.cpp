@@ -264,6 +264,7 @@ private slots:
     void lazyDeferredSubObject();
     void deferredProperties();
     void executeDeferredPropertiesOnce();
+    void deferredDataList();
     void deferredProperties_extra();
 
     void noChildEvents();
@@ -5250,6 +5251,63 @@ public:
     GroupType *getGroup() { return &m_group; }
 };
 
+void tst_qqmllanguage::deferredDataList()
+{
+    {
+        // Objects without deferred properties don't allocate a list.
+        QQmlComponent component(&engine);
+        component.setData("import QtQml\nQtObject { property int a: 5 }", QUrl());
+        VERIFY_ERRORS(0);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY(!object.isNull());
+
+        QQmlData *qmlData = QQmlData::get(object.data());
+        QVERIFY(qmlData);
+        QVERIFY(qmlData->deferredData.isEmpty());
+        QCOMPARE(qmlData->deferredData.size(), 0);
+        QVERIFY(qmlData->deferredData.begin() == qmlData->deferredData.end());
+        QVERIFY(qmlData->deferredData.rbegin() == qmlData->deferredData.rend());
+
+        qmlExecuteDeferred(object.data());
+        QVERIFY(qmlData->deferredData.isEmpty());
+    }
+
+    QQmlComponent component(&engine, testFileUrl("deferredProperties.qml"));
+    VERIFY_ERRORS(0);
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(!object.isNull());
+
+    QQmlData *qmlData = QQmlData::get(object.data());
+    QVERIFY(qmlData);
+    QQmlData::DeferredDataList &deferredData = qmlData->deferredData;
+    QVERIFY(!deferredData.isEmpty());
+    QCOMPARE(deferredData.size(), 2); // MyDeferredListProperty.qml + deferredListProperty.qml
+
+    const QList<QQmlData::DeferredData *> forward(deferredData.begin(), deferredData.end());
+    QList<QQmlData::DeferredData *> backward(deferredData.rbegin(), deferredData.rend());
+    std::reverse(backward.begin(), backward.end());
+    QCOMPARE(forward.size(), 2);
+    QCOMPARE(backward, forward);
+    QCOMPARE(deferredData.first(), forward.first());
+    QCOMPARE(deferredData.last(), forward.last());
+    QVERIFY(deferredData.first() != deferredData.last());
+
+    // Entries that still have deferred bindings are kept.
+    testExecuteDeferredOnce(QQmlProperty(object.data(), "groupProperty"));
+    QCOMPARE(deferredData.size(), 2);
+    QCOMPARE(deferredData.first(), forward.first());
+    QCOMPARE(deferredData.last(), forward.last());
+
+    // Once all of them have been executed, the list is released.
+    testExecuteDeferredOnce(QQmlProperty(object.data(), "listProperty"));
+    QVERIFY(deferredData.isEmpty());
+    QCOMPARE(deferredData.size(), 0);
+    QVERIFY(deferredData.begin() == deferredData.end());
+
+    qmlExecuteDeferred(object.data());
+    QVERIFY(deferredData.isEmpty());
+}
+
 void tst_qqmllanguage::deferredProperties_extra()
 {
     // Note: because ExtraDeferredProperties defers only a `group` property, the
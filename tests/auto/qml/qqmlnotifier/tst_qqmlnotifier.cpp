@@ -5,6 +5,8 @@
 #include <QQmlEngine>
 #include <QQmlComponent>
 #include <QQmlContext>
+#include <QQmlExpression>
+#include <QSignalSpy>
 #include <qqml.h>
 #include <QMetaMethod>
 #if QT_CONFIG(process)
@@ -133,6 +135,7 @@ private slots:
     void propertyChange();
     void disconnectOnDestroy();
     void lotsOfBindings();
+    void largeSignalOffsets();
 
     void deleteFromHandler();
 
@@ -314,6 +317,80 @@ void tst_qqmlnotifier::lotsOfBindings()
     delete e;
 }
 
+void tst_qqmlnotifier::largeSignalOffsets()
+{
+    // The notify list of an object only covers the signals from the lowest to the highest
+    // connected one. Connect to properties declared far behind the signals of the base type,
+    // in an order that makes the list grow at both ends, and past 64 signals so that several
+    // of them share a bit in the connection mask.
+    QByteArray source = "import QtQml\nQtObject {\n";
+    for (int i = 0; i < 200; ++i)
+        source += "    property int p" + QByteArray::number(i) + ": 0\n";
+    source += "}\n";
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(source, QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    std::unique_ptr<QObject> object(component.create());
+    QVERIFY(object);
+
+    const QList<int> connected = { 100, 150, 3, 199, 120, 0, 164 };
+    std::vector<std::unique_ptr<QQmlExpression>> expressions;
+    std::vector<std::unique_ptr<QSignalSpy>> spies;
+    int value = 0;
+
+    const auto verifyNotifications = [&]() {
+        for (int i = 0; i < 200; ++i) {
+            const int connectedIndex = connected.indexOf(i);
+            QVERIFY(object->setProperty(("p" + QByteArray::number(i)).constData(), ++value));
+            if (connectedIndex < 0 || connectedIndex >= int(expressions.size())) {
+                // Nothing is connected to it (yet).
+                for (const auto &spy : spies)
+                    QCOMPARE(spy->size(), 0);
+                continue;
+            }
+
+            for (int j = 0; j < int(spies.size()); ++j)
+                QCOMPARE(spies[j]->size(), j == connectedIndex ? 1 : 0);
+            spies[connectedIndex]->clear();
+
+            // Re-evaluate to stay subscribed.
+            bool isUndefined = true;
+            QCOMPARE(expressions[connectedIndex]->evaluate(&isUndefined).toInt(), value);
+            QVERIFY(!isUndefined);
+        }
+    };
+
+    for (int index : connected) {
+        auto expression = std::make_unique<QQmlExpression>(
+                engine.rootContext(), object.get(), QStringLiteral("p%1").arg(index));
+        expression->setNotifyOnValueChanged(true);
+        expression->evaluate();
+        QVERIFY(!expression->hasError());
+        spies.push_back(std::make_unique<QSignalSpy>(expression.get(),
+                                                     &QQmlExpression::valueChanged));
+        expressions.push_back(std::move(expression));
+
+        // Emitting lays out the notify list, so that the next connection has to extend it.
+        verifyNotifications();
+        if (QTest::currentTestFailed())
+            return;
+    }
+
+    // Disconnecting from the middle and the ends leaves the others working.
+    spies.clear();
+    expressions.erase(expressions.begin() + 3); // 199
+    expressions.erase(expressions.begin() + 2); // 3
+    for (const auto &expression : expressions)
+        spies.push_back(std::make_unique<QSignalSpy>(expression.get(),
+                                                     &QQmlExpression::valueChanged));
+    for (int i = 0; i < 200; ++i)
+        QVERIFY(object->setProperty(("p" + QByteArray::number(i)).constData(), ++value));
+    for (const auto &spy : spies)
+        QCOMPARE(spy->size(), 1);
+}
+
 void tst_qqmlnotifier::deleteFromHandler()
 {
 #ifdef Q_OS_ANDROID
@@ -10,11 +10,14 @@
 #if QT_CONFIG(process)
 #include <QtCore/qprocess.h>
 #endif
+#include <QtQml/private/qqmlcomponent_p.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmltypedata_p.h>
 #include <QtQml/private/qqmltypeloader_p.h>
 #include <QtQml/private/qqmlirbuilder_p.h>
 #include <QtQml/private/qqmlirloader_p.h>
+#include <QtQml/private/qqmlscriptdata_p.h>
+#include <QtQml/private/qv4executablecompilationunit_p.h>
 #include <QtQuickTestUtils/private/testhttpserver_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QQmlComponent>
@@ -47,6 +50,8 @@ private slots:
     void circularDependency();
     void declarativeCppAndQmlDir();
     void signalHandlersAreCompatible();
+    void parallelCompile();
+    void sharedCompilationUnits();
 
 private:
     void checkSingleton(const QString & dataDirectory);
@@ -724,6 +729,127 @@ void tst_QQMLTypeLoader::signalHandlersAreCompatible()
     QVERIFY(unitFromCachegen->url() != unitFromTypeCompiler->url());
 }
 
+static bool writeFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(content) == content.size();
+}
+
+void tst_QQMLTypeLoader::parallelCompile()
+{
+    // Many independent files, each with their own dependencies, so that the loader has
+    // something to spread over its worker threads. The result has to be the same as if
+    // they had been loaded one after another.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const int typeCount = 32;
+    QByteArray main = "import QtQml\nQtObject {\n    property list<QtObject> children: [\n";
+    for (int i = 0; i < typeCount; ++i) {
+        const QByteArray type = "Type" + QByteArray::number(i);
+        main += (i > 0 ? ",\n        " : "        ") + type + " {}";
+        QVERIFY(writeFile(dir.filePath(QString::fromLatin1(type + ".qml")),
+                          "import QtQml\nimport \"lib.js\" as Lib\nLeaf { value: Lib.times("
+                          + QByteArray::number(i) + ", 2) }\n"));
+    }
+    const QByteArray mainEnd = "\n    ]\n    property int sum: {\n        let sum = 0;\n"
+            "        for (const child of children)\n            sum += child.value;\n"
+            "        return sum;\n    }\n}\n";
+    QVERIFY(writeFile(dir.filePath("Main.qml"), main + mainEnd));
+    QVERIFY(writeFile(dir.filePath("Leaf.qml"), "import QtQml\nQtObject { property int value }\n"));
+    QVERIFY(writeFile(dir.filePath("lib.js"), ".pragma library\nfunction times(a, b) { return a * b; }\n"));
+
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, QUrl::fromLocalFile(dir.filePath("Main.qml")));
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY(root);
+        QCOMPARE(root->property("sum").toInt(), typeCount * (typeCount - 1));
+    }
+
+    // An error in one of the siblings is reported for the file it is in.
+    const QString brokenFile = dir.filePath("BrokenLeaf.qml");
+    QVERIFY(writeFile(brokenFile, "import QtQml\nLeaf { value: }\n"));
+    QVERIFY(writeFile(dir.filePath("Broken.qml"), main + ",\n        BrokenLeaf {}" + mainEnd));
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine, QUrl::fromLocalFile(dir.filePath("Broken.qml")));
+    QVERIFY(component.isError());
+    const QList<QQmlError> errors = component.errors();
+    QVERIFY(std::any_of(errors.begin(), errors.end(), [&](const QQmlError &error) {
+        return error.url() == QUrl::fromLocalFile(brokenFile);
+    }));
+}
+
+void tst_QQMLTypeLoader::sharedCompilationUnits()
+{
+#ifdef Q_OS_ANDROID
+    QSKIP("Android seems to have problems with QProcess");
+#endif
+
+#if QT_CONFIG(process)
+    // The disk cache is configured once per process. Run in a child process without it, so
+    // that nothing but the shared compilation units can avoid compiling the files again.
+    const char *childKey = "QT_TST_QQMLTYPELOADER_SHARED_UNITS";
+    if (!qEnvironmentVariableIsSet(childKey)) {
+        QProcess child;
+        child.setProgram(QCoreApplication::applicationFilePath());
+        child.setArguments(QStringList(QLatin1String("sharedCompilationUnits")));
+        child.setProcessChannelMode(QProcess::MergedChannels);
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert(QLatin1String(childKey), QLatin1String("1"));
+        env.insert(QLatin1String("QML_DISABLE_DISK_CACHE"), QLatin1String("1"));
+        child.setProcessEnvironment(env);
+        child.start();
+        QVERIFY(child.waitForFinished());
+        QVERIFY2(child.exitStatus() == QProcess::NormalExit && child.exitCode() == 0,
+                 child.readAll().constData());
+        return;
+    }
+#else
+    QSKIP("Needs a child process to disable the disk cache");
+#endif
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeFile(dir.filePath("Main.qml"),
+                      "import QtQml\nimport \"lib.js\" as Lib\n"
+                      "QtObject { property int value: Lib.times(3, 4) }\n"));
+    QVERIFY(writeFile(dir.filePath("lib.js"), "function times(a, b) { return a * b; }\n"));
+    const QUrl url = QUrl::fromLocalFile(dir.filePath("Main.qml"));
+
+    // Returns the compiled data of the document and of the script it imports.
+    using Units = std::pair<const QV4::CompiledData::Unit *, const QV4::CompiledData::Unit *>;
+    const auto load = [&](QQmlEngine *engine) -> Units {
+        QQmlComponent component(engine, url);
+        if (!component.isReady())
+            return {};
+        QScopedPointer<QObject> root(component.create());
+        if (!root || root->property("value").toInt() != 12)
+            return {};
+        const auto &compilationUnit = QQmlComponentPrivate::get(&component)->compilationUnit;
+        if (compilationUnit->dependentScripts.size() != 1)
+            return {};
+        return { compilationUnit->unitData(),
+                 compilationUnit->dependentScripts.first()->compilationUnit()->unitData() };
+    };
+
+    // Each engine has its own runtime data, but they all use the same compiled data.
+    QScopedPointer<QQmlEngine> first(new QQmlEngine);
+    const Units units = load(first.data());
+    QVERIFY(units.first);
+    QVERIFY(units.second);
+
+    QQmlEngine second;
+    QCOMPARE(load(&second), units);
+
+    // The data outlives the engine that compiled it.
+    first.reset();
+    QQmlEngine third;
+    QCOMPARE(load(&third), units);
+}
+
 QTEST_MAIN(tst_QQMLTypeLoader)
 
 #include "tst_qqmltypeloader.moc"
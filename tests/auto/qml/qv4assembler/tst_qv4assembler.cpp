@@ -5,11 +5,15 @@
 #if QT_CONFIG(process)
 #include <QtCore/qprocess.h>
 #endif
+#include <QtCore/qtemporarydir.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtQml/qqml.h>
 #include <QtQml/qqmlapplicationengine.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 
+#include <private/qjsvalue_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4functionobject_p.h>
 #include <private/qv4global_p.h>
 
 #ifdef Q_OS_WIN
@@ -28,6 +32,8 @@ private slots:
     void perfMapFile();
     void functionTable();
     void jitEnabled();
+    void optimizingJIT();
+    void codeCache();
 };
 
 tst_QV4Assembler::tst_QV4Assembler()
@@ -37,7 +43,9 @@ tst_QV4Assembler::tst_QV4Assembler()
 
 void tst_QV4Assembler::initTestCase()
 {
+    // The thresholds are process-wide. They are only read when the first engine is created.
     qputenv("QV4_JIT_CALL_THRESHOLD", "0");
+    qputenv("QV4_JIT_OPTIMIZE_THRESHOLD", "1");
     QQmlDataTest::initTestCase();
 }
 
@@ -143,6 +151,115 @@ void tst_QV4Assembler::jitEnabled()
 #endif
 }
 
+void tst_QV4Assembler::optimizingJIT()
+{
+    // The lookups get inlined while they are monomorphic. Afterwards they have to keep
+    // producing the same results as the runtime for any other kind of value.
+    QJSEngine engine;
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        function getX(o) { return o.x; }
+        function getP(o) { return o.p31; }
+        function getFoo(o) { return o.foo; }
+
+        var small = { x: 1 };
+        var big = {};
+        for (var i = 0; i < 32; ++i)
+            big["p" + i] = i;
+        big.x = 2;
+        function C() {}
+        C.prototype.foo = 5;
+        var c = new C;
+
+        var results = [];
+        for (var i = 0; i < 10; ++i)
+            results.push(getX(small), getP(big), getFoo(c));
+
+        results.push(getX(big), getX(5), getX("x"), getP(small), getP({ p31: 3 }));
+        C.prototype.foo = 6;
+        results.push(getFoo(c));
+        c.foo = 7;
+        results.push(getFoo(c), getFoo(new C));
+
+        try {
+            getX(null);
+            results.push("no exception");
+        } catch (e) {
+            results.push(e instanceof TypeError);
+        }
+        results.slice(27).join(",");
+    )"));
+
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toString(), QStringLiteral("1,31,5,2,,,,3,6,7,6,true"));
+
+#if QT_CONFIG(qml_jit)
+    // The functions were called often enough to be compiled by the optimizing JIT.
+    for (const QString &name : { QStringLiteral("getX"), QStringLiteral("getP"), QStringLiteral("getFoo") }) {
+        const QJSValue function = engine.globalObject().property(name);
+        const QV4::FunctionObject *functionObject
+                = QJSValuePrivate::asManagedType<QV4::FunctionObject>(&function);
+        QVERIFY(functionObject);
+        const QV4::Function *v4Function = functionObject->function();
+        QVERIFY(v4Function);
+        QVERIFY2(v4Function->jittedCode, qPrintable(name));
+        QVERIFY2(v4Function->baselineCodeRef, qPrintable(name));
+    }
+#endif
+}
+
+void tst_QV4Assembler::codeCache()
+{
+#if !QT_CONFIG(process)
+    QSKIP("Depends on QProcess");
+#elif !QT_CONFIG(qml_jit)
+    QSKIP("Depends on the JIT");
+#else
+    const QString qmljs = QLibraryInfo::path(QLibraryInfo::BinariesPath) + "/qmljs";
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QFile module(dir.filePath("test.mjs"));
+    QVERIFY(module.open(QIODevice::WriteOnly));
+    module.write("function sum(n) { let s = 0; for (let i = 0; i < n; ++i) { try { s += i; } "
+                 "catch (e) { s = -1; } } return s; }\n"
+                 "let total = 0;\n"
+                 "for (let i = 0; i < 10; ++i) total += sum(i);\n"
+                 "if (total !== 120) throw new Error('wrong result ' + total);\n");
+    module.close();
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("QV4_JIT_CODE_CACHE", "1");
+    environment.insert("QV4_JIT_CALL_THRESHOLD", "0");
+    environment.remove("QV4_JIT_OPTIMIZE_THRESHOLD");
+    environment.insert("QML_DISK_CACHE_PATH", dir.filePath("cache"));
+    environment.insert("QT_LOGGING_RULES", "qt.qml.diskcache.debug=true");
+    environment.remove("QML_DISABLE_DISK_CACHE");
+
+    const auto run = [&]() {
+        QProcess process;
+        process.setProcessEnvironment(environment);
+        process.start(qmljs, QStringList({ "--module", module.fileName() }));
+        if (!process.waitForFinished() || process.exitStatus() != QProcess::NormalExit
+                || process.exitCode() != 0) {
+            return QByteArray("failed: ") + process.readAllStandardError();
+        }
+        return process.readAllStandardError();
+    };
+
+    // The first run generates the code and stores it. The second one uses it right away.
+    QByteArray output = run();
+    QVERIFY2(!output.startsWith("failed"), output.constData());
+    QVERIFY2(!QDir(dir.filePath("cache")).entryList({ "*.jit" }, QDir::Files).isEmpty(),
+             output.constData());
+
+    environment.insert("QV4_JIT_CALL_THRESHOLD", "1000");
+    output = run();
+    QVERIFY2(!output.startsWith("failed"), output.constData());
+    QVERIFY2(output.contains("Loaded JIT code for"), output.constData());
+    QVERIFY2(!output.contains("Loaded JIT code for 0 functions"), output.constData());
+#endif
+}
+
 QTEST_MAIN(tst_QV4Assembler)
 
 #include "tst_qv4assembler.moc"
@@ -5,6 +5,7 @@
 #include <QQmlEngine>
 #include <QLoggingCategory>
 #include <QQmlComponent>
+#include <QJSEngine>
 
 #include <private/qv4mm_p.h>
 #include <private/qv4qobjectwrapper_p.h>
@@ -27,6 +28,10 @@ private slots:
     void accessParentOnDestruction();
     void cleanInternalClasses();
     void createObjectsOnDestruction();
+    void incrementalGC();
+    void generationalGC();
+    void writeBarrierAfterJit();
+    void parallelGC();
 };
 
 tst_qv4mm::tst_qv4mm()
@@ -206,6 +211,245 @@ void tst_qv4mm::createObjectsOnDestruction()
     QCOMPARE(obj->property("ok").toBool(), true);
 }
 
+void tst_qv4mm::incrementalGC()
+{
+    QV4::ExecutionEngine engine;
+    QV4::MemoryManager *mm = engine.memoryManager;
+    mm->setIncrementalGC(true);
+    mm->gcTimeSlice = 0; // the smallest possible steps
+
+    QV4::Scope scope(&engine);
+    QV4::ScopedString key(scope, engine.newIdentifier(QStringLiteral("value")));
+    QV4::ScopedArrayObject kept(scope, engine.newArrayObject());
+    QList<int> expected;
+
+    const auto newObject = [&](int value) {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject o(scope, engine.newObject());
+        o->put(key, QV4::Value::fromInt32(value));
+        return o->asReturnedValue();
+    };
+
+    for (int i = 0; i < 20000; ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedValue o(innerScope, newObject(i));
+        if (i % 2) {
+            kept->push_back(o);
+            expected.append(i);
+        }
+    }
+
+    const size_t usedBefore = mm->getUsedMem();
+    const uint cyclesBefore = mm->statistics.gcCycles;
+
+    mm->runGCStep();
+    QVERIFY(mm->isGCOngoing());
+
+    // Shuffle objects behind the marker's back, and replace some of them with new ones.
+    // The write barrier has to keep all of them alive.
+    uint round = 0;
+    while (mm->isGCOngoing()) {
+        QV4::Scope innerScope(&engine);
+        const uint size = uint(expected.size());
+        const uint a = (round * 7919) % size;
+        const uint b = (round * 104729 + 1) % size;
+        QV4::ScopedValue first(innerScope, kept->get(a));
+        QV4::ScopedValue second(innerScope, kept->get(b));
+        kept->put(a, second);
+        kept->put(b, first);
+        expected.swapItemsAt(a, b);
+        if (round % 16 == 0) {
+            QV4::ScopedValue fresh(innerScope, newObject(-int(round)));
+            kept->put(a, fresh);
+            expected[a] = -int(round);
+        }
+        ++round;
+        mm->runGCStep();
+    }
+
+    QCOMPARE(mm->statistics.gcCycles, cyclesBefore + 1);
+    QVERIFY(mm->getUsedMem() < usedBefore);
+
+    for (uint i = 0; i < uint(expected.size()); ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedObject o(innerScope, kept->get(i));
+        QVERIFY(o);
+        QCOMPARE(QV4::Value::fromReturnedValue(o->get(key)).toInt32(), expected.at(i));
+    }
+
+    // A full collection in the middle of an incremental one completes it.
+    mm->runGCStep();
+    QVERIFY(mm->isGCOngoing());
+    mm->runGC();
+    QVERIFY(!mm->isGCOngoing());
+    QCOMPARE(kept->getLength(), qint64(expected.size()));
+}
+
+void tst_qv4mm::generationalGC()
+{
+    QV4::ExecutionEngine engine;
+    QV4::MemoryManager *mm = engine.memoryManager;
+    mm->setGenerationalGC(true);
+    QVERIFY(engine.isGenerationalGC);
+
+    QV4::Scope scope(&engine);
+    QV4::ScopedString key(scope, engine.newIdentifier(QStringLiteral("value")));
+    QV4::ScopedArrayObject kept(scope, engine.newArrayObject());
+
+    const auto newObject = [&](int value) {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject o(scope, engine.newObject());
+        o->put(key, QV4::Value::fromInt32(value));
+        return o->asReturnedValue();
+    };
+
+    // kept becomes old
+    mm->runGC();
+    QVERIFY(kept->d()->isMarked());
+
+    // Young objects only referenced by an old one have to be found through the write barrier.
+    for (int i = 0; i < 10000; ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedValue o(innerScope, newObject(i));
+        if (i % 10 == 0)
+            kept->push_back(o);
+    }
+
+    const size_t usedBefore = mm->getUsedMem();
+    const uint minorBefore = mm->statistics.minorGCCycles;
+    mm->runMinorGC();
+    QCOMPARE(mm->statistics.minorGCCycles, minorBefore + 1);
+    QVERIFY(mm->getUsedMem() < usedBefore);
+    QVERIFY(mm->statistics.promotedMem > 0);
+    QVERIFY(mm->statistics.promotedMem < mm->statistics.youngMem);
+
+    QCOMPARE(kept->getLength(), qint64(1000));
+    for (uint i = 0; i < 1000; ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedObject o(innerScope, kept->get(i));
+        QVERIFY(o);
+        QVERIFY(o->d()->isMarked());
+        QCOMPARE(QV4::Value::fromReturnedValue(o->get(key)).toInt32(), int(i * 10));
+    }
+
+    // Old garbage is only freed by a full GC.
+    QV4::WeakValue oldObject;
+    oldObject.set(&engine, kept->get(0));
+    kept->setArrayLength(0);
+    mm->runMinorGC();
+    QVERIFY(!oldObject.isNullOrUndefined());
+    mm->runGC();
+    QVERIFY(oldObject.isNullOrUndefined());
+
+    mm->setGenerationalGC(false);
+    QVERIFY(!engine.isGenerationalGC);
+    QVERIFY(!kept->d()->isMarked());
+}
+
+void tst_qv4mm::writeBarrierAfterJit()
+{
+    QJSEngine jsEngine;
+    QV4::ExecutionEngine *engine = jsEngine.handle();
+    QV4::MemoryManager *mm = engine->memoryManager;
+    if (!engine->canJIT())
+        QSKIP("The JIT is not available");
+    if (mm->needsWriteBarrier())
+        QSKIP("The garbage collector already uses a write barrier");
+
+    const QJSValue result = jsEngine.evaluate(QStringLiteral(
+            "function f(x) { var o = { x: x }; return o.x + 1; }"
+            "var sum = 0; for (var i = 0; i < 100; ++i) sum += f(i); sum"));
+    QCOMPARE(result.toInt(), 5050);
+
+    // f() has been compiled without write barriers, and may still be running.
+    QTest::ignoreMessage(QtWarningMsg, "Cannot enable incremental garbage collection after JIT compiling code");
+    QVERIFY(!mm->setIncrementalGC(true));
+    QVERIFY(!mm->isIncrementalGC());
+    QTest::ignoreMessage(QtWarningMsg, "Cannot enable generational garbage collection after JIT compiling code");
+    QVERIFY(!mm->setGenerationalGC(true));
+    QVERIFY(!mm->isGenerationalGC());
+
+    // Code compiled with write barriers keeps working when they are no longer needed.
+    QJSEngine barrierEngine;
+    QV4::MemoryManager *barrierMm = barrierEngine.handle()->memoryManager;
+    QVERIFY(barrierMm->setIncrementalGC(true));
+    QCOMPARE(barrierEngine.evaluate(QStringLiteral(
+            "function g(x) { return x + 1; } var s = 0; for (var i = 0; i < 100; ++i) s += g(i); s"))
+             .toInt(), 5050);
+    QVERIFY(barrierMm->setIncrementalGC(false));
+    QVERIFY(barrierMm->setGenerationalGC(true));
+    QVERIFY(barrierMm->setIncrementalGC(true));
+}
+
+void tst_qv4mm::parallelGC()
+{
+    QV4::ExecutionEngine engine;
+    QV4::MemoryManager *mm = engine.memoryManager;
+    mm->setGCThreadCount(4);
+    QCOMPARE(mm->gcThreadCount(), 4);
+
+    QV4::Scope scope(&engine);
+    QV4::ScopedString key(scope, engine.newIdentifier(QStringLiteral("value")));
+    QV4::ScopedArrayObject kept(scope, engine.newArrayObject());
+
+    // A wide and deep enough graph to keep all threads busy, with some QObject wrappers in
+    // between. Those are marked on the engine thread.
+    QObject parent;
+    const int count = 20000;
+    for (int i = 0; i < count; ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedObject o(innerScope, engine.newObject());
+        o->put(key, QV4::Value::fromInt32(i));
+        if (i % 100 == 0) {
+            QObject *object = new QObject(&parent);
+            object->setObjectName(QString::number(i));
+            QV4::ScopedValue wrapper(innerScope, QV4::QObjectWrapper::wrap(&engine, object));
+            o->put(engine.id_name(), wrapper);
+        }
+        if (i % 2) {
+            kept->push_back(o);
+        } else if (i % 3 == 0) {
+            // chain objects to make the graph deeper
+            QV4::ScopedObject previous(innerScope, kept->get(uint(kept->getLength() - 1)));
+            if (previous)
+                previous->put(engine.id_prototype(), o);
+        }
+    }
+
+    const size_t usedBefore = mm->getUsedMem();
+    mm->runGC();
+    QVERIFY(mm->getUsedMem() < usedBefore);
+    QCOMPARE(mm->statistics.threads.size(), size_t(4));
+    quint64 markedObjects = 0;
+    for (const auto &threadStats : mm->statistics.threads)
+        markedObjects += threadStats.markedObjects;
+    QVERIFY(markedObjects >= quint64(count / 2));
+
+    for (uint i = 0; i < uint(count / 2); ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedObject o(innerScope, kept->get(i));
+        QVERIFY(o);
+        QCOMPARE(QV4::Value::fromReturnedValue(o->get(key)).toInt32(), int(i * 2 + 1));
+    }
+
+    // The wrappers of the objects that are still referenced survive.
+    mm->runGC();
+    for (uint i = 0; i < uint(count / 2); ++i) {
+        QV4::Scope innerScope(&engine);
+        QV4::ScopedObject o(innerScope, kept->get(i));
+        const int value = int(i * 2 + 1);
+        if (value % 100)
+            continue;
+        QV4::Scoped<QV4::QObjectWrapper> wrapper(innerScope, o->get(engine.id_name()));
+        QVERIFY(wrapper);
+        QCOMPARE(wrapper->object()->objectName(), QString::number(value));
+    }
+
+    mm->setGCThreadCount(1);
+    mm->runGC();
+    QCOMPARE(kept->getLength(), qint64(count / 2));
+}
+
 QTEST_MAIN(tst_qv4mm)
 
 #include "tst_qv4mm.moc"
@@ -4,6 +4,11 @@
 #include <qtest.h>
 #include <private/qv4instr_moth_p.h>
 #include <private/qv4script_p.h>
+#include <private/qv4lookup_p.h>
+#include <private/qjsvalue_p.h>
+#include <private/qv4jsonobject_p.h>
+
+#include <QtCore/qbuffer.h>
 
 class tst_v4misc: public QObject
 {
@@ -20,6 +25,14 @@ private slots:
     void subClassing();
 
     void nestingDepth();
+
+    void polymorphicLookups();
+    void stringBuilder();
+    void stringBuilderTermination();
+    void arrayElementKinds();
+    void typedArrayBulkOperations();
+    void jsonParseAndStringify();
+    void jsonStreamParser();
 };
 
 void tst_v4misc::tdzOptimizations_data()
@@ -172,6 +185,325 @@ void tst_v4misc::nestingDepth()
     }
 }
 
+void tst_v4misc::polymorphicLookups()
+{
+    QJSEngine engine;
+    const QV4::MegamorphicLookupCache::Statistics &stats
+            = engine.handle()->megamorphicLookupCache->statistics;
+
+    QJSValue result = engine.evaluate(QStringLiteral(R"(
+        function getX(o) { return o.x; }
+        function getY(o) { return o.y; }
+
+        var many = [];
+        for (var i = 0; i < 12; ++i) {
+            var o = {};
+            o["p" + i] = i;
+            o.x = i;
+            many.push(o);
+        }
+        var few = [{ y: 1 }, { a: 0, y: 2 }, Object.create({ y: 3 })];
+
+        var sum = 0;
+        for (var round = 0; round < 3; ++round) {
+            for (var i = 0; i < many.length; ++i)
+                sum += getX(many[i]);
+            for (var i = 0; i < few.length; ++i)
+                sum += getY(few[i]);
+        }
+        sum += getX(Object.create({ x: 100 }));
+        sum;
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toInt(), 3 * 66 + 3 * 6 + 100);
+
+    QVERIFY(stats.polymorphicLookups >= 2);
+    QVERIFY(stats.polymorphicHits > 0);
+    QCOMPARE(stats.megamorphicLookups, quint64(1));
+    QVERIFY(stats.megamorphicHits > 0);
+
+    // The shared cache forgets everything on GC, and has to be refilled correctly.
+    engine.collectGarbage();
+    const quint64 misses = stats.megamorphicMisses;
+    result = engine.evaluate(QStringLiteral(R"(
+        var sum = 0;
+        for (var i = 0; i < many.length; ++i)
+            sum += getX(many[i]);
+        sum += getX("x") === undefined ? 1000 : 0;
+        sum;
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toInt(), 66 + 1000);
+    QVERIFY(stats.megamorphicMisses > misses);
+}
+
+void tst_v4misc::stringBuilder()
+{
+    // Only the last string appended to a buffer may append to it in place. Appending to an
+    // earlier string has to leave the later ones alone.
+    QJSEngine engine;
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var s = "";
+        for (var i = 0; i < 1000; ++i)
+            s += String.fromCharCode(97 + i % 26);
+        var first = s;
+        var a = first + "A";
+        var b = first + "BB";
+        var c = a + "C";
+        s += "D";
+        [a.length, a.slice(-2), b.length, b.slice(-3), c.slice(-3), s.slice(-2),
+         first.length, first === s.slice(0, 1000), a === first + "A"].join(",");
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toString(), QStringLiteral("1001,lA,1002,lBB,lAC,lD,1000,true,true"));
+}
+
+void tst_v4misc::stringBuilderTermination()
+{
+    // Text handed out as QString has to stay '\0'-terminated, and must not change when the
+    // engine appends to the string it came from.
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var s = "";
+        for (var i = 0; i < 1000; ++i)
+            s += String.fromCharCode(97 + i % 26);
+        var prefix = s;
+        s += "x";
+        s;
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+
+    const QString prefix = engine.globalObject().property(QStringLiteral("prefix")).toString();
+    QCOMPARE(prefix.size(), 1000);
+    QCOMPARE(prefix.utf16()[prefix.size()], u'\0');
+
+    const QString handedOut = result.toString();
+    QCOMPARE(handedOut.size(), 1001);
+    QCOMPARE(handedOut.utf16()[handedOut.size()], u'\0');
+
+    result = engine.evaluate(QStringLiteral(R"(
+        for (var i = 0; i < 10; ++i)
+            s += "y";
+        s;
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(handedOut.size(), 1001);
+    QCOMPARE(handedOut.utf16()[handedOut.size()], u'\0');
+    QVERIFY(handedOut.endsWith(QLatin1Char('x')));
+
+    const QString appended = result.toString();
+    QCOMPARE(appended.size(), 1011);
+    QCOMPARE(appended.utf16()[appended.size()], u'\0');
+    QVERIFY(appended.startsWith(handedOut));
+}
+
+void tst_v4misc::arrayElementKinds()
+{
+    QJSEngine engine;
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var ints = [];
+        for (var i = 0; i < 100; ++i)
+            ints.push(i);
+        var doubles = ints.map(function(x) { return x + 0.5; });
+        var objects = ints.slice();
+        objects[50] = { name: "fifty" };
+        var holey = [1, , 3];
+        gc();
+        Array.prototype[1] = 2;
+        var proto = holey.includes(2) && holey.indexOf(2) === 1;
+        delete Array.prototype[1];
+        [ints.indexOf(42), ints.indexOf(42.5), ints.includes(-0), doubles.indexOf(10.5),
+         doubles.lastIndexOf(99.5), [NaN, 1.5].includes(NaN), [NaN, 1.5].indexOf(NaN),
+         objects[50].name, objects.indexOf(49), proto, ints.fill(7, 90).lastIndexOf(7),
+         ints.indexOf(7, 8)].join(",");
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toString(), QStringLiteral("42,-1,true,10,99,true,-1,fifty,49,true,99,90"));
+
+    const auto elementKind = [&](const QString &name) {
+        const QJSValue array = engine.globalObject().property(name);
+        QV4::Scope scope(engine.handle());
+        QV4::ScopedObject o(scope, QJSValuePrivate::asReturnedValue(&array));
+        return o && o->arrayData() ? int(o->arrayData()->d()->elementKind) : -1;
+    };
+    QCOMPARE(elementKind(QStringLiteral("ints")), int(QV4::Heap::ArrayData::PackedInt32Elements));
+    QCOMPARE(elementKind(QStringLiteral("doubles")), int(QV4::Heap::ArrayData::PackedDoubleElements));
+    QCOMPARE(elementKind(QStringLiteral("objects")), int(QV4::Heap::ArrayData::PackedElements));
+    QCOMPARE(elementKind(QStringLiteral("holey")), int(QV4::Heap::ArrayData::HoleyElements));
+}
+
+void tst_v4misc::typedArrayBulkOperations()
+{
+    // Long enough to go through the vectorized paths, with a tail that isn't.
+    QJSEngine engine;
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var bytes = new Uint8Array(37);
+        bytes.fill(3, 5, 30);
+        var words = new Int16Array(37).fill(-1);
+        words[33] = 5;
+        var floats = new Float32Array(37);
+        floats[20] = NaN;
+        floats[35] = 0.5;
+        var signed = new Int8Array([-1, 2, -3]);
+        var unsigned = new Uint8Array(3);
+        unsigned.set(signed);
+        var clamped = new Uint8ClampedArray(3);
+        clamped.set(signed);
+        var reversed = new Int32Array([1, 2, 3, 4, 5, 6, 7]).reverse();
+        [bytes.indexOf(3), bytes.lastIndexOf(3), bytes.indexOf(259), bytes.includes(0, 30),
+         words.indexOf(5), words.indexOf(65535), words.lastIndexOf(-1, 32),
+         floats.indexOf(0.5), floats.indexOf(NaN), floats.includes(NaN), floats.indexOf(-0),
+         floats.includes(0.1), unsigned.join(":"), clamped.join(":"), reversed.join(":"),
+         reversed.subarray(2, 6).slice(1).join(":")].join(",");
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toString(),
+             QStringLiteral("5,29,-1,true,33,-1,32,35,-1,true,0,false,255:2:253,0:2:0,"
+                            "7:6:5:4:3:2:1,4:3:2"));
+}
+
+void tst_v4misc::jsonParseAndStringify()
+{
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var parsed = JSON.parse('{"a": 1, "a": 2, "__proto__": {"x": 1}, "7": "seven", "e\\u0073c": "t\\tab",'
+                                + ' "n": [-12, 123456789012, 1e3, 0.5, -33554432, 33554431]}');
+        var text = "[";
+        for (var i = 0; i < 3000; ++i)
+            text += (i ? "," : "") + i;
+        var big = JSON.parse(text + "]");
+        var wide = {};
+        for (var i = 0; i < 1500; ++i)
+            wide["k" + i] = i;
+        var wideCopy = JSON.parse(JSON.stringify(wide));
+        [Object.keys(parsed).join(":"), parsed.a, parsed.hasOwnProperty("__proto__"),
+         Object.getPrototypeOf(parsed) === Object.prototype, parsed[7], parsed.esc.length,
+         parsed.n.join(":"), big.length, big[1023] + big[1024] + big[2999],
+         Object.keys(wideCopy).length, wideCopy.k1499, JSON.stringify(undefined)].join(",");
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QCOMPARE(result.toString(),
+             QStringLiteral("7:a:__proto__:esc:n,2,true,true,seven,4,"
+                            "-12:123456789012:1000:0.5:-33554432:33554431,3000,5046,1500,1499,"));
+
+    result = engine.evaluate(QStringLiteral(R"(
+        JSON.stringify({ a: 1, b: undefined, c: [1, undefined, function() {}], e: {}, f: [],
+                         d: { toJSON: function(key) { return "key:" + key; } } }, null, 2);
+    )"));
+    QCOMPARE(result.toString(),
+             QStringLiteral("{\n  \"a\": 1,\n  \"c\": [\n    1,\n    null,\n    null\n  ],\n"
+                            "  \"e\": {},\n  \"f\": [],\n  \"d\": \"key:d\"\n}"));
+
+    result = engine.evaluate(QStringLiteral(R"(
+        JSON.stringify([5, { x: 1, y: 2 }, "a\"b\\c\u0001\n"], function(key, value) {
+            return key === "y" ? undefined : (typeof value === "number" ? value * 2 : value);
+        });
+    )"));
+    QCOMPARE(result.toString(), QStringLiteral("[10,{\"x\":2},\"a\\\"b\\\\c\\u0001\\n\"]"));
+}
+
+void tst_v4misc::jsonStreamParser()
+{
+    QJSEngine engine;
+    QV4::Scope scope(engine.handle());
+    QV4::ScopedValue value(scope);
+    QJsonParseError error;
+    const QJSValue stringify = engine.globalObject().property(QStringLiteral("JSON"))
+            .property(QStringLiteral("stringify"));
+    const auto toString = [&](const QV4::Value &v) {
+        return stringify.call({ QJSValuePrivate::fromReturnedValue(v.asReturnedValue()) })
+                .toString();
+    };
+
+    {
+        // Values are only parsed once they are complete, no matter where the chunks are split.
+        QV4::JsonStreamParser parser(scope.engine);
+        parser.addData("[12");
+        QVERIFY(!parser.hasValue());
+        parser.addData("34, \"a[b\\");
+        QVERIFY(!parser.hasValue());
+        parser.addData("\"c\"]  56");
+        QVERIFY(parser.hasValue());
+        value = parser.parseNext(&error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(toString(value), QStringLiteral("[1234,\"a[b\\\"c\"]"));
+
+        // A number at the top level only ends with whatever comes after it.
+        QVERIFY(!parser.hasValue());
+        parser.addData("78\n");
+        QVERIFY(parser.hasValue());
+        value = parser.parseNext(&error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(toString(value), QStringLiteral("5678"));
+
+        QVERIFY(!parser.atEnd());
+        parser.endOfData();
+        QVERIFY(!parser.hasValue());
+        QVERIFY(parser.atEnd());
+    }
+
+    const QByteArray json = QStringLiteral(
+            u"{\"text\": \"grüße \\\"[€]\\\"\", \"n\": -12345.5e1}\n"
+            u"[1, 23456, {\"a\": []}]\n"
+            u"\"top\\\\\" 789 true").toUtf8();
+    const QStringList expected = {
+        QStringLiteral(u"{\"text\":\"grüße \\\"[€]\\\"\",\"n\":-123455}"),
+        QStringLiteral("[1,23456,{\"a\":[]}]"),
+        QStringLiteral("\"top\\\\\""),
+        QStringLiteral("789"),
+        QStringLiteral("true")
+    };
+
+    for (qint64 chunkSize = 1; chunkSize <= 8; ++chunkSize) {
+        QBuffer buffer;
+        buffer.setData(json);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        QV4::JsonStreamParser parser(scope.engine);
+        QStringList values;
+        while (!parser.atEnd()) {
+            value = parser.readNext(&buffer, &error, chunkSize);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            if (!value->isUndefined())
+                values.append(toString(value));
+
+            // Only what is needed for the current value is read.
+            if (values.size() == 1)
+                QVERIFY(buffer.pos() <= json.indexOf("}\n") + chunkSize);
+        }
+        QCOMPARE(values, expected);
+    }
+
+    {
+        // A broken value is reported and skipped, at its position in the stream.
+        QV4::JsonStreamParser parser(scope.engine);
+        parser.addData("[1, 2} [3] {\"a\": [1");
+        value = parser.parseNext(&error);
+        QVERIFY(error.error != QJsonParseError::NoError);
+        QVERIFY(error.offset > 0 && error.offset <= 6);
+        QVERIFY(value->isUndefined());
+
+        value = parser.parseNext(&error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(toString(value), QStringLiteral("[3]"));
+
+        // The input ends in the middle of a value.
+        QVERIFY(!parser.hasValue());
+        parser.endOfData();
+        QVERIFY(parser.hasValue());
+        value = parser.parseNext(&error);
+        QVERIFY(error.error != QJsonParseError::NoError);
+        QVERIFY(error.offset >= 11);
+        QVERIFY(parser.atEnd());
+    }
+
+    QV4::JsonStreamParser invalid(scope.engine);
+    invalid.addData("[\"\xff\"]");
+    value = invalid.parseNext(&error);
+    QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+    QVERIFY(value->isUndefined());
+}
+
 QTEST_MAIN(tst_v4misc);
 
 #include "tst_v4misc.moc"
@@ -0,0 +1,28 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 400
+    height: 200
+    color: "white"
+
+    Text {
+        objectName: "text"
+        anchors.fill: parent
+        visible: false
+        renderType: Text.QtRendering
+        // A glyph cache of its own, so that none of the glyphs are cached yet
+        renderTypeQuality: Text.VeryHighRenderTypeQuality
+        font.pixelSize: 20
+        wrapMode: Text.WrapAnywhere
+        // More distinct glyphs than are rendered while preparing a frame
+        text: {
+            var s = "";
+            for (var i = 33; i < 127; ++i)
+                s += String.fromCharCode(i);
+            return s;
+        }
+    }
+}
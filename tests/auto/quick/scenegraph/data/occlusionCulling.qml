@@ -0,0 +1,25 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    Rectangle { x: 10; y: 10; width: 60; height: 60; color: "red" }
+    Rectangle { x: 80; y: 10; width: 60; height: 60; color: "#8000ff00" }
+    Image { x: 10; y: 80; source: "logo-small.jpg" }
+    Text { x: 80; y: 150; text: "Hidden"; color: "blue" }
+
+    // Only partially covered
+    Rectangle { x: 140; y: 100; width: 50; height: 50; color: "black" }
+
+    Rectangle {
+        objectName: "cover"
+        width: 160
+        height: 200
+        color: "steelblue"
+    }
+}
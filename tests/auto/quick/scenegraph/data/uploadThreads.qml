@@ -0,0 +1,36 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+import SceneGraphTest 1.0
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    // 40.000 rectangles in one merged batch, which is too many vertices for a
+    // single draw call and gets split into several draw sets.
+    Column {
+        objectName: "drawSets"
+        width: 100
+        clip: true
+        PerPixelRect { width: 100; height: 200; color: "red" }
+        PerPixelRect { width: 100; height: 200; color: "blue" }
+    }
+
+    // Merged batches of indexed triangle strips with differing transforms
+    Repeater {
+        model: 100
+        Rectangle {
+            x: 100 + (index % 10) * 10
+            y: Math.floor(index / 10) * 20
+            width: 8
+            height: 15
+            rotation: index * 7
+            color: Qt.rgba(index / 100, 0.5, 1 - index / 100, 1)
+            border.color: "black"
+            border.width: 1
+        }
+    }
+}
@@ -96,6 +96,9 @@ private slots:
     void createTextureFromImage();
     void withAdoptedRhi();
     void resizeTextureFromImage();
+    void backgroundGlyphRendering();
+    void occlusionCulling();
+    void uploadThreads();
 
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
@@ -783,6 +786,147 @@ void tst_SceneGraph::resizeTextureFromImage()
     TestOffscreenScene::cleanup();
 }
 
+static int darkPixelCount(const QImage &image)
+{
+    const QImage img = image.convertToFormat(QImage::Format_RGB32);
+    int count = 0;
+    for (int y = 0; y < img.height(); ++y) {
+        const QRgb *pixels = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+        for (int x = 0; x < img.width(); ++x) {
+            if (qGray(pixels[x]) < 128)
+                ++count;
+        }
+    }
+    return count;
+}
+
+void tst_SceneGraph::backgroundGlyphRendering()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping distance field text test due to not running with QRhi");
+
+    QImage finalContent;
+    {
+        qputenv("QSG_DISTANCEFIELD_GLYPH_THREADS", "2");
+        auto cleanup = qScopeGuard([]() { qunsetenv("QSG_DISTANCEFIELD_GLYPH_THREADS"); });
+
+        QQuickView view;
+        view.setSource(testFileUrl("backgroundGlyphs.qml"));
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        QQuickItem *text = view.rootObject()->findChild<QQuickItem *>("text");
+        QVERIFY(text);
+
+        // The glyphs beyond those rendered while preparing the frame are left out
+        text->setVisible(true);
+        const int partialCount = darkPixelCount(view.grabWindow());
+        QVERIFY(partialCount > 0);
+
+        // ... and show up in a later frame
+        QTRY_VERIFY(darkPixelCount(view.grabWindow()) > partialCount);
+        finalContent = view.grabWindow();
+    }
+
+    // Nothing is missing in the end
+    QQuickView view;
+    view.setSource(testFileUrl("backgroundGlyphs.qml"));
+    view.rootObject()->findChild<QQuickItem *>("text")->setVisible(true);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QCOMPARE(view.grabWindow(), finalContent);
+}
+
+static QList<QImage> grabOcclusionCullingStates(const QUrl &url, const QByteArray &culling)
+{
+    qputenv("QSG_RENDERER_OCCLUSION_CULLING", culling);
+    auto cleanup = qScopeGuard([]() { qunsetenv("QSG_RENDERER_OCCLUSION_CULLING"); });
+
+    QList<QImage> images;
+    QQuickView view;
+    view.setSource(url);
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view))
+        return images;
+    QQuickItem *cover = view.rootObject()->findChild<QQuickItem *>("cover");
+    if (!cover)
+        return images;
+
+    images << view.grabWindow();
+    // Uncover some of the hidden items
+    cover->setX(100);
+    images << view.grabWindow();
+    cover->setX(0);
+    images << view.grabWindow();
+    // A translucent cover hides nothing
+    cover->setOpacity(0.5);
+    images << view.grabWindow();
+    cover->setOpacity(1);
+    images << view.grabWindow();
+    cover->setVisible(false);
+    images << view.grabWindow();
+    cover->setVisible(true);
+    images << view.grabWindow();
+    return images;
+}
+
+void tst_SceneGraph::occlusionCulling()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping occlusion culling test due to not running with QRhi");
+
+    const QUrl url = testFileUrl("occlusionCulling.qml");
+    const QList<QImage> reference = grabOcclusionCullingStates(url, "0");
+    QCOMPARE(reference.size(), 7);
+    const QList<QImage> culled = grabOcclusionCullingStates(url, "1");
+    QCOMPARE(culled.size(), reference.size());
+
+    QVERIFY(reference.at(0) != reference.at(1));
+    QVERIFY(reference.at(0) != reference.at(3));
+    QVERIFY(reference.at(0) != reference.at(5));
+    for (int i = 0; i < reference.size(); ++i)
+        QCOMPARE(culled.at(i), reference.at(i));
+}
+
+static QList<QImage> grabUploadThreadStates(const QUrl &url, const QByteArray &threads)
+{
+    qputenv("QSG_RENDERER_UPLOAD_THREADS", threads);
+    auto cleanup = qScopeGuard([]() { qunsetenv("QSG_RENDERER_UPLOAD_THREADS"); });
+
+    QList<QImage> images;
+    QQuickView view;
+    view.setSource(url);
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view))
+        return images;
+    QQuickItem *drawSets = view.rootObject()->findChild<QQuickItem *>("drawSets");
+    if (!drawSets)
+        return images;
+
+    images << view.grabWindow();
+    // Moving the clipped batch uploads all of its vertices again
+    drawSets->setY(-150);
+    images << view.grabWindow();
+    return images;
+}
+
+void tst_SceneGraph::uploadThreads()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping upload thread test due to not running with QRhi");
+
+    const QUrl url = testFileUrl("uploadThreads.qml");
+    const QList<QImage> reference = grabUploadThreadStates(url, "0");
+    QCOMPARE(reference.size(), 2);
+    QVERIFY(reference.at(0) != reference.at(1));
+
+    for (const QByteArray &threads : { QByteArray("1"), QByteArray("3") }) {
+        const QList<QImage> threaded = grabUploadThreadStates(url, threads);
+        QCOMPARE(threaded.size(), reference.size());
+        for (int i = 0; i < reference.size(); ++i)
+            QCOMPARE(threaded.at(i), reference.at(i));
+    }
+}
+
 bool tst_SceneGraph::isRunningOnRhi()
 {
     static bool retval = false;
@@ -22,6 +22,7 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void tiledRendering();
 };
 
 tst_SoftwareRenderer::tst_SoftwareRenderer()
@@ -93,6 +94,74 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+static QImage renderScene(const QByteArray &threadCount)
+{
+    qputenv("QSG_SOFTWARE_RENDERER_THREADS", threadCount);
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    window->resize(320, 240);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQuick
+        Item {
+            width: 320; height: 240
+            Repeater {
+                model: 60
+                Rectangle {
+                    x: (index * 37) % 280; y: (index * 23) % 200
+                    width: 40 + index % 7; height: 30 + index % 5
+                    radius: index % 3 * 6
+                    rotation: index % 4 * 15
+                    border.width: index % 2
+                    color: Qt.rgba(index % 5 / 4, index % 3 / 2, index % 7 / 6, 0.5 + index % 2 / 2)
+                }
+            }
+            Repeater {
+                model: 8
+                Text { y: index * 30; text: "Tile " + index; font.pixelSize: 24 }
+            }
+        }
+    )", QUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    if (!item) {
+        qunsetenv("QSG_SOFTWARE_RENDERER_THREADS");
+        return QImage();
+    }
+    item->setParentItem(window->contentItem());
+
+    QImage target(window->size(), QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::red);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&target));
+    window->setColor(Qt::white);
+
+    rc.polishItems();
+    rc.beginFrame();
+    rc.sync();
+    rc.render();
+    rc.endFrame();
+
+    qunsetenv("QSG_SOFTWARE_RENDERER_THREADS");
+    return target;
+}
+
+void tst_SoftwareRenderer::tiledRendering()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    const QImage serial = renderScene("0");
+    QVERIFY(!serial.isNull());
+    const QImage tiled = renderScene("3");
+    QVERIFY(!tiled.isNull());
+
+    QString errorMessage;
+    QVERIFY2(QQuickVisualTestUtils::compareImages(tiled, serial, &errorMessage),
+             qPrintable(errorMessage));
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
@@ -0,0 +1,17 @@
+import Test 1.0
+
+MyQmlObject {
+    property int a: value + 1
+    property int b: value + 2
+    property int c: value + 3
+    property int d: value + 4
+    property int e: value + 5
+    property int f: value + 6
+    property int g: value + 7
+    property int h: value + 8
+
+    result: {
+        countEvaluation();
+        return a + b + c + d + e + f + g + h + value;
+    }
+}
@@ -28,6 +28,8 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void diamond_data();
+    void diamond();
 
 private:
     QQmlEngine engine;
@@ -150,5 +152,41 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::diamond_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("immediate") << false;
+    QTest::newRow("batched") << true;
+}
+
+void tst_binding::diamond()
+{
+    QFETCH(bool, batched);
+
+    if (batched)
+        qputenv("QML_BATCH_BINDING_UPDATES", "1");
+    QQmlEngine engine;
+    qunsetenv("QML_BATCH_BINDING_UPDATES");
+
+    QQmlComponent c(&engine, QUrl::fromLocalFile(SRCDIR "/data/diamond.qml"));
+    QScopedPointer<MyQmlObject> object(qobject_cast<MyQmlObject *>(c.create()));
+    QVERIFY(object);
+
+    // The first change tells batched updates in which order to evaluate the bindings.
+    int value = 0;
+    object->setValue(++value);
+
+    const int evaluations = object->evaluations();
+    QBENCHMARK {
+        object->setValue(++value);
+    }
+    QCOMPARE(object->result(), 9 * value + 36);
+
+    const int changes = value - 1;
+    qDebug() << "Evaluated the result" << double(object->evaluations() - evaluations) / changes
+             << "times per change";
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
@@ -0,0 +1,66 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+
+class tst_bench_qv4mm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void maxPause_data();
+    void maxPause();
+};
+
+void tst_bench_qv4mm::maxPause_data()
+{
+    QTest::addColumn<bool>("incremental");
+    QTest::newRow("stop-the-world") << false;
+    QTest::newRow("incremental") << true;
+}
+
+// Reports the longest time JavaScript execution was blocked by the garbage collector while a
+// large live heap is around and a lot of garbage is being produced.
+void tst_bench_qv4mm::maxPause()
+{
+    QFETCH(bool, incremental);
+
+    QJSEngine jsEngine;
+    QV4::MemoryManager *mm = jsEngine.handle()->memoryManager;
+    mm->setIncrementalGC(incremental);
+
+    jsEngine.evaluate(QStringLiteral(
+            "var live = [];"
+            "for (var i = 0; i < 300000; ++i)"
+            "    live.push({ index: i, name: 'item' + i, next: live[i - 1] });"));
+    mm->runGC();
+    mm->statistics.maxPauseTime = 0;
+    const uint cyclesBefore = mm->statistics.gcCycles;
+
+    QJSValue result = jsEngine.evaluate(QStringLiteral(
+            "var checksum = 0;"
+            "for (var n = 0; n < 100; ++n) {"
+            "    var garbage = [];"
+            "    for (var i = 0; i < 10000; ++i)"
+            "        garbage.push({ index: i, text: 'garbage' + i });"
+            "    checksum += garbage.length + live[n * 1000].index;"
+            "}"
+            "checksum;"));
+    QVERIFY(!result.isError());
+
+    // Let scheduled incremental steps finish the last cycle.
+    while (mm->isGCOngoing())
+        QCoreApplication::processEvents();
+
+    qDebug() << "GC cycles:" << (mm->statistics.gcCycles - cyclesBefore)
+             << "steps:" << mm->statistics.gcSteps;
+    QTest::setBenchmarkResult(qreal(mm->statistics.maxPauseTime) / 1000,
+                              QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_bench_qv4mm)
+
+#include "tst_qv4mm.moc"
@@ -0,0 +1,99 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+
+class tst_bench_qv4string : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void logFormatting_data();
+    void logFormatting();
+    void csvExport_data();
+    void csvExport();
+
+private:
+    QJSEngine engine;
+};
+
+void tst_bench_qv4string::initTestCase()
+{
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        function formatLog(lines, inspect) {
+            var log = "";
+            for (var i = 0; i < lines; ++i) {
+                log += "[" + (1000 + i) + "] " + (i % 3 ? "debug" : "warning") + ": ";
+                log += "processed item " + i + " of " + lines + "\n";
+                // Something that needs the text as a whole while we're still building it.
+                if (inspect && log.endsWith("\n"))
+                    log += "";
+            }
+            return log.length;
+        }
+
+        var table = [];
+        for (var i = 0; i < 10000; ++i)
+            table.push({ id: i, name: "name" + i, price: i * 0.25, inStock: i % 2 == 0 });
+
+        function exportCsv(rows) {
+            var csv = "id,name,price,inStock\n";
+            for (var i = 0; i < rows; ++i) {
+                var row = table[i];
+                csv += row.id + "," + row.name + "," + row.price + "," + row.inStock + "\n";
+            }
+            return csv.length;
+        }
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+}
+
+void tst_bench_qv4string::logFormatting_data()
+{
+    QTest::addColumn<int>("lines");
+    QTest::addColumn<bool>("inspect");
+    QTest::newRow("1000 lines") << 1000 << false;
+    QTest::newRow("10000 lines") << 10000 << false;
+    QTest::newRow("10000 lines, inspected") << 10000 << true;
+}
+
+void tst_bench_qv4string::logFormatting()
+{
+    QFETCH(int, lines);
+    QFETCH(bool, inspect);
+
+    QJSValue formatLog = engine.globalObject().property(QStringLiteral("formatLog"));
+    QJSValue result;
+    QBENCHMARK {
+        result = formatLog.call({ lines, inspect });
+    }
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QVERIFY(result.toInt() > lines * 30);
+}
+
+void tst_bench_qv4string::csvExport_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("100 rows") << 100;
+    QTest::newRow("1000 rows") << 1000;
+    QTest::newRow("10000 rows") << 10000;
+}
+
+void tst_bench_qv4string::csvExport()
+{
+    QFETCH(int, rows);
+
+    QJSValue exportCsv = engine.globalObject().property(QStringLiteral("exportCsv"));
+    QJSValue result;
+    QBENCHMARK {
+        result = exportCsv.call({ rows });
+    }
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QVERIFY(result.toInt() > rows * 10);
+}
+
+QTEST_MAIN(tst_bench_qv4string)
+
+#include "tst_qv4string.moc"
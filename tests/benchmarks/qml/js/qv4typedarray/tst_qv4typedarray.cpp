@@ -0,0 +1,134 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtQml/qjsengine.h>
+
+class tst_bench_qv4typedarray : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void bulkOperation_data();
+    void bulkOperation();
+
+private:
+    QJSEngine engine;
+};
+
+void tst_bench_qv4typedarray::initTestCase()
+{
+    // Each operation exists as the builtin and as the element by element loop a script would
+    // otherwise have to use. Both process the whole 1MB array once per call.
+    const QJSValue result = engine.evaluate(QStringLiteral(R"(
+        var size = 1024 * 1024;
+        var arrays = {
+            Uint8Array: { a: new Uint8Array(size), b: new Uint8Array(size) },
+            Float32Array: { a: new Float32Array(size / 4), b: new Float32Array(size / 4) }
+        };
+
+        function run(type, operation, builtin) {
+            var a = arrays[type].a;
+            var b = arrays[type].b;
+            var n = a.length;
+            var i;
+            switch (operation) {
+            case "fill":
+                if (builtin)
+                    a.fill(7);
+                else
+                    for (i = 0; i < n; ++i)
+                        a[i] = 7;
+                return a[n - 1];
+            case "set":
+                if (builtin)
+                    a.set(b);
+                else
+                    for (i = 0; i < n; ++i)
+                        a[i] = b[i];
+                return a[0];
+            case "indexOf":
+                if (builtin)
+                    return a.indexOf(42);
+                for (i = 0; i < n; ++i) {
+                    if (a[i] === 42)
+                        return i;
+                }
+                return -1;
+            case "reverse":
+                if (builtin) {
+                    a.reverse();
+                } else {
+                    for (var lo = 0, hi = n - 1; lo < hi; ++lo, --hi) {
+                        var t = a[lo];
+                        a[lo] = a[hi];
+                        a[hi] = t;
+                    }
+                }
+                return a[0];
+            case "slice":
+                if (builtin)
+                    return a.slice(1).length;
+                var c = new a.constructor(n - 1);
+                for (i = 1; i < n; ++i)
+                    c[i - 1] = a[i];
+                return c.length;
+            }
+            throw new Error("unknown operation " + operation);
+        }
+    )"));
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+}
+
+void tst_bench_qv4typedarray::bulkOperation_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<bool>("builtin");
+
+    const QString types[] = { QStringLiteral("Uint8Array"), QStringLiteral("Float32Array") };
+    const QString operations[] = {
+        QStringLiteral("fill"), QStringLiteral("set"), QStringLiteral("indexOf"),
+        QStringLiteral("reverse"), QStringLiteral("slice")
+    };
+    for (const QString &type : types) {
+        for (const QString &operation : operations) {
+            QTest::addRow("%s.%s, builtin", qPrintable(type), qPrintable(operation))
+                    << type << operation << true;
+            QTest::addRow("%s.%s, script loop", qPrintable(type), qPrintable(operation))
+                    << type << operation << false;
+        }
+    }
+}
+
+void tst_bench_qv4typedarray::bulkOperation()
+{
+    QFETCH(QString, type);
+    QFETCH(QString, operation);
+    QFETCH(bool, builtin);
+
+    const qint64 bytes = 1024 * 1024;
+    QJSValue run = engine.globalObject().property(QStringLiteral("run"));
+    QJSValue result = run.call({ type, operation, builtin });
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+
+    // Report the throughput rather than the time per call, so that the element types can be
+    // compared with each other.
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        result = run.call({ type, operation, builtin });
+        ++iterations;
+    } while (timer.elapsed() < 500);
+    const qreal seconds = timer.nsecsElapsed() / 1e9;
+
+    QVERIFY2(!result.isError(), qPrintable(result.toString()));
+    QTest::setBenchmarkResult(iterations * bytes / seconds, QTest::BytesPerSecond);
+}
+
+QTEST_MAIN(tst_bench_qv4typedarray)
+
+#include "tst_qv4typedarray.moc"
@@ -0,0 +1,25 @@
+import QtQuick
+
+Item {
+    id: root
+    width: 800
+    height: 600
+
+    property int count: 0
+    property int frame: 0
+
+    Repeater {
+        model: root.count
+        Rectangle {
+            // Resize and move all rectangles each frame, so that all batches have to be
+            // uploaded again, and rotate some of them to get full matrix transforms.
+            x: (index % 100) * 8
+            y: (Math.floor(index / 100) % 75) * 8
+            width: 4 + (index + root.frame) % 4
+            height: 6
+            rotation: index % 3 === 0 ? (index + root.frame) % 90 : 0
+            color: index % 2 ? "steelblue" : "tomato"
+            opacity: index % 5 === 0 ? 0.5 : 1
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/QElapsedTimer>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QSGRendererInterface>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+class tst_batchrenderer : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_batchrenderer();
+
+private slots:
+    void initTestCase() override;
+    void prepare_data();
+    void prepare();
+};
+
+tst_batchrenderer::tst_batchrenderer()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_batchrenderer::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    // Nothing is drawn. This measures the CPU side of preparing a frame only.
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+}
+
+void tst_batchrenderer::prepare_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QByteArray>("threads");
+
+    for (int count : { 1000, 10000, 40000 }) {
+        QTest::addRow("%d rectangles, render thread only", count) << count << QByteArray("0");
+        QTest::addRow("%d rectangles, upload threads", count) << count << QByteArray();
+    }
+}
+
+// Reports the time from the start of rendering a frame until the render pass
+// is recorded. That is the time the renderer takes to update its batches and
+// to merge and upload their geometry.
+void tst_batchrenderer::prepare()
+{
+    QFETCH(int, count);
+    QFETCH(QByteArray, threads);
+
+    // The renderer reads this on creation.
+    if (threads.isNull())
+        qunsetenv("QSG_RENDERER_UPLOAD_THREADS");
+    else
+        qputenv("QSG_RENDERER_UPLOAD_THREADS", threads);
+
+    QQuickView view;
+    view.setSource(testFileUrl("rectangles.qml"));
+    QVERIFY(view.rootObject());
+    view.rootObject()->setProperty("count", count);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QElapsedTimer timer;
+    qint64 prepareTime = 0;
+    int frames = 0;
+    connect(&view, &QQuickWindow::beforeRendering, this, [&]() {
+        timer.start();
+    }, Qt::DirectConnection);
+    connect(&view, &QQuickWindow::beforeRenderPassRecording, this, [&]() {
+        prepareTime += timer.nsecsElapsed();
+        ++frames;
+    }, Qt::DirectConnection);
+
+    int frame = 0;
+    const auto renderFrame = [&]() {
+        view.rootObject()->setProperty("frame", ++frame);
+        view.grabWindow();
+    };
+
+    // Let the renderer settle on its batch roots first.
+    for (int i = 0; i < 10; ++i)
+        renderFrame();
+
+    prepareTime = 0;
+    frames = 0;
+    QBENCHMARK {
+        renderFrame();
+    }
+
+    QVERIFY(frames > 0);
+    QTest::setBenchmarkResult(qreal(prepareTime) / frames, QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(tst_batchrenderer)
+
+#include "tst_batchrenderer.moc"
@@ -13,6 +13,11 @@
 #include <QScopeGuard>
 #include <QLibraryInfo>
 #include <QLoggingCategory>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QThreadPool>
 
 #include <private/qqmlirbuilder_p.h>
 #include <private/qqmljsparser_p.h>
@@ -23,6 +28,8 @@
 #include <private/qresourcerelocater_p.h>
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QStringList &arguments)
 {
@@ -53,6 +60,315 @@ static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QSt
     return true;
 }
 
+enum Output {
+    GenerateCpp,
+    GenerateCacheFile,
+    GenerateLoader,
+    GenerateLoaderStandAlone,
+};
+
+struct CompileJob
+{
+    QString inputFile;
+    QString outputFileName;
+    QString resourcePath;
+};
+
+struct CompileResult
+{
+    QQmlJSCompileError error;
+    QList<QQmlJSAotCompilationRecord> records;
+    bool success = false;
+};
+
+struct CompileSettings
+{
+    QQmlJSResourceFileMapper *fileMapper = nullptr;
+    QStringList importPaths;
+    QStringList qmldirFiles;
+    QString resourcePathOptionName;
+    bool useResourceMapper = false;
+    bool onlyBytecode = false;
+    bool recordAotCompilation = false;
+
+    // Leave outputs untouched if their contents did not change. This way, the C++ files
+    // generated from unchanged QML files are not recompiled when a batch is run again.
+    bool writeOnlyIfChanged = false;
+};
+
+static bool writeFile(const QString &outputFileName, const char *data, qsizetype size,
+                      bool writeOnlyIfChanged, QString *errorString)
+{
+    if (writeOnlyIfChanged) {
+        QFile existing(outputFileName);
+        if (existing.size() == size && existing.open(QIODevice::ReadOnly)
+                && existing.readAll() == QByteArray::fromRawData(data, size)) {
+            errorString->clear();
+            return true;
+        }
+    }
+
+    return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+            outputFileName, data, quint32(size), errorString);
+}
+
+static bool compileFile(const CompileJob &job, const CompileSettings &settings,
+                        QQmlJSImporter *importer, QQmlJSCompileError *error,
+                        QList<QQmlJSAotCompilationRecord> *records)
+{
+    const QString &inputFile = job.inputFile;
+    const QString &outputFileName = job.outputFileName;
+    const Output target = outputFileName.endsWith(QLatin1String(".cpp"))
+            ? GenerateCpp
+            : GenerateCacheFile;
+
+    QString inputFileUrl = inputFile;
+    QString inputResourcePath = job.resourcePath;
+
+    // If the user didn't specify the resource path corresponding to the file on disk being
+    // compiled, try to determine it from the resource file, if one was supplied.
+    if (inputResourcePath.isEmpty()) {
+        const QStringList resourcePaths = settings.fileMapper->resourcePaths(
+                    QQmlJSResourceFileMapper::localFileFilter(inputFile));
+        if (target == GenerateCpp && resourcePaths.isEmpty()) {
+            error->message = QStringLiteral("No resource path for file: ") + inputFile;
+            return false;
+        }
+
+        if (resourcePaths.size() == 1) {
+            inputResourcePath = resourcePaths.first();
+        } else if (target == GenerateCpp) {
+            error->message = QStringLiteral("Multiple resource paths for file %1. "
+                                            "Use the --%2 option to disambiguate:")
+                    .arg(inputFile, settings.resourcePathOptionName);
+            for (const QString &resourcePath: resourcePaths)
+                error->message += QStringLiteral("\n\t") + resourcePath;
+            return false;
+        }
+    }
+
+    QQmlJSSaveFunction saveFunction;
+    const bool writeOnlyIfChanged = settings.writeOnlyIfChanged;
+    if (target == GenerateCpp) {
+        inputFileUrl = QStringLiteral("qrc://") + inputResourcePath;
+        saveFunction = [inputResourcePath, outputFileName, writeOnlyIfChanged](
+                               const QV4::CompiledData::SaveableUnitPointer &unit,
+                               const QQmlJSAotFunctionMap &aotFunctions,
+                               QString *errorString) {
+            if (!writeOnlyIfChanged) {
+                return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit,
+                                           aotFunctions, errorString);
+            }
+            const QByteArray code = qQmlJSUnitAsCpp(inputResourcePath, unit, aotFunctions);
+            return writeFile(outputFileName, code.constData(), code.size(), true, errorString);
+        };
+
+    } else {
+        saveFunction = [outputFileName, writeOnlyIfChanged](
+                               const QV4::CompiledData::SaveableUnitPointer &unit,
+                               const QQmlJSAotFunctionMap &aotFunctions,
+                               QString *errorString) {
+            Q_UNUSED(aotFunctions);
+            return unit.saveToDisk<char>(
+                    [&outputFileName, writeOnlyIfChanged, errorString](
+                            const char *data, quint32 size) {
+                        return writeFile(outputFileName, data, size, writeOnlyIfChanged,
+                                         errorString);
+            });
+        };
+    }
+
+    if (inputFile.endsWith(QLatin1String(".qml"))) {
+        if (target != GenerateCpp || inputResourcePath.isEmpty() || settings.onlyBytecode) {
+            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, error,
+                                 /* storeSourceLocation */ false)) {
+                *error = error->augment(QStringLiteral("Error compiling qml file: "));
+                return false;
+            }
+        } else {
+            QQmlJSLogger logger;
+
+            // Always treat "pragma Strict" violations as errors. They are collected below, so
+            // that in batch mode they fail the file they occur in rather than the whole batch.
+            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
+            logger.setCategoryIgnored(qmlCompiler, false);
+            logger.setCategoryFatal(qmlCompiler, true);
+
+            // By default, we're completely silent,
+            // as the lcAotCompiler category default is QtFatalMsg
+            const bool loggingEnabled = lcAotCompiler().isDebugEnabled()
+                    || lcAotCompiler().isInfoEnabled() || lcAotCompiler().isWarningEnabled()
+                    || lcAotCompiler().isCriticalEnabled();
+            if (!loggingEnabled)
+                logger.setSilent(true);
+
+            QQmlJSAotCompiler cppCodeGen(
+                        importer, u':' + inputResourcePath, settings.qmldirFiles, &logger);
+            if (settings.recordAotCompilation)
+                cppCodeGen.setCompilationRecords(records);
+
+            QList<QQmlJS::DiagnosticMessage> strictModeViolations;
+            cppCodeGen.setStrictModeViolations(&strictModeViolations);
+
+            // Don't write any output for files violating "pragma Strict".
+            const auto saveIfCompliant = [&](const QV4::CompiledData::SaveableUnitPointer &unit,
+                                          const QQmlJSAotFunctionMap &aotFunctions,
+                                          QString *errorString) {
+                if (!strictModeViolations.isEmpty())
+                    return false;
+                return saveFunction(unit, aotFunctions, errorString);
+            };
+
+            if (!qCompileQmlFile(inputFile, saveIfCompliant, &cppCodeGen, error,
+                                 /* storeSourceLocation */ true)) {
+                if (!strictModeViolations.isEmpty()) {
+                    error->message.clear();
+                    error->appendDiagnostics(inputFile, strictModeViolations);
+                }
+                *error = error->augment(QStringLiteral("Error compiling qml file: "));
+                return false;
+            }
+
+            QList<QQmlJS::DiagnosticMessage> warnings = importer->takeGlobalWarnings();
+
+            if (!warnings.isEmpty()) {
+                logger.log(QStringLiteral("Type warnings occurred while compiling file:"),
+                           qmlImport, QQmlJS::SourceLocation());
+                logger.processMessages(warnings, qmlImport);
+            }
+        }
+    } else if (inputFile.endsWith(QLatin1String(".js")) || inputFile.endsWith(QLatin1String(".mjs"))) {
+        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, error)) {
+            *error = error->augment(QLatin1String("Error compiling js file: "));
+            return false;
+        }
+    } else {
+        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+    }
+
+    return true;
+}
+
+static bool readBatchFile(const QString &batchFileName, QList<CompileJob> *jobs)
+{
+    QFile f(batchFileName);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Cannot open batch file %s\n", qPrintable(batchFileName));
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!f.atEnd()) {
+        ++lineNumber;
+        const QString line = QString::fromUtf8(f.readLine().trimmed());
+        if (line.isEmpty())
+            continue;
+
+        const QStringList fields = line.split(QLatin1Char('\t'));
+        if (fields.size() < 2 || fields.size() > 3) {
+            fprintf(stderr, "%s:%d: Expected '<input file>\\t<output file>[\\t<resource path>]'\n",
+                    qPrintable(batchFileName), lineNumber);
+            return false;
+        }
+
+        jobs->append({ fields[0], fields[1], fields.value(2) });
+    }
+    return true;
+}
+
+static const char *recordKindName(QQmlJSAotCompilationRecord::Kind kind)
+{
+    switch (kind) {
+    case QQmlJSAotCompilationRecord::Binding:
+        return "binding";
+    case QQmlJSAotCompilationRecord::SignalHandler:
+        return "signalHandler";
+    case QQmlJSAotCompilationRecord::Function:
+        return "function";
+    }
+    Q_UNREACHABLE_RETURN("");
+}
+
+// Writes which bindings and functions of the given files were compiled to C++ and why the
+// others were rejected. Rejected ones are interpreted or JIT-compiled at run time.
+static bool writeAotReport(const QString &reportFileName, const QList<CompileJob> &jobs,
+                           const std::vector<CompileResult> &results)
+{
+    QJsonArray files;
+    qsizetype totalCompiled = 0;
+    qsizetype totalRejected = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        QJsonArray entries;
+        qsizetype compiled = 0;
+        for (const QQmlJSAotCompilationRecord &record : results[i].records) {
+            QJsonObject entry;
+            entry[u"kind"] = QLatin1String(recordKindName(record.kind));
+            entry[u"name"] = record.name;
+            entry[u"line"] = record.line;
+            entry[u"column"] = record.column;
+            entry[u"compiled"] = record.isCompiled();
+            if (record.isCompiled())
+                ++compiled;
+            else
+                entry[u"reason"] = record.failureReason;
+            entries.append(entry);
+        }
+
+        const qsizetype rejected = results[i].records.size() - compiled;
+        totalCompiled += compiled;
+        totalRejected += rejected;
+
+        QJsonObject file;
+        file[u"file"] = jobs[i].inputFile;
+        file[u"compiled"] = qint64(compiled);
+        file[u"rejected"] = qint64(rejected);
+        file[u"entries"] = entries;
+        files.append(file);
+    }
+
+    QJsonObject report;
+    report[u"compiled"] = qint64(totalCompiled);
+    report[u"rejected"] = qint64(totalRejected);
+    report[u"files"] = files;
+
+    const QByteArray data = QJsonDocument(report).toJson();
+    QString errorString;
+    if (!QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+                reportFileName, data.constData(), quint32(data.size()), &errorString)) {
+        fprintf(stderr, "Cannot write AOT compilation report %s: %s\n",
+                qPrintable(reportFileName), qPrintable(errorString));
+        return false;
+    }
+    return true;
+}
+
+// Compiles all jobs on a thread pool. The importer is not thread safe, but the imports and
+// qmltypes files it has resolved stay valid for the other files of the same module. Therefore
+// every worker keeps its own importer for all the files it compiles.
+static void compileBatch(const QList<CompileJob> &jobs, const CompileSettings &settings,
+                         int workerCount, std::vector<CompileResult> *results)
+{
+    results->resize(jobs.size());
+    std::atomic<qsizetype> nextJob = 0;
+
+    auto work = [&]() {
+        QQmlJSImporter importer(settings.importPaths,
+                                settings.useResourceMapper ? settings.fileMapper : nullptr);
+        for (qsizetype i = nextJob++; i < jobs.size(); i = nextJob++) {
+            CompileResult &result = (*results)[i];
+            result.success = compileFile(jobs[i], settings, &importer, &result.error,
+                                         &result.records);
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(workerCount);
+    for (int i = 1; i < workerCount; ++i)
+        pool.start(work);
+    work();
+    pool.waitForDone();
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -99,6 +415,31 @@ int main(int argc, char **argv)
                     "main", "Generate only byte code for bindings and functions, no C++ code"));
     parser.addOption(onlyBytecode);
 
+    QCommandLineOption batchFileOption(
+                QStringLiteral("batch-file"),
+                QCoreApplication::translate(
+                    "main", "Compile all files listed in the given file in one process. Each line "
+                            "holds an input file, the output file and, optionally, the resource "
+                            "path of the input file, separated by tabs. Outputs are only written "
+                            "if their contents change."),
+                QCoreApplication::translate("main", "batch file"));
+    parser.addOption(batchFileOption);
+    QCommandLineOption jobsOption(
+                QStringLiteral("jobs"),
+                QCoreApplication::translate(
+                    "main", "Number of files compiled in parallel in batch mode. Defaults to the "
+                            "number of processor cores."),
+                QCoreApplication::translate("main", "number"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption aotReportOption(
+                QStringLiteral("aot-report"),
+                QCoreApplication::translate(
+                    "main", "Write a JSON report of the bindings and functions that were compiled "
+                            "to C++, and of the reasons for rejecting the others."),
+                QCoreApplication::translate("main", "report file"));
+    parser.addOption(aotReportOption);
+
     QCommandLineOption outputFileOption(QStringLiteral("o"), QCoreApplication::translate("main", "Output file name"), QCoreApplication::translate("main", "file name"));
     parser.addOption(outputFileOption);
 
@@ -114,12 +455,7 @@ int main(int argc, char **argv)
 
     parser.process(arguments);
 
-    enum Output {
-        GenerateCpp,
-        GenerateCacheFile,
-        GenerateLoader,
-        GenerateLoaderStandAlone,
-    } target = GenerateCacheFile;
+    Output target = GenerateCacheFile;
 
     QString outputFileName;
     if (parser.isSet(outputFileOption))
@@ -134,8 +470,19 @@ int main(int argc, char **argv)
     if (target == GenerateLoader && parser.isSet(resourceNameOption))
         target = GenerateLoaderStandAlone;
 
+    const bool batch = parser.isSet(batchFileOption);
     const QStringList sources = parser.positionalArguments();
-    if (sources.isEmpty()){
+    if (batch) {
+        if (!sources.isEmpty() || parser.isSet(outputFileOption)
+                || parser.isSet(resourcePathOption)) {
+            fprintf(stderr, "The --%s option cannot be combined with input files, "
+                            "-%s or --%s\n",
+                    qPrintable(batchFileOption.names().first()),
+                    qPrintable(outputFileOption.names().first()),
+                    qPrintable(resourcePathOption.names().first()));
+            return EXIT_FAILURE;
+        }
+    } else if (sources.isEmpty()){
         parser.showHelp();
     } else if (sources.size() > 1 && (target != GenerateLoader && target != GenerateLoaderStandAlone)) {
         fprintf(stderr, "%s\n", qPrintable(QStringLiteral("Too many input files specified: '") + sources.join(QStringLiteral("' '")) + QLatin1Char('\'')));
@@ -171,123 +518,67 @@ int main(int argc, char **argv)
         }
         return EXIT_SUCCESS;
     }
-    QString inputFileUrl = inputFile;
 
-    QQmlJSSaveFunction saveFunction;
     QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
-    QString inputResourcePath = parser.value(resourcePathOption);
 
-    // If the user didn't specify the resource path corresponding to the file on disk being
-    // compiled, try to determine it from the resource file, if one was supplied.
-    if (inputResourcePath.isEmpty()) {
-        const QStringList resourcePaths = fileMapper.resourcePaths(
-                    QQmlJSResourceFileMapper::localFileFilter(inputFile));
-        if (target == GenerateCpp && resourcePaths.isEmpty()) {
-            fprintf(stderr, "No resource path for file: %s\n", qPrintable(inputFile));
-            return EXIT_FAILURE;
-        }
-
-        if (resourcePaths.size() == 1) {
-            inputResourcePath = resourcePaths.first();
-        } else if (target == GenerateCpp) {
-            fprintf(stderr, "Multiple resource paths for file %s. "
-                            "Use the --%s option to disambiguate:\n",
-                    qPrintable(inputFile),
-                    qPrintable(resourcePathOption.names().first()));
-            for (const QString &resourcePath: resourcePaths)
-                fprintf(stderr, "\t%s\n", qPrintable(resourcePath));
-            return EXIT_FAILURE;
-        }
+    CompileSettings settings;
+    settings.fileMapper = &fileMapper;
+    settings.useResourceMapper = parser.isSet(resourceOption);
+    settings.qmldirFiles = parser.values(importsOption);
+    settings.resourcePathOptionName = resourcePathOption.names().first();
+    settings.onlyBytecode = parser.isSet(onlyBytecode);
+    settings.writeOnlyIfChanged = batch;
+
+    if (settings.useResourceMapper) {
+        settings.importPaths.append(QLatin1String(":/qt-project.org/imports"));
+        settings.importPaths.append(QLatin1String(":/qt/qml"));
     }
 
-    if (target == GenerateCpp) {
-        inputFileUrl = QStringLiteral("qrc://") + inputResourcePath;
-        saveFunction = [inputResourcePath, outputFileName](
-                               const QV4::CompiledData::SaveableUnitPointer &unit,
-                               const QQmlJSAotFunctionMap &aotFunctions,
-                               QString *errorString) {
-            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions,
-                                       errorString);
-        };
+    if (parser.isSet(importPathOption))
+        settings.importPaths.append(parser.values(importPathOption));
 
-    } else {
-        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
-                                        const QQmlJSAotFunctionMap &aotFunctions,
-                                        QString *errorString) {
-            Q_UNUSED(aotFunctions);
-            return unit.saveToDisk<char>(
-                    [&outputFileName, errorString](const char *data, quint32 size) {
-                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
-                                outputFileName, data, size, errorString);
-            });
-        };
-    }
+    if (!parser.isSet(bareOption))
+        settings.importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
 
-    if (inputFile.endsWith(QLatin1String(".qml"))) {
-        QQmlJSCompileError error;
-        if (target != GenerateCpp || inputResourcePath.isEmpty() || parser.isSet(onlyBytecode)) {
-            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
-                                 /* storeSourceLocation */ false)) {
-                error.augment(QStringLiteral("Error compiling qml file: ")).print();
-                return EXIT_FAILURE;
-            }
-        } else {
-            QStringList importPaths;
+    settings.recordAotCompilation = parser.isSet(aotReportOption);
 
-            if (parser.isSet(resourceOption)) {
-                importPaths.append(QLatin1String(":/qt-project.org/imports"));
-                importPaths.append(QLatin1String(":/qt/qml"));
-            };
-
-            if (parser.isSet(importPathOption))
-                importPaths.append(parser.values(importPathOption));
-
-            if (!parser.isSet(bareOption))
-                importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
-
-            QQmlJSImporter importer(
-                        importPaths, parser.isSet(resourceOption) ? &fileMapper : nullptr);
-            QQmlJSLogger logger;
-
-            // Always trigger the qFatal() on "pragma Strict" violations.
-            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
-            logger.setCategoryIgnored(qmlCompiler, false);
-            logger.setCategoryFatal(qmlCompiler, true);
-
-            // By default, we're completely silent,
-            // as the lcAotCompiler category default is QtFatalMsg
-            const bool loggingEnabled = lcAotCompiler().isDebugEnabled()
-                    || lcAotCompiler().isInfoEnabled() || lcAotCompiler().isWarningEnabled()
-                    || lcAotCompiler().isCriticalEnabled();
-            if (!loggingEnabled)
-                logger.setSilent(true);
-
-            QQmlJSAotCompiler cppCodeGen(
-                        &importer, u':' + inputResourcePath, parser.values(importsOption), &logger);
+    QList<CompileJob> jobs;
+    int workerCount = 1;
+    if (batch) {
+        if (!readBatchFile(parser.value(batchFileOption), &jobs))
+            return EXIT_FAILURE;
 
-            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
-                                 /* storeSourceLocation */ true)) {
-                error.augment(QStringLiteral("Error compiling qml file: ")).print();
+        workerCount = QThread::idealThreadCount();
+        if (parser.isSet(jobsOption)) {
+            bool ok = false;
+            workerCount = parser.value(jobsOption).toInt(&ok);
+            if (!ok || workerCount < 1) {
+                fprintf(stderr, "Invalid number of jobs: %s\n",
+                        qPrintable(parser.value(jobsOption)));
                 return EXIT_FAILURE;
             }
+        }
+        workerCount = std::clamp(workerCount, 1, std::max(int(jobs.size()), 1));
+    } else {
+        jobs.append({ inputFile, outputFileName, parser.value(resourcePathOption) });
+    }
 
-            QList<QQmlJS::DiagnosticMessage> warnings = importer.takeGlobalWarnings();
+    std::vector<CompileResult> results;
+    compileBatch(jobs, settings, workerCount, &results);
 
-            if (!warnings.isEmpty()) {
-                logger.log(QStringLiteral("Type warnings occurred while compiling file:"),
-                           qmlImport, QQmlJS::SourceLocation());
-                logger.processMessages(warnings, qmlImport);
-            }
-        }
-    } else if (inputFile.endsWith(QLatin1String(".js")) || inputFile.endsWith(QLatin1String(".mjs"))) {
-        QQmlJSCompileError error;
-        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
-            error.augment(QLatin1String("Error compiling js file: ")).print();
-            return EXIT_FAILURE;
+    // Report the errors in the order of the jobs, independently of the scheduling.
+    bool success = true;
+    for (CompileResult &result : results) {
+        if (!result.success) {
+            result.error.print();
+            success = false;
         }
-    } else {
-        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
     }
 
-    return EXIT_SUCCESS;
+    if (parser.isSet(aotReportOption)
+            && !writeAotReport(parser.value(aotReportOption), jobs, results)) {
+        success = false;
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }